@@ -0,0 +1,135 @@
+//
+// Class AliMixEventCompactBuffer
+//
+// AliMixEventCompactBuffer keeps a ring buffer of compact events
+// (flat track records produced by AliMixEventProjection)
+// for every bin of AliMixEventPool, so that mixing does not need
+// to read events from the input chain again
+//
+
+#include "AliLog.h"
+#include "AliMixEventProjection.h"
+
+#include "AliMixEventCompactBuffer.h"
+
+ClassImp(AliMixEventCompactBuffer)
+
+//_________________________________________________________________________________________________
+AliMixEventCompactBuffer::AliMixEventCompactBuffer(Int_t numBins, Int_t depth, Int_t recordSize) : TObject(),
+   fNumBins(numBins > 0 ? numBins : 1),
+   fDepth(depth > 0 ? depth : 1),
+   fRecordSize(recordSize > 0 ? recordSize : 1),
+   fRecords(),
+   fNumTracks(),
+   fEntries(),
+   fHead(),
+   fNumEvents()
+{
+   //
+   // Default constructor.
+   //
+   AliDebug(AliLog::kDebug + 5, "<-");
+   fRecords.resize(fNumBins * fDepth);
+   fNumTracks.resize(fNumBins * fDepth, 0);
+   fEntries.resize(fNumBins * fDepth, -1);
+   fHead.resize(fNumBins, 0);
+   fNumEvents.resize(fNumBins, 0);
+   AliDebug(AliLog::kDebug + 5, "->");
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventCompactBuffer::Print(const Option_t *) const
+{
+   //
+   // Prints usefull information
+   //
+   AliInfo(Form("bins=%d depth=%d recordSize=%d memory=%lld bytes", fNumBins, fDepth, fRecordSize, GetMemoryUsage()));
+   for (Int_t i = 0; i < fNumBins; i++) {
+      AliDebug(AliLog::kDebug, Form("Bin[%d] %d events", i, fNumEvents[i]));
+   }
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventCompactBuffer::Reset()
+{
+   //
+   // Removes all events (allocated memory is kept for reuse)
+   //
+   for (Int_t i = 0; i < fNumBins; i++) {
+      fHead[i] = 0;
+      fNumEvents[i] = 0;
+   }
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventCompactBuffer::SlotIndex(Int_t bin, Int_t age) const
+{
+   //
+   // Index of slot for event in bin (age 0 is the most recent event)
+   //
+   Int_t slot = fHead[bin] - 1 - age;
+   if (slot < 0) slot += fDepth;
+   return bin * fDepth + slot;
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliMixEventCompactBuffer::AddEvent(Int_t bin, Long64_t entry, AliVEvent *ev, const AliMixEventProjection *proj)
+{
+   //
+   // Projects event into bin, overwriting the oldest event when buffer is full
+   //
+   if (bin < 0 || bin >= fNumBins || !ev || !proj) {
+      AliDebug(AliLog::kDebug, Form("Entry %lld was NOT added to bin %d !!!", entry, bin));
+      return kFALSE;
+   }
+   Int_t index = bin * fDepth + fHead[bin];
+   // clear() keeps capacity, so no allocation once the buffer is warmed up
+   fRecords[index].clear();
+   fNumTracks[index] = proj->Project(ev, fRecords[index]);
+   fEntries[index] = entry;
+   if ((Int_t)fRecords[index].size() != fNumTracks[index] * fRecordSize) {
+      AliError(Form("Projection returned %d tracks but %d values (record size %d)", fNumTracks[index], (Int_t)fRecords[index].size(), fRecordSize));
+      fNumTracks[index] = fRecords[index].size() / fRecordSize;
+   }
+   fHead[bin] = (fHead[bin] + 1) % fDepth;
+   if (fNumEvents[bin] < fDepth) fNumEvents[bin]++;
+   AliDebug(AliLog::kDebug, Form("Entry %lld was added to bin %d with %d tracks !!!", entry, bin, fNumTracks[index]));
+   return kTRUE;
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventCompactBuffer::GetNumberOfEvents(Int_t bin) const
+{
+   //
+   // Number of events stored in bin
+   //
+   if (bin < 0 || bin >= fNumBins) return 0;
+   return fNumEvents[bin];
+}
+
+//_________________________________________________________________________________________________
+const Float_t *AliMixEventCompactBuffer::GetEvent(Int_t bin, Int_t age, Int_t &nTracks, Long64_t &entry) const
+{
+   //
+   // Returns track records of event in bin (age 0 is the most recent event)
+   //
+   nTracks = 0;
+   entry = -1;
+   if (age < 0 || age >= GetNumberOfEvents(bin)) return 0;
+   Int_t index = SlotIndex(bin, age);
+   nTracks = fNumTracks[index];
+   entry = fEntries[index];
+   if (fRecords[index].empty()) return 0;
+   return &fRecords[index][0];
+}
+
+//_________________________________________________________________________________________________
+Long64_t AliMixEventCompactBuffer::GetMemoryUsage() const
+{
+   //
+   // Memory allocated for track records in bytes
+   //
+   Long64_t sum = 0;
+   for (UInt_t i = 0; i < fRecords.size(); i++) sum += fRecords[i].capacity() * sizeof(Float_t);
+   return sum;
+}
@@ -0,0 +1,55 @@
+//
+// Class AliMixEventCompactBuffer
+//
+// AliMixEventCompactBuffer keeps a ring buffer of compact events
+// (flat track records produced by AliMixEventProjection)
+// for every bin of AliMixEventPool, so that mixing does not need
+// to read events from the input chain again
+//
+
+#ifndef ALIMIXEVENTCOMPACTBUFFER_H
+#define ALIMIXEVENTCOMPACTBUFFER_H
+
+#include <vector>
+
+#include <TObject.h>
+
+class AliVEvent;
+class AliMixEventProjection;
+class AliMixEventCompactBuffer : public TObject {
+public:
+   AliMixEventCompactBuffer(Int_t numBins = 1, Int_t depth = 1, Int_t recordSize = 1);
+   virtual ~AliMixEventCompactBuffer() {}
+
+   virtual void      Print(const Option_t *option = "") const;
+
+   void              Reset();
+   Bool_t            AddEvent(Int_t bin, Long64_t entry, AliVEvent *ev, const AliMixEventProjection *proj);
+
+   Int_t             GetNumberOfBins() const { return fNumBins; }
+   Int_t             GetDepth() const { return fDepth; }
+   Int_t             GetRecordSize() const { return fRecordSize; }
+   Int_t             GetNumberOfEvents(Int_t bin) const;
+   const Float_t    *GetEvent(Int_t bin, Int_t age, Int_t &nTracks, Long64_t &entry) const;
+   Long64_t          GetMemoryUsage() const;
+
+private:
+
+   Int_t             SlotIndex(Int_t bin, Int_t age) const;
+
+   Int_t             fNumBins;               // number of bins (entry lists in event pool)
+   Int_t             fDepth;                 // number of events kept per bin
+   Int_t             fRecordSize;            // number of Float_t per track
+   std::vector<std::vector<Float_t> > fRecords; //! track records [bin*fDepth+slot]
+   std::vector<Int_t> fNumTracks;            //! number of tracks [bin*fDepth+slot]
+   std::vector<Long64_t> fEntries;           //! entry in chain [bin*fDepth+slot]
+   std::vector<Int_t> fHead;                 //! next slot to be written [bin]
+   std::vector<Int_t> fNumEvents;            //! number of filled slots [bin]
+
+   AliMixEventCompactBuffer(const AliMixEventCompactBuffer &obj);
+   AliMixEventCompactBuffer &operator=(const AliMixEventCompactBuffer &obj);
+
+   ClassDef(AliMixEventCompactBuffer, 1)
+};
+
+#endif
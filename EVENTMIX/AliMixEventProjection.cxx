@@ -0,0 +1,12 @@
+//
+// Class AliMixEventProjection
+//
+// AliMixEventProjection is the user interface which projects
+// an event into flat track records (fixed number of Float_t per track).
+// It is used by AliMixEventCompactBuffer to keep already selected
+// events in memory for mixing
+//
+
+#include "AliMixEventProjection.h"
+
+ClassImp(AliMixEventProjection)
@@ -0,0 +1,31 @@
+//
+// Class AliMixEventProjection
+//
+// AliMixEventProjection is the user interface which projects
+// an event into flat track records (fixed number of Float_t per track).
+// It is used by AliMixEventCompactBuffer to keep already selected
+// events in memory for mixing
+//
+
+#ifndef ALIMIXEVENTPROJECTION_H
+#define ALIMIXEVENTPROJECTION_H
+
+#include <vector>
+
+#include <TNamed.h>
+
+class AliVEvent;
+class AliMixEventProjection : public TNamed {
+public:
+   AliMixEventProjection(const char *name = "mixEventProjection", const char *title = "Mix event projection") : TNamed(name, title) {}
+   virtual ~AliMixEventProjection() {}
+
+   // number of Float_t values stored per track
+   virtual Int_t     GetRecordSize() const = 0;
+   // appends GetRecordSize() values for every selected track to records, returns number of tracks
+   virtual Int_t     Project(AliVEvent *ev, std::vector<Float_t> &records) const = 0;
+
+   ClassDef(AliMixEventProjection, 1)
+};
+
+#endif
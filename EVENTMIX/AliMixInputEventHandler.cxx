@@ -11,12 +11,15 @@
 #include <TChain.h>
 #include <TChainElement.h>
 #include <TSystem.h>
+#include <TMath.h>
 
 #include "AliLog.h"
 #include "AliAnalysisManager.h"
 #include "AliInputEventHandler.h"
 
 #include "AliMixEventPool.h"
+#include "AliMixEventProjection.h"
+#include "AliMixEventCompactBuffer.h"
 #include "AliMixInputEventHandler.h"
 #include "AliMixInputHandlerInfo.h"
 
@@ -37,6 +40,10 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fDoMixExtra(kTRUE),
    fDoMixIfNotEnoughEvents(kTRUE),
    fDoMixEventGetEntryAuto(kTRUE),
+   fProjection(0),
+   fCompactBufferDepth(0),
+   fCompactBuffer(0),
+   fCurrentCompactAge(-1),
    fCurrentEntry(0),
    fCurrentEntryMain(0),
    fCurrentEntryMix(0),
@@ -59,6 +66,8 @@ AliMixInputEventHandler::~AliMixInputEventHandler() {
    // Destructor
    //
    fMixTrees.Clear();
+   delete fCompactBuffer;
+   delete fProjection;
 }
 
 //_____________________________________________________________________________
@@ -195,6 +204,10 @@ Bool_t AliMixInputEventHandler::GetEntry()
    if (!fEventPool) {
       MixStd();
    }
+   // mixing from compact buffer in memory
+   else if (fProjection) {
+      MixCompact();
+   }
    // if buffer size is higher then 1
    else if (fBufferSize > 1) {
       MixBuffer();
@@ -485,6 +498,74 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
    return kTRUE;
 }
 
+//_____________________________________________________________________________
+Bool_t AliMixInputEventHandler::MixCompact()
+{
+   //
+   // Mix with compact events kept in memory for every event pool bin
+   // (mixed events are not read again from input chain)
+   //
+   AliDebug(AliLog::kDebug + 5, "<-");
+   AliDebug(AliLog::kDebug + 1, "Mix method");
+   // get correct handler
+   AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+   AliMultiInputEventHandler *mh = dynamic_cast<AliMultiInputEventHandler *>(mgr->GetInputEventHandler());
+   AliInputEventHandler *inEvHMain = 0;
+   if (mh) inEvHMain = dynamic_cast<AliInputEventHandler *>(mh->GetFirstInputEventHandler());
+   else inEvHMain = dynamic_cast<AliInputEventHandler *>(mgr->GetInputEventHandler());
+   if (!inEvHMain) return kFALSE;
+
+   // check for PhysSelection
+   if (!IsEventCurrentSelected()) return kFALSE;
+
+   if (!fCompactBuffer) {
+      fCompactBuffer = new AliMixEventCompactBuffer(fEventPool->GetListOfEntryLists()->GetEntries(), fCompactBufferDepth, fProjection->GetRecordSize());
+   }
+
+   // find out zero chain entries
+   Long64_t zeroChainEntries = fMixIntupHandlerInfoTmp->GetChain()->GetEntries() - inEvHMain->GetTree()->GetTree()->GetEntries();
+   Long64_t currentMainEntry = inEvHMain->GetTree()->GetTree()->GetReadEntry() + zeroChainEntries;
+   // start of
+   AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ BEGIN SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
+   // reset mix number
+   fNumberMixed = 0;
+   fCurrentCompactAge = -1;
+   Int_t idEntryList = -1;
+   TEntryList *el = fEventPool->FindEntryList(inEvHMain->GetEvent(), idEntryList);
+   if (!el) {
+      AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld SKIPPED (el null, idEntryList=%d) +++++++++++++++++++", fEntryCounter, idEntryList));
+      UserExecMixAllTasks(fEntryCounter, -1, currentMainEntry, -1, 0);
+      return kTRUE;
+   }
+   // entry lists are indexed from 1 (see AliMixEventPool::FindEntryList)
+   Int_t bin = idEntryList - 1;
+   Int_t numStored = fCompactBuffer->GetNumberOfEvents(bin);
+   Int_t mixNum = TMath::Min(fMixNumber, numStored);
+   if (mixNum < 1 || (!fDoMixIfNotEnoughEvents && numStored < fMixNumber)) {
+      if (!fDoMixIfNotEnoughEvents) idEntryList = -1;
+      UserExecMixAllTasks(fEntryCounter, idEntryList, currentMainEntry, -1, 0);
+      AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld SKIPPED (%d) NOT ENOUGH EVENTS TO MIX => NEED=%d +++++++++++++++++++", fEntryCounter, numStored, fMixNumber));
+   } else {
+      Int_t nTracks = 0;
+      Long64_t entryMix = -1;
+      for (Int_t age = 0; age < mixNum; age++) {
+         fCurrentCompactAge = age;
+         fCompactBuffer->GetEvent(bin, age, nTracks, entryMix);
+         // runs UserExecMix for all tasks
+         fNumberMixed++;
+         UserExecMixAllTasks(fEntryCounter, idEntryList, currentMainEntry, entryMix, fNumberMixed);
+      }
+      fCurrentCompactAge = -1;
+   }
+   // current event is stored only after mixing, so it is not mixed with itself
+   fCompactBuffer->AddEvent(bin, currentMainEntry, inEvHMain->GetEvent(), fProjection);
+
+   AliDebug(AliLog::kDebug + 3, Form("fEntryCounter=%lld fMixEventNumber=%d", fEntryCounter, fNumberMixed));
+   AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
+   AliDebug(AliLog::kDebug + 5, Form("->"));
+   return kTRUE;
+}
+
 //_____________________________________________________________________________
 Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithBuffer()
 {
@@ -565,6 +646,39 @@ void AliMixInputEventHandler::SetMixNumber(const Int_t mixNum)
    fMixNumber = mixNum;
 }
 
+//_____________________________________________________________________________
+void AliMixInputEventHandler::SetCompactMixing(AliMixEventProjection *const proj, Int_t depth)
+{
+   //
+   // Enables mixing with compact events kept in memory (requires event pool).
+   // Handler takes ownership of projection. For every event pool bin the last
+   // depth events are kept and up to fMixNumber of them are mixed with current event.
+   // In UserExecMix() tasks use GetCompactMixedEvent() instead of mixed input handlers
+   //
+   if (fProjection != proj) delete fProjection;
+   fProjection = proj;
+   fCompactBufferDepth = depth > 0 ? depth : 1;
+   if (fMixNumber > fCompactBufferDepth) {
+      AliWarning(Form("MixNumber(%d) > compact buffer depth(%d), setting buffer depth to %d", fMixNumber, fCompactBufferDepth, fMixNumber));
+      fCompactBufferDepth = fMixNumber;
+   }
+   delete fCompactBuffer;
+   fCompactBuffer = 0;
+}
+
+//_____________________________________________________________________________
+const Float_t *AliMixInputEventHandler::GetCompactMixedEvent(Int_t &nTracks) const
+{
+   //
+   // Returns track records of currently mixed compact event
+   // (record size is given by projection). Should be used in UserExecMix() only
+   //
+   nTracks = 0;
+   if (!fCompactBuffer || fCurrentCompactAge < 0 || fCurrentBinIndex < 1) return 0;
+   Long64_t entry = -1;
+   return fCompactBuffer->GetEvent(fCurrentBinIndex - 1, fCurrentCompactAge, nTracks, entry);
+}
+
 //_____________________________________________________________________________
 Bool_t AliMixInputEventHandler::IsEventCurrentSelected()
 {
@@ -21,6 +21,8 @@
 class TChain;
 class TChainElement;
 class AliMixEventPool;
+class AliMixEventProjection;
+class AliMixEventCompactBuffer;
 class AliMixInputHandlerInfo;
 class AliInputEventHandler;
 class AliMixInputEventHandler : public AliMultiInputEventHandler {
@@ -52,6 +54,11 @@ public:
    void                    DoMixExtra(Bool_t b = kTRUE) { fDoMixExtra = b; }
    void                    DoMixIfNotEnoughEvents(Bool_t b = kTRUE) { fDoMixIfNotEnoughEvents = b; }
    void                    SetMixNumber(const Int_t mixNum);
+   // mixing from in-memory ring buffer of compact events (no re-reading of mixed events from input chain)
+   void                    SetCompactMixing(AliMixEventProjection *const proj, Int_t depth);
+   Bool_t                  IsCompactMixing() const { return (fProjection != 0); }
+   AliMixEventCompactBuffer *GetCompactBuffer() const { return fCompactBuffer; }
+   const Float_t          *GetCompactMixedEvent(Int_t &nTracks) const;
 
    void                    SetCurrentBinIndex(Int_t const index) { fCurrentBinIndex = index; }
    void                    SetCurrentEntry(Long64_t const entry) { fCurrentEntry = entry ; }
@@ -89,6 +96,10 @@ private:
    Bool_t                  fDoMixExtra;            // mix extra events to get enough combinations
    Bool_t                  fDoMixIfNotEnoughEvents;// mix events if they don't have enough events to mix
    Bool_t                  fDoMixEventGetEntryAuto;// flag for preparing mixed events automatically (default on)
+   AliMixEventProjection  *fProjection;            // projection of event to compact track records (compact mixing)
+   Int_t                   fCompactBufferDepth;    // number of compact events kept per event pool bin
+   AliMixEventCompactBuffer *fCompactBuffer;       //! ring buffers of compact events
+   Int_t                   fCurrentCompactAge;     //! age of currently mixed compact event (0 = most recent)
 
    // mixing info
    Long64_t fCurrentEntry;       //! current entry number (adds 1 for every event processed on each worker)
@@ -104,13 +115,14 @@ private:
    virtual Bool_t          MixBuffer();
    virtual Bool_t          MixEventsMoreTimesWithOneEvent();
    virtual Bool_t          MixEventsMoreTimesWithBuffer();
+   virtual Bool_t          MixCompact();
 
    void                    UserExecMixAllTasks(Long64_t entryCounter, Int_t idEntryList, Long64_t entryMainReal, Long64_t entryMixReal, Int_t numMixed);
 
    AliMixInputEventHandler(const AliMixInputEventHandler &handler);
    AliMixInputEventHandler &operator=(const AliMixInputEventHandler &handler);
 
-   ClassDef(AliMixInputEventHandler, 5)
+   ClassDef(AliMixInputEventHandler, 6)
 };
 
 #endif
@@ -35,7 +35,8 @@ AliExternalBDT::AliExternalBDT(std::string name) :
   fModelPath{""},
   fModelName{""},
   fCompiler{},
-  fPredictor{}
+  fPredictor{},
+  fEntries{}
 {
 }
 
@@ -128,16 +129,26 @@ bool AliExternalBDT::LoadModelLibrary(std::string path) {
 }
 
 double AliExternalBDT::Predict(double *features, int size, bool useRawScore) {
-  std::vector<TreelitePredictorEntry> entries(size);
-  for (size_t iEntry = 0; iEntry < entries.size(); ++iEntry) {
-    entries[iEntry].fvalue = static_cast<float>(features[iEntry]);
-  }
+  double output = 0.;
+  PredictBatch(features, 1, size, &output, useRawScore);
+  return output;
+}
+
+void AliExternalBDT::PredictBatch(const double *features, int nRows, int nCols, double *scores, bool useRawScore) {
+  if (nRows <= 0) return;
+  if ((int)fEntries.size() < nCols) fEntries.resize(nCols);
   size_t out_size{0u};
   TreelitePredictorQueryResultSizeSingleInst(fPredictor, &out_size);
   assert(out_size == 1);
-  float output = 0.f;
-  TreelitePredictorPredictInst(fPredictor, entries.data(),
-      static_cast<int>(useRawScore), &output,
-      &out_size);
-  return output;
+  for (int iRow = 0; iRow < nRows; ++iRow) {
+    const double *row = features + (size_t)iRow * nCols;
+    for (int iCol = 0; iCol < nCols; ++iCol) {
+      fEntries[iCol].fvalue = static_cast<float>(row[iCol]);
+    }
+    float output = 0.f;
+    TreelitePredictorPredictInst(fPredictor, fEntries.data(),
+        static_cast<int>(useRawScore), &output,
+        &out_size);
+    scores[iRow] = output;
+  }
 }
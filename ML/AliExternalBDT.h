@@ -30,6 +30,8 @@ public:
   bool LoadXGBoostModel(std::string path);
 
   double Predict(double *features, int size, bool useRaw = false);
+  /// predict nRows candidates stored row-major in features (nCols values each), scores written to caller buffer
+  void PredictBatch(const double *features, int nRows, int nCols, double *scores, bool useRaw = false);
 
 private:
   bool CompileAndLoadModelLibrary();
@@ -43,6 +45,7 @@ private:
   std::string fModelName;
   CompilerHandle fCompiler;
   PredictorHandle fPredictor;
+  std::vector<TreelitePredictorEntry> fEntries; //!<! feature buffer reused between predictions
 };
 
 #endif
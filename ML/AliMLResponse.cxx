@@ -12,6 +12,8 @@
 
 #include "AliMLResponse.h"
 
+#include <algorithm>
+
 #include "yaml-cpp/yaml.h"
 
 #include "AliExternalBDT.h"
@@ -29,7 +31,8 @@ ClassImp(AliMLResponse);
 //_______________________________________________________________________________
 AliMLResponse::AliMLResponse()
     : TNamed(), fConfigFilePath{}, fModels{}, fCentClasses{}, fBins{}, fVariableNames{}, fNBins{}, fNVariables{},
-      fBinsBegin{}, fRaw{} {
+      fBinsBegin{}, fInputColumns{}, fColumnIndices{}, fBatchBins{}, fBatchRows{}, fBatchFeatures{}, fBatchScores{},
+      fBatchOutput{}, fRaw{} {
   //
   // Default constructor
   //
@@ -38,7 +41,8 @@ AliMLResponse::AliMLResponse()
 //_______________________________________________________________________________
 AliMLResponse::AliMLResponse(const Char_t *name, const Char_t *title)
     : TNamed(name, title), fConfigFilePath{""}, fModels{}, fCentClasses{}, fBins{}, fVariableNames{}, fNBins{},
-      fNVariables{}, fBinsBegin{}, fRaw{} {
+      fNVariables{}, fBinsBegin{}, fInputColumns{}, fColumnIndices{}, fBatchBins{}, fBatchRows{}, fBatchFeatures{},
+      fBatchScores{}, fBatchOutput{}, fRaw{} {
   //
   // Standard constructor
   //
@@ -55,7 +59,9 @@ AliMLResponse::~AliMLResponse() {
 AliMLResponse::AliMLResponse(const AliMLResponse &source)
     : TNamed(source.GetName(), source.GetTitle()), fConfigFilePath{source.fConfigFilePath}, fModels{source.fModels},
       fCentClasses{source.fCentClasses}, fBins{source.fBins}, fVariableNames{source.fVariableNames},
-      fNBins{source.fNBins}, fNVariables{source.fNVariables}, fBinsBegin{source.fBinsBegin}, fRaw{source.fRaw} {
+      fNBins{source.fNBins}, fNVariables{source.fNVariables}, fBinsBegin{source.fBinsBegin},
+      fInputColumns{source.fInputColumns}, fColumnIndices{source.fColumnIndices}, fBatchBins{}, fBatchRows{},
+      fBatchFeatures{}, fBatchScores{}, fBatchOutput{}, fRaw{source.fRaw} {
   //
   // Copy constructor
   //
@@ -77,6 +83,8 @@ AliMLResponse &AliMLResponse::operator=(const AliMLResponse &source) {
   fNBins          = source.fNBins;
   fNVariables     = source.fNVariables;
   fBinsBegin      = source.fBinsBegin;
+  fInputColumns   = source.fInputColumns;
+  fColumnIndices  = source.fColumnIndices;
   fRaw            = source.fRaw;
 
   return *this;
@@ -137,6 +145,31 @@ void AliMLResponse::MLResponseInit() {
   /// import config file from alien path
   string configLocalPath = ImportConfigFile();
   CompileModels(configLocalPath);
+  ResolveColumns();
+}
+
+//_______________________________________________________________________________
+void AliMLResponse::SetInputColumns(const vector<string> &columns) {
+  fInputColumns = columns;
+  /// if the models are already there resolve immediately, otherwise it is done in MLResponseInit
+  if (!fVariableNames.empty()) ResolveColumns();
+}
+
+//_______________________________________________________________________________
+void AliMLResponse::ResolveColumns() {
+  fColumnIndices.clear();
+  if (fInputColumns.empty()) {
+    /// features are passed in the order of the config
+    for (int iVar = 0; iVar < fNVariables; ++iVar) fColumnIndices.push_back(iVar);
+    return;
+  }
+  for (const auto &varname : fVariableNames) {
+    auto col = std::find(fInputColumns.begin(), fInputColumns.end(), varname);
+    if (col == fInputColumns.end()) {
+      AliFatal(Form("Variable |%s| not found in the input columns! Exit", varname.data()));
+    }
+    fColumnIndices.push_back(col - fInputColumns.begin());
+  }
 }
 
 //_______________________________________________________________________________
@@ -151,17 +184,18 @@ int AliMLResponse::FindBin(double binvar) {
 }
 
 //_______________________________________________________________________________
-double AliMLResponse::Predict(double binvar, map<string, double> varmap) {
+double AliMLResponse::Predict(double binvar, const map<string, double> &varmap) {
   if ((int)varmap.size() < fNVariables) {
     AliFatal("The variable map you provided to the predictor has a size smaller than the variable list size! Exit");
   }
 
   vector<double> features;
   for (const auto &varname : fVariableNames) {
-    if (varmap.find(varname) == varmap.end()) {
+    auto var = varmap.find(varname);
+    if (var == varmap.end()) {
       AliFatal(Form("Variable |%s| not found in variable list provided in config! Exit", varname.data()));
     }
-    features.push_back(varmap[varname]);
+    features.push_back(var->second);
   }
 
   int bin = FindBin(binvar);
@@ -172,7 +206,7 @@ double AliMLResponse::Predict(double binvar, map<string, double> varmap) {
 }
 
 //_______________________________________________________________________________
-double AliMLResponse::Predict(double binvar, vector<double> variables) {
+double AliMLResponse::Predict(double binvar, const vector<double> &variables) {
   if ((int)variables.size() != fNVariables) {
     AliFatal(Form("Number of variables passed (%d) different from the one used in the model (%d)! Exit",
                   (int)variables.size(), fNVariables));
@@ -182,17 +216,69 @@ double AliMLResponse::Predict(double binvar, vector<double> variables) {
   if (bin < 0)
     return -999.;
 
-  return fModels.at(bin - 1).GetModel()->Predict(&variables[0], fNVariables, fRaw);
+  return fModels.at(bin - 1).GetModel()->Predict(const_cast<double *>(&variables[0]), fNVariables, fRaw);
 }
 
 //_______________________________________________________________________________
-bool AliMLResponse::IsSelected(double binvar, std::map<std::string, double> varmap) {
+bool AliMLResponse::IsSelected(double binvar, const std::map<std::string, double> &varmap) {
   double score{0.};
   return IsSelected(binvar, varmap, score);
 }
 
 //_______________________________________________________________________________
-bool AliMLResponse::IsSelected(double binvar, std::vector<double> variables) {
+bool AliMLResponse::IsSelected(double binvar, const std::vector<double> &variables) {
   double score{0.};
   return IsSelected(binvar, variables, score);
-}
\ No newline at end of file
+}
+
+//_______________________________________________________________________________
+void AliMLResponse::PredictBatch(int nCand, const double *binvars, const double *features, double *scores) {
+  if (nCand <= 0) return;
+  if ((int)fColumnIndices.size() != fNVariables) ResolveColumns();
+  const int nColumns = fInputColumns.empty() ? fNVariables : (int)fInputColumns.size();
+
+  /// find the bins once, candidates outside the binning get the same score as in Predict
+  fBatchBins.resize(nCand);
+  for (int iCand = 0; iCand < nCand; ++iCand) {
+    int bin = std::lower_bound(fBins.begin(), fBins.end(), binvars[iCand]) - fBins.begin();
+    fBatchBins[iCand] = (bin == 0 || bin == fNBins) ? -1 : bin;
+    scores[iCand] = -999.;
+  }
+
+  /// group the candidates by bin and predict each group with a single call
+  for (int bin = 1; bin < fNBins; ++bin) {
+    fBatchRows.clear();
+    for (int iCand = 0; iCand < nCand; ++iCand) {
+      if (fBatchBins[iCand] == bin) fBatchRows.push_back(iCand);
+    }
+    const int nRows = fBatchRows.size();
+    if (!nRows) continue;
+    fBatchFeatures.resize(nRows * fNVariables);
+    fBatchScores.resize(nRows);
+    for (int iRow = 0; iRow < nRows; ++iRow) {
+      const double *row = features + (size_t)fBatchRows[iRow] * nColumns;
+      double *dest = &fBatchFeatures[iRow * fNVariables];
+      for (int iVar = 0; iVar < fNVariables; ++iVar) dest[iVar] = row[fColumnIndices[iVar]];
+    }
+    fModels.at(bin - 1).GetModel()->PredictBatch(fBatchFeatures.data(), nRows, fNVariables, fBatchScores.data(), fRaw);
+    for (int iRow = 0; iRow < nRows; ++iRow) scores[fBatchRows[iRow]] = fBatchScores[iRow];
+  }
+}
+
+//_______________________________________________________________________________
+int AliMLResponse::IsSelectedBatch(int nCand, const double *binvars, const double *features, bool *selected,
+                                   double *scores) {
+  if (nCand <= 0) return 0;
+  /// if no score buffer is given, an internal one is used
+  if (!scores) {
+    fBatchOutput.resize(nCand);
+    scores = fBatchOutput.data();
+  }
+  PredictBatch(nCand, binvars, features, scores);
+  int nSelected = 0;
+  for (int iCand = 0; iCand < nCand; ++iCand) {
+    selected[iCand] = fBatchBins[iCand] > 0 && scores[iCand] >= fModels.at(fBatchBins[iCand] - 1).GetScoreCut();
+    nSelected += selected[iCand];
+  }
+  return nSelected;
+}
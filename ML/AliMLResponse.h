@@ -46,20 +46,29 @@ public:
   void CompileModels(std::string configLocalPath);     /// (it has to be done run time)
   void MLResponseInit();    /// (it has to be done run time)
 
+  /// set the names of the columns of the feature matrix passed to the batch methods (default: VAR_NAMES of the config)
+  void SetInputColumns(const std::vector<std::string> &columns);
+
   /// return the bin index
   int FindBin(double binvar);
   /// return the ML model predicted score (raw or proba, depending on useraw)
-  double Predict(double binvar, std::map<std::string, double> varmap);
+  double Predict(double binvar, const std::map<std::string, double> &varmap);
   /// overload to pass directly a vector of variables
-  double Predict(double binvar, std::vector<double> variables);
+  double Predict(double binvar, const std::vector<double> &variables);
   /// return true if predicted score for map is above the threshold given in the config
-  bool IsSelected(double binvar, std::map<std::string, double> varmap);
+  bool IsSelected(double binvar, const std::map<std::string, double> &varmap);
   /// overload for getting the model score too
-  template <typename F> bool IsSelected(double binvar, std::map<std::string, double> varmap, F &score);
+  template <typename F> bool IsSelected(double binvar, const std::map<std::string, double> &varmap, F &score);
   /// overload to pass directly a vector of variables
-  bool IsSelected(double binvar, std::vector<double> variables);
+  bool IsSelected(double binvar, const std::vector<double> &variables);
   /// overload for getting the model score too
-  template <typename F> bool IsSelected(double binvar, std::vector<double> variables, F &score);
+  template <typename F> bool IsSelected(double binvar, const std::vector<double> &variables, F &score);
+
+  /// batch prediction for nCand candidates: features is a row-major matrix with one row of input columns per candidate,
+  /// scores are written to the caller buffer (-999 for candidates outside the binning)
+  void PredictBatch(int nCand, const double *binvars, const double *features, double *scores);
+  /// batch selection, scores buffer is optional; returns the number of selected candidates
+  int IsSelectedBatch(int nCand, const double *binvars, const double *features, bool *selected, double *scores = nullptr);
 
 protected:
   std::string fConfigFilePath;    /// path of the config file
@@ -74,14 +83,24 @@ protected:
 
   std::vector<float>::iterator fBinsBegin;    //!<!  evaluate just once is better
 
+  std::vector<std::string> fInputColumns;     /// names of the columns of the batch feature matrix
+  std::vector<int> fColumnIndices;            //!<! input column of each model variable, resolved at init
+  std::vector<int> fBatchBins;                //!<! bin of each candidate in the batch
+  std::vector<int> fBatchRows;                //!<! candidates of the bin being predicted
+  std::vector<double> fBatchFeatures;         //!<! features of the bin being predicted, in model order
+  std::vector<double> fBatchScores;           //!<! scores of the bin being predicted
+  std::vector<double> fBatchOutput;           //!<! scores of the batch when no output buffer is given
+
+  void ResolveColumns();
+
   bool fRaw;    /// set to true to use raw score instead of probability
 
   /// \cond CLASSIMP
-  ClassDef(AliMLResponse, 2);    ///
+  ClassDef(AliMLResponse, 3);    ///
   /// \endcond
 };
 
-template <typename F> bool AliMLResponse::IsSelected(double binvar, std::map<std::string, double> varmap, F &score) {
+template <typename F> bool AliMLResponse::IsSelected(double binvar, const std::map<std::string, double> &varmap, F &score) {
   int bin = FindBin(binvar);
   if (bin < 0)
     return false;
@@ -89,7 +108,7 @@ template <typename F> bool AliMLResponse::IsSelected(double binvar, std::map<std
   return score >= fModels.at(bin - 1).GetScoreCut();
 }
 
-template <typename F> bool AliMLResponse::IsSelected(double binvar, std::vector<double> variables, F &score) {
+template <typename F> bool AliMLResponse::IsSelected(double binvar, const std::vector<double> &variables, F &score) {
   int bin = FindBin(binvar);
   if (bin < 0)
     return false;
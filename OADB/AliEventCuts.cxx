@@ -37,6 +37,42 @@ using std::vector;
 ClassImp(AliEventCutsContainer);
 ClassImp(AliEventCuts);
 
+namespace {
+  /// FNV-1a hash of settings of the event selection
+  struct SettingsHash {
+    SettingsHash() : fValue{14695981039346656037ul} {}
+    template<typename T> SettingsHash& Add(const T& val) { return AddBytes(&val, sizeof(T)); }
+    SettingsHash& Add(const std::string& str) { Add(str.size()); return AddBytes(str.data(), str.size()); }
+    SettingsHash& AddBytes(const void* data, size_t n) {
+      const unsigned char* bytes = static_cast<const unsigned char*>(data);
+      for (size_t i = 0; i < n; ++i) {
+        fValue ^= bytes[i];
+        fValue *= 1099511628211ul;
+      }
+      return *this;
+    }
+    unsigned long fValue;
+  };
+
+  /// Intermediate quantities shared through the AliEventCutsContainer, the key is completed by the settings they depend on
+  enum SharedQuantity {
+    kSharedPileUpSPD = 1,
+    kSharedTrackletBG,
+    kSharedPileUpMV,
+    kSharedINELgt0,
+    kSharedCentralityLegacy,
+    kSharedCentralityMultSelection
+  };
+
+  template<typename F> double CachedQuantity(AliEventCutsContainer *cache, unsigned long key, F compute) {
+    double value = 0.;
+    if (cache && cache->GetQuantity(key, value)) return value;
+    value = compute();
+    if (cache) cache->SetQuantity(key, value);
+    return value;
+  }
+}
+
 
 
 /// Standard constructor with null selection
@@ -106,6 +142,7 @@ AliEventCuts::AliEventCuts(bool saveplots) : TList(),
   fSelectInelGt0{false},
   fOverrideInelGt0{false},
   fOverrideCentralityFramework{false},
+  fUseEventCache{false},
   fTimeRangeCut{},
   fEMCALLEDEventsCut{},
   fCutStats{nullptr},
@@ -155,188 +192,35 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
     AddQAplotsToList();
   }
 
-  /// Event selection flag, as soon as the event does not pass one cut this becomes false.
-  fFlag = BIT(kNoCuts);
-
-  /// Rejection of the DAQ incomplete events
-  if (!fRejectDAQincomplete || !ev->IsIncompleteDAQ()) fFlag |= BIT(kDAQincomplete);
-
-  /// Magnetic field selection
-  float bField = ev->GetMagneticField();
-  if (fRequiredSolenoidPolarity == 0 || fRequiredSolenoidPolarity * bField > 0.) fFlag |= BIT(kBfield);
-
-  /// Trigger mask
-  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
-  AliInputEventHandler* handl = (AliInputEventHandler*)mgr->GetInputEventHandler();
-  unsigned int selected_trigger = handl->IsEventSelected() & fTriggerMask;
-  if ((selected_trigger == fTriggerMask && fRequireExactTriggerMask) || (selected_trigger && !fRequireExactTriggerMask))
-    fFlag |= BIT(kTrigger);
-
-  /// Use of trigger classes overrides the trigger mask
-  /// (i.e. if trigger mask is not fired but we see the trigger class we want we enable the trigger bit)
-  /// A special bit is set in this case
-  TString classes = ev->GetFiredTriggerClasses();
-  if (fTriggerClasses.empty())
-    fFlag |= BIT(kTriggerClasses);
-  for (const std::string& myClass : fTriggerClasses) {
-    if (classes.Contains(myClass.data()) && !myClass.empty()) {
-      fFlag |= BIT(kTrigger);
-      fFlag |= BIT(kTriggerClasses);
-      break;
-    }
-  }
-
-  /// Vertex existance
-  const AliVVertex* vtTrc = ev->GetPrimaryVertex();
-  bool isTrackV = true;
-  if(vtTrc->IsFromVertexer3D() || vtTrc->IsFromVertexerZ()) isTrackV=false;
-  const AliVVertex* vtSPD = ev->GetPrimaryVertexSPD();
-  /// On current AODs primary vertex could be from TPC or invalid SPD vertex
-  /// The following check should be applied only on AOD.
-  bool goodAODvtx = (dynamic_cast<AliAODEvent*>(ev) ? GoodPrimaryAODVertex(ev) : true) || !fCheckAODvertex;
-
-  if (vtSPD->GetNContributors() > 0) fFlag |= BIT(kVertexSPD);
-  if (vtTrc->GetNContributors() > 1 && isTrackV && goodAODvtx) fFlag |= BIT(kVertexTracks);
-  if (((fFlag & BIT(kVertexTracks)) ||  !fRequireTrackVertex) && (fFlag & BIT(kVertexSPD))) fFlag |= BIT(kVertex);
-  const AliVVertex* &vtx = bool(fFlag & BIT(kVertexTracks)) ? vtTrc : vtSPD;
-  fPrimaryVertex = const_cast<AliVVertex*>(vtx);
-
-  /// Vertex position cut
-  if (vtSPD->GetZ() >= fMinVtz && vtSPD->GetZ() <= fMaxVtz) fFlag |= BIT(kVertexPositionSPD);
-  if (vtTrc->GetZ() >= fMinVtz && vtTrc->GetZ() <= fMaxVtz) fFlag |= BIT(kVertexPositionTracks);
-  if (vtx->GetZ()   >= fMinVtz && vtx->GetZ()   <= fMaxVtz) fFlag |= BIT(kVertexPosition);
-
-  /// Vertex quality cuts
-  double covTrc[6],covSPD[6];
-  vtTrc->GetCovarianceMatrix(covTrc);
-  vtSPD->GetCovarianceMatrix(covSPD);
-  double dz = bool(fFlag & kVertexSPD) && bool(fFlag & kVertexTracks) ? vtTrc->GetZ() - vtSPD->GetZ() : 0.; /// If one of the two vertices is not available this cut is always passed.
-  double errTot = TMath::Sqrt(covTrc[5]+covSPD[5]);
-  double errTrc = bool(fFlag & kVertexTracks) ? TMath::Sqrt(covTrc[5]) : 1.;
-  double nsigTot = TMath::Abs(dz) / errTot, nsigTrc = TMath::Abs(dz) / errTrc;
-  /// vertex dispersion for run1, only for ESD, AOD code to be added here
-  const AliESDVertex* vtSPDESD = dynamic_cast<const AliESDVertex*>(vtSPD);
-  double vtSPDdispersion = vtSPDESD ? vtSPDESD->GetDispersion() : 0;
-  if (
-      (TMath::Abs(dz) <= fMaxDeltaSpdTrackAbsolute && nsigTot <= fMaxDeltaSpdTrackNsigmaSPD && nsigTrc <= fMaxDeltaSpdTrackNsigmaTrack) && // discrepancy track-SPD vertex
-      (!vtSPD->IsFromVertexerZ() || TMath::Sqrt(covSPD[5]) <= fMaxResolutionSPDvertex) &&
-      (!vtSPD->IsFromVertexerZ() || vtSPDdispersion <= fMaxDispersionSPDvertex) /// vertex dispersion cut for run1, only for ESD
-     ) // quality cut on vertexer SPD z
-    fFlag |= BIT(kVertexQuality);  
-
-  /// Pile-up rejection
-  bool usePileUpMV = (fUseCombinedMVSPDcut && vtx != vtSPD) || fPileUpCutMV;
-  bool usePileUpSPD = (fUseCombinedMVSPDcut && vtx == vtSPD) || fUseSPDpileUpCut;
-  AliVMultiplicity* mult = ev->GetMultiplicity();
-  const int ntrkl = mult->GetNumberOfTracklets();
-
-  if (fUseMultiplicityDependentPileUpCuts) {
-    if (ntrkl < 20) fSPDpileupMinContributors = 3;
-    else if (ntrkl < 50) fSPDpileupMinContributors = 4;
-    else fSPDpileupMinContributors = 5;
-  }
-  if ((!usePileUpSPD || !ev->IsPileupFromSPD(fSPDpileupMinContributors,fSPDpileupMinZdist,fSPDpileupNsigmaZdist,fSPDpileupNsigmaDiamXY,fSPDpileupNsigmaDiamZ)) &&
-      (!fTrackletBGcut || !fUtils.IsSPDClusterVsTrackletBG(ev)) &&
-      (!usePileUpMV || !fUtils.IsPileUpMV(ev)))
-    fFlag |= BIT(kPileUp);
-
-
-  // Rejection of TPC pileup
-  int nCluSDDSSD=0;
-  for(Int_t iLay=2; iLay<6; iLay++) nCluSDDSSD+=mult->GetNumberOfITSClusters(iLay);
-  int nCluTPC=0;
-  if (dynamic_cast<AliAODEvent*>(ev)) nCluTPC=dynamic_cast<AliAODEvent*>(ev)->GetNumberOfTPCClusters();
-  else if (dynamic_cast<AliESDEvent*>(ev)) nCluTPC=dynamic_cast<AliESDEvent*>(ev)->GetNumberOfTPCClusters();
-  if(fUseVariablesCorrelationCuts || fTOFvsFB32[0] || fUseStrongVarCorrelationCut ||
-     fUseTPCTracklCorrelationCut) ComputeTrackMultiplicity(ev);
-  const double its_tpcclus_limit = PolN(double(nCluTPC),fITSvsTPCcluPolCut,2);
-  const double vzero_tpcout_limit = PolN(double(fContainer.fMultTrkTPCout),fVZEROvsTPCoutPolCut,4);
-  const double fb128 = fContainer.fMultTrkTPC;
-  if(((fUseITSTPCCluCorrelationCut<=0 || (nCluSDDSSD > its_tpcclus_limit)) && 
-      (!fUseStrongVarCorrelationCut || (fContainer.fMultVZERO > vzero_tpcout_limit)) &&
-      (!fUseTPCTracklCorrelationCut || (fb128 < fFB128vsTrklLinearCut[0] + fFB128vsTrklLinearCut[1] * ntrkl)))
-     || fMC ) fFlag |= BIT(kTPCPileUp);
-
-
-  /// Centrality cuts:
-  /// * Check for min and max centrality
-  /// * Cross check correlation between two centrality estimators
-  if (AliMultSelectionTask::IsINELgtZERO(ev) || !fSelectInelGt0) {
-    fFlag |= BIT(kINELgt0);
-    fCentPercentiles[0] = -0.5;
-    fCentPercentiles[1] = -0.5;
-  }
-  if (fCentralityFramework) {
-    if (fCentralityFramework == 2) {
-      AliCentrality* cent = ev->GetCentrality();
-      if (!cent) {
-        AliFatal("The legacy centrality framework has been request but no AliCentrality object was found attached to the Event."
-                 " Did you run the Centrality Framework?");
-      }
-      fCentPercentiles[0] = cent->GetCentralityPercentile(fCentEstimators[0].data());
-      fCentPercentiles[1] = cent->GetCentralityPercentile(fCentEstimators[1].data());
-    } else {
-      AliMultSelection* cent = (AliMultSelection*)ev->FindListObject("MultSelection");
-      if (!cent) {
-        AliFatal("The multiplicity selection framework has been request but no AliMultSelection object was found attached to the Event."
-                 " Did you run the AliMultSelectionTask?");
-      }
-      fCentPercentiles[0] = cent->GetMultiplicityPercentile(fCentEstimators[0].data(), fMultSelectionEvCuts);
-      fCentPercentiles[1] = cent->GetMultiplicityPercentile(fCentEstimators[1].data(), fMultSelectionEvCuts);
-    }
-    const auto& x = fCentPercentiles[1];
-    const double center = x * fEstimatorsCorrelationCoef[1] + fEstimatorsCorrelationCoef[0];
-    const double sigma = fEstimatorsSigmaPars[0] + fEstimatorsSigmaPars[1] * x + fEstimatorsSigmaPars[2] * x * x + fEstimatorsSigmaPars[3] * x * x * x;
-    if ((!fUseEstimatorsCorrelationCut || fMC ||
-          (fCentPercentiles[0] >= center - fDeltaEstimatorNsigma[0] * sigma && fCentPercentiles[0] <= center + fDeltaEstimatorNsigma[1] * sigma))
-        && fCentPercentiles[0] >= fMinCentrality
-        && fCentPercentiles[0] <= fMaxCentrality) {
-          fFlag |= BIT(kMultiplicity);
-    }
-  } else
-    fFlag |= BIT(kMultiplicity);
-
-  /// If the correlation plots are defined, we should fill them
-  if (fUseVariablesCorrelationCuts || fTOFvsFB32[0]) {
-    const double fb32 = fContainer.fMultTrkFB32;
-    const double fb32acc = fContainer.fMultTrkFB32Acc;
-    const double fb32tof = fContainer.fMultTrkFB32TOF;
-    const double esd = fContainer.fMultESD;
-
-    const double mu32tof = PolN(fb32,fTOFvsFB32correlationPars,3);
-    const double sigma32tof = PolN(fb32,fTOFvsFB32sigmaPars, 5);
-
-    const bool multV0Mcut = (fMultiplicityV0McorrCut) ? fb32acc > fMultiplicityV0McorrCut->Eval(fCentPercentiles[0]) : true;
-
-    if (((fb32tof <= mu32tof + fTOFvsFB32nSigmaCut[0] * sigma32tof && fb32tof >= mu32tof - fTOFvsFB32nSigmaCut[1] * sigma32tof) &&
-        (esd < fESDvsTPConlyLinearCut[0] + fESDvsTPConlyLinearCut[1] * fb128) &&
-	 multV0Mcut)
-        || fMC || !fUseVariablesCorrelationCuts)
-      fFlag |= BIT(kCorrelations);
-  } else fFlag |= BIT(kCorrelations);
-
-  /// Time Range masking
-  if (fUseTimeRangeCut) {
-    if ( fTimeRangeCut.CutEvent(ev) == kFALSE ) {
-      // good event: should be accepted
-      fFlag |= BIT(kTimeRangeCut);
+  /// Event selection: with the shared event cache the result of an identically configured instance is reused
+  AliEventCutsContainer* cache = fUseEventCache ? GetEventCache(ev) : nullptr;
+  const unsigned long configHash = cache ? GetConfigurationHash() : 0ul;
+  const AliEventCutsContainer::Selection* cached = cache ? cache->FindSelection(configHash) : nullptr;
+  AliEventCutsContainer::Selection sel;
+  if (cached) {
+    sel = *cached;
+    fFlag = sel.fFlag;
+    fPrimaryVertex = const_cast<AliVVertex*>(TESTBIT(fFlag,kVertexTracks) ? ev->GetPrimaryVertex() : ev->GetPrimaryVertexSPD());
+    /// The percentiles are only overwritten when the selection would overwrite them
+    if (fCentralityFramework) {
+      fCentPercentiles[0] = sel.fCentPercentiles[0];
+      fCentPercentiles[1] = sel.fCentPercentiles[1];
+    } else if (TESTBIT(fFlag,kINELgt0)) {
+      fCentPercentiles[0] = -0.5;
+      fCentPercentiles[1] = -0.5;
     }
+    if (fUseMultiplicityDependentPileUpCuts) fSPDpileupMinContributors = sel.fSPDpileupMinContributors;
+    if(fUseVariablesCorrelationCuts || fTOFvsFB32[0] || fUseStrongVarCorrelationCut ||
+       fUseTPCTracklCorrelationCut) ComputeTrackMultiplicity(ev);
   } else {
-    fFlag |= BIT(kTimeRangeCut);
+    ComputeSelection(ev, cache, sel);
+    if (cache) {
+      sel.fConfigHash = configHash;
+      cache->AddSelection(sel);
+    }
   }
+  const AliVVertex* vtx = fPrimaryVertex;
 
-  //
-  /// Check if the EMCal event is bad due to LED system flashes
-  //
-  if ( fUseEMCALLEDEventsCut )
-  {
-    if ( !fEMCALLEDEventsCut.IsEMCALLEDEvent(ev,fCurrentRun) ) 
-      fFlag |= BIT(kEMCALEDCut); // accept event
-  }
-  else 
-    fFlag |= BIT(kEMCALEDCut); // accept event
-  //
-  
   /// Ignore SPD/tracks vertex position and reconstruction individual flags
   bool allcuts = CheckNormalisationMask(kPassesAllCuts);
   if (allcuts) {
@@ -376,13 +260,13 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
   for (int befaft = 0; befaft < 2; ++befaft) {
     if (fCentrality[befaft]) fCentrality[befaft]->Fill(fCentPercentiles[0]);
     if (fEstimCorrelation[befaft]) fEstimCorrelation[befaft]->Fill(fCentPercentiles[1],fCentPercentiles[0]);
-    if (fMultCentCorrelation[befaft]) fMultCentCorrelation[befaft]->Fill(fCentPercentiles[0],ntrkl);
+    if (fMultCentCorrelation[befaft]) fMultCentCorrelation[befaft]->Fill(fCentPercentiles[0],sel.fNTracklets);
     if (fVtz[befaft]) fVtz[befaft]->Fill(vtx->GetZ());
-    if (fDeltaTrackSPDvtz[befaft]) fDeltaTrackSPDvtz[befaft]->Fill(dz);
+    if (fDeltaTrackSPDvtz[befaft]) fDeltaTrackSPDvtz[befaft]->Fill(sel.fDeltaZ);
     if (fTOFvsFB32[befaft]) fTOFvsFB32[befaft]->Fill(fContainer.fMultTrkFB32,fContainer.fMultTrkFB32TOF);
     if (fTPCvsAll[befaft])  fTPCvsAll[befaft]->Fill(fContainer.fMultTrkTPC,float(fContainer.fMultESD) - fESDvsTPConlyLinearCut[1] * fContainer.fMultTrkTPC);
     if (fMultvsV0M[befaft]) fMultvsV0M[befaft]->Fill(GetCentrality(),fContainer.fMultTrkFB32Acc);
-    if (fTPCvsTrkl[befaft]) fTPCvsTrkl[befaft]->Fill(ntrkl,fContainer.fMultTrkTPC);
+    if (fTPCvsTrkl[befaft]) fTPCvsTrkl[befaft]->Fill(sel.fNTracklets,fContainer.fMultTrkTPC);
     if (fVZEROvsTPCout[befaft]) fVZEROvsTPCout[befaft]->Fill(fContainer.fMultTrkTPCout,fContainer.fMultVZERO);
     if (!allcuts) return false; /// Do not fill the "after" histograms if the event does not pass the cuts.
   }
@@ -587,6 +471,249 @@ string AliEventCuts::GetCentralityEstimator (unsigned int estimator) const {
 }
 
 
+void AliEventCuts::ComputeSelection(AliVEvent *ev, AliEventCutsContainer *cache, AliEventCutsContainer::Selection &sel) {
+  /// Event selection flag, as soon as the event does not pass one cut this becomes false.
+  fFlag = BIT(kNoCuts);
+
+  /// Rejection of the DAQ incomplete events
+  if (!fRejectDAQincomplete || !ev->IsIncompleteDAQ()) fFlag |= BIT(kDAQincomplete);
+
+  /// Magnetic field selection
+  float bField = ev->GetMagneticField();
+  if (fRequiredSolenoidPolarity == 0 || fRequiredSolenoidPolarity * bField > 0.) fFlag |= BIT(kBfield);
+
+  /// Trigger mask
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  AliInputEventHandler* handl = (AliInputEventHandler*)mgr->GetInputEventHandler();
+  unsigned int selected_trigger = handl->IsEventSelected() & fTriggerMask;
+  if ((selected_trigger == fTriggerMask && fRequireExactTriggerMask) || (selected_trigger && !fRequireExactTriggerMask))
+    fFlag |= BIT(kTrigger);
+
+  /// Use of trigger classes overrides the trigger mask
+  /// (i.e. if trigger mask is not fired but we see the trigger class we want we enable the trigger bit)
+  /// A special bit is set in this case
+  TString classes = ev->GetFiredTriggerClasses();
+  if (fTriggerClasses.empty())
+    fFlag |= BIT(kTriggerClasses);
+  for (const std::string& myClass : fTriggerClasses) {
+    if (classes.Contains(myClass.data()) && !myClass.empty()) {
+      fFlag |= BIT(kTrigger);
+      fFlag |= BIT(kTriggerClasses);
+      break;
+    }
+  }
+
+  /// Vertex existance
+  const AliVVertex* vtTrc = ev->GetPrimaryVertex();
+  bool isTrackV = true;
+  if(vtTrc->IsFromVertexer3D() || vtTrc->IsFromVertexerZ()) isTrackV=false;
+  const AliVVertex* vtSPD = ev->GetPrimaryVertexSPD();
+  /// On current AODs primary vertex could be from TPC or invalid SPD vertex
+  /// The following check should be applied only on AOD.
+  bool goodAODvtx = (dynamic_cast<AliAODEvent*>(ev) ? GoodPrimaryAODVertex(ev) : true) || !fCheckAODvertex;
+
+  if (vtSPD->GetNContributors() > 0) fFlag |= BIT(kVertexSPD);
+  if (vtTrc->GetNContributors() > 1 && isTrackV && goodAODvtx) fFlag |= BIT(kVertexTracks);
+  if (((fFlag & BIT(kVertexTracks)) ||  !fRequireTrackVertex) && (fFlag & BIT(kVertexSPD))) fFlag |= BIT(kVertex);
+  const AliVVertex* &vtx = bool(fFlag & BIT(kVertexTracks)) ? vtTrc : vtSPD;
+  fPrimaryVertex = const_cast<AliVVertex*>(vtx);
+
+  /// Vertex position cut
+  if (vtSPD->GetZ() >= fMinVtz && vtSPD->GetZ() <= fMaxVtz) fFlag |= BIT(kVertexPositionSPD);
+  if (vtTrc->GetZ() >= fMinVtz && vtTrc->GetZ() <= fMaxVtz) fFlag |= BIT(kVertexPositionTracks);
+  if (vtx->GetZ()   >= fMinVtz && vtx->GetZ()   <= fMaxVtz) fFlag |= BIT(kVertexPosition);
+
+  /// Vertex quality cuts
+  double covTrc[6],covSPD[6];
+  vtTrc->GetCovarianceMatrix(covTrc);
+  vtSPD->GetCovarianceMatrix(covSPD);
+  double dz = bool(fFlag & kVertexSPD) && bool(fFlag & kVertexTracks) ? vtTrc->GetZ() - vtSPD->GetZ() : 0.; /// If one of the two vertices is not available this cut is always passed.
+  double errTot = TMath::Sqrt(covTrc[5]+covSPD[5]);
+  double errTrc = bool(fFlag & kVertexTracks) ? TMath::Sqrt(covTrc[5]) : 1.;
+  double nsigTot = TMath::Abs(dz) / errTot, nsigTrc = TMath::Abs(dz) / errTrc;
+  /// vertex dispersion for run1, only for ESD, AOD code to be added here
+  const AliESDVertex* vtSPDESD = dynamic_cast<const AliESDVertex*>(vtSPD);
+  double vtSPDdispersion = vtSPDESD ? vtSPDESD->GetDispersion() : 0;
+  if (
+      (TMath::Abs(dz) <= fMaxDeltaSpdTrackAbsolute && nsigTot <= fMaxDeltaSpdTrackNsigmaSPD && nsigTrc <= fMaxDeltaSpdTrackNsigmaTrack) && // discrepancy track-SPD vertex
+      (!vtSPD->IsFromVertexerZ() || TMath::Sqrt(covSPD[5]) <= fMaxResolutionSPDvertex) &&
+      (!vtSPD->IsFromVertexerZ() || vtSPDdispersion <= fMaxDispersionSPDvertex) /// vertex dispersion cut for run1, only for ESD
+     ) // quality cut on vertexer SPD z
+    fFlag |= BIT(kVertexQuality);  
+
+  /// Pile-up rejection
+  bool usePileUpMV = (fUseCombinedMVSPDcut && vtx != vtSPD) || fPileUpCutMV;
+  bool usePileUpSPD = (fUseCombinedMVSPDcut && vtx == vtSPD) || fUseSPDpileUpCut;
+  AliVMultiplicity* mult = ev->GetMultiplicity();
+  const int ntrkl = mult->GetNumberOfTracklets();
+
+  if (fUseMultiplicityDependentPileUpCuts) {
+    if (ntrkl < 20) fSPDpileupMinContributors = 3;
+    else if (ntrkl < 50) fSPDpileupMinContributors = 4;
+    else fSPDpileupMinContributors = 5;
+  }
+  auto pileUpSPD = [&]() -> double { return ev->IsPileupFromSPD(fSPDpileupMinContributors,fSPDpileupMinZdist,fSPDpileupNsigmaZdist,fSPDpileupNsigmaDiamXY,fSPDpileupNsigmaDiamZ); };
+  auto trackletBG = [&]() -> double { return fUtils.IsSPDClusterVsTrackletBG(ev); };
+  auto pileUpMV = [&]() -> double { return fUtils.IsPileUpMV(ev); };
+  if ((!usePileUpSPD || !CachedQuantity(cache, SettingsHash().Add(kSharedPileUpSPD).Add(fSPDpileupMinContributors).Add(fSPDpileupMinZdist).Add(fSPDpileupNsigmaZdist).Add(fSPDpileupNsigmaDiamXY).Add(fSPDpileupNsigmaDiamZ).fValue, pileUpSPD)) &&
+      (!fTrackletBGcut || !CachedQuantity(cache, SettingsHash().Add(kSharedTrackletBG).Add(fUtils.GetASPDCvsTCut()).Add(fUtils.GetBSPDCvsTCut()).fValue, trackletBG)) &&
+      (!usePileUpMV || !CachedQuantity(cache, SettingsHash().Add(kSharedPileUpMV).Add(fUtils.GetMinPlpContribMV()).Add(fUtils.GetMaxPlpChi2MV()).Add(fUtils.GetMinWDistMV()).Add(fUtils.GetCheckPlpFromDifferentBCMV()).fValue, pileUpMV)))
+    fFlag |= BIT(kPileUp);
+
+
+  // Rejection of TPC pileup
+  int nCluSDDSSD=0;
+  for(Int_t iLay=2; iLay<6; iLay++) nCluSDDSSD+=mult->GetNumberOfITSClusters(iLay);
+  int nCluTPC=0;
+  if (dynamic_cast<AliAODEvent*>(ev)) nCluTPC=dynamic_cast<AliAODEvent*>(ev)->GetNumberOfTPCClusters();
+  else if (dynamic_cast<AliESDEvent*>(ev)) nCluTPC=dynamic_cast<AliESDEvent*>(ev)->GetNumberOfTPCClusters();
+  if(fUseVariablesCorrelationCuts || fTOFvsFB32[0] || fUseStrongVarCorrelationCut ||
+     fUseTPCTracklCorrelationCut) ComputeTrackMultiplicity(ev);
+  const double its_tpcclus_limit = PolN(double(nCluTPC),fITSvsTPCcluPolCut,2);
+  const double vzero_tpcout_limit = PolN(double(fContainer.fMultTrkTPCout),fVZEROvsTPCoutPolCut,4);
+  const double fb128 = fContainer.fMultTrkTPC;
+  if(((fUseITSTPCCluCorrelationCut<=0 || (nCluSDDSSD > its_tpcclus_limit)) && 
+      (!fUseStrongVarCorrelationCut || (fContainer.fMultVZERO > vzero_tpcout_limit)) &&
+      (!fUseTPCTracklCorrelationCut || (fb128 < fFB128vsTrklLinearCut[0] + fFB128vsTrklLinearCut[1] * ntrkl)))
+     || fMC ) fFlag |= BIT(kTPCPileUp);
+
+
+  /// Centrality cuts:
+  /// * Check for min and max centrality
+  /// * Cross check correlation between two centrality estimators
+  auto inelGt0 = [&]() -> double { return AliMultSelectionTask::IsINELgtZERO(ev); };
+  if (CachedQuantity(cache, SettingsHash().Add(kSharedINELgt0).fValue, inelGt0) || !fSelectInelGt0) {
+    fFlag |= BIT(kINELgt0);
+    fCentPercentiles[0] = -0.5;
+    fCentPercentiles[1] = -0.5;
+  }
+  if (fCentralityFramework) {
+    if (fCentralityFramework == 2) {
+      AliCentrality* cent = ev->GetCentrality();
+      if (!cent) {
+        AliFatal("The legacy centrality framework has been request but no AliCentrality object was found attached to the Event."
+                 " Did you run the Centrality Framework?");
+      }
+      for (int iEst = 0; iEst < 2; ++iEst) {
+        auto percentile = [&]() -> double { return cent->GetCentralityPercentile(fCentEstimators[iEst].data()); };
+        fCentPercentiles[iEst] = CachedQuantity(cache, SettingsHash().Add(kSharedCentralityLegacy).Add(fCentEstimators[iEst]).fValue, percentile);
+      }
+    } else {
+      AliMultSelection* cent = (AliMultSelection*)ev->FindListObject("MultSelection");
+      if (!cent) {
+        AliFatal("The multiplicity selection framework has been request but no AliMultSelection object was found attached to the Event."
+                 " Did you run the AliMultSelectionTask?");
+      }
+      for (int iEst = 0; iEst < 2; ++iEst) {
+        auto percentile = [&]() -> double { return cent->GetMultiplicityPercentile(fCentEstimators[iEst].data(), fMultSelectionEvCuts); };
+        fCentPercentiles[iEst] = CachedQuantity(cache, SettingsHash().Add(kSharedCentralityMultSelection).Add(fCentEstimators[iEst]).Add(fMultSelectionEvCuts).fValue, percentile);
+      }
+    }
+    const auto& x = fCentPercentiles[1];
+    const double center = x * fEstimatorsCorrelationCoef[1] + fEstimatorsCorrelationCoef[0];
+    const double sigma = fEstimatorsSigmaPars[0] + fEstimatorsSigmaPars[1] * x + fEstimatorsSigmaPars[2] * x * x + fEstimatorsSigmaPars[3] * x * x * x;
+    if ((!fUseEstimatorsCorrelationCut || fMC ||
+          (fCentPercentiles[0] >= center - fDeltaEstimatorNsigma[0] * sigma && fCentPercentiles[0] <= center + fDeltaEstimatorNsigma[1] * sigma))
+        && fCentPercentiles[0] >= fMinCentrality
+        && fCentPercentiles[0] <= fMaxCentrality) {
+          fFlag |= BIT(kMultiplicity);
+    }
+  } else
+    fFlag |= BIT(kMultiplicity);
+
+  /// If the correlation plots are defined, we should fill them
+  if (fUseVariablesCorrelationCuts || fTOFvsFB32[0]) {
+    const double fb32 = fContainer.fMultTrkFB32;
+    const double fb32acc = fContainer.fMultTrkFB32Acc;
+    const double fb32tof = fContainer.fMultTrkFB32TOF;
+    const double esd = fContainer.fMultESD;
+
+    const double mu32tof = PolN(fb32,fTOFvsFB32correlationPars,3);
+    const double sigma32tof = PolN(fb32,fTOFvsFB32sigmaPars, 5);
+
+    const bool multV0Mcut = (fMultiplicityV0McorrCut) ? fb32acc > fMultiplicityV0McorrCut->Eval(fCentPercentiles[0]) : true;
+
+    if (((fb32tof <= mu32tof + fTOFvsFB32nSigmaCut[0] * sigma32tof && fb32tof >= mu32tof - fTOFvsFB32nSigmaCut[1] * sigma32tof) &&
+        (esd < fESDvsTPConlyLinearCut[0] + fESDvsTPConlyLinearCut[1] * fb128) &&
+	 multV0Mcut)
+        || fMC || !fUseVariablesCorrelationCuts)
+      fFlag |= BIT(kCorrelations);
+  } else fFlag |= BIT(kCorrelations);
+
+  /// Time Range masking
+  if (fUseTimeRangeCut) {
+    if ( fTimeRangeCut.CutEvent(ev) == kFALSE ) {
+      // good event: should be accepted
+      fFlag |= BIT(kTimeRangeCut);
+    }
+  } else {
+    fFlag |= BIT(kTimeRangeCut);
+  }
+
+  //
+  /// Check if the EMCal event is bad due to LED system flashes
+  //
+  if ( fUseEMCALLEDEventsCut )
+  {
+    if ( !fEMCALLEDEventsCut.IsEMCALLEDEvent(ev,fCurrentRun) ) 
+      fFlag |= BIT(kEMCALEDCut); // accept event
+  }
+  else 
+    fFlag |= BIT(kEMCALEDCut); // accept event
+
+  sel.fConfigHash = 0ul;
+  sel.fFlag = fFlag;
+  sel.fCentPercentiles[0] = fCentPercentiles[0];
+  sel.fCentPercentiles[1] = fCentPercentiles[1];
+  sel.fDeltaZ = dz;
+  sel.fNTracklets = ntrkl;
+  sel.fSPDpileupMinContributors = fSPDpileupMinContributors;
+}
+
+AliEventCutsContainer* AliEventCuts::GetEventCache(AliVEvent *ev) {
+  /// The cache lives in the container attached to the event, it is reset when the analysis moves to another event
+  AliEventCutsContainer* cont = static_cast<AliEventCutsContainer*>(ev->FindListObject("AliEventCutsContainer"));
+  if (!cont) {
+    cont = new AliEventCutsContainer;
+    ev->AddObject(cont);
+  }
+  const long long entry = AliAnalysisManager::GetAnalysisManager()->GetCurrentEntry();
+  const unsigned long evid = ((unsigned long)(ev->GetBunchCrossNumber()) << 32) + ev->GetTimeStamp();
+  if (cont->fCacheEntry != entry || cont->fCacheEventId != evid)
+    cont->ResetCache(entry, evid);
+  return cont;
+}
+
+unsigned long AliEventCuts::GetConfigurationHash() const {
+  /// Hash of all the settings the event selection depends on. Settings that cannot be inspected
+  /// (the V0M correlation function, the EMCal LED cut) make the hash specific to this instance.
+  SettingsHash h;
+  h.Add(fRejectDAQincomplete).Add(fRequiredSolenoidPolarity);
+  h.Add(fTriggerMask).Add(fRequireExactTriggerMask);
+  h.Add(fTriggerClasses.size());
+  for (const std::string& myClass : fTriggerClasses) h.Add(myClass);
+  h.Add(fCheckAODvertex).Add(fRequireTrackVertex).Add(fMinVtz).Add(fMaxVtz);
+  h.Add(fMaxDeltaSpdTrackAbsolute).Add(fMaxDeltaSpdTrackNsigmaSPD).Add(fMaxDeltaSpdTrackNsigmaTrack);
+  h.Add(fMaxResolutionSPDvertex).Add(fMaxDispersionSPDvertex);
+  h.Add(fUseCombinedMVSPDcut).Add(fPileUpCutMV).Add(fUseSPDpileUpCut).Add(fTrackletBGcut);
+  h.Add(fUseMultiplicityDependentPileUpCuts);
+  if (!fUseMultiplicityDependentPileUpCuts) h.Add(fSPDpileupMinContributors); /// otherwise set during the selection
+  h.Add(fSPDpileupMinZdist).Add(fSPDpileupNsigmaZdist).Add(fSPDpileupNsigmaDiamXY).Add(fSPDpileupNsigmaDiamZ);
+  h.Add(fUtils.GetMinPlpContribMV()).Add(fUtils.GetMaxPlpChi2MV()).Add(fUtils.GetMinWDistMV()).Add(fUtils.GetCheckPlpFromDifferentBCMV());
+  h.Add(fUtils.GetASPDCvsTCut()).Add(fUtils.GetBSPDCvsTCut());
+  h.Add(fMC).Add(fSelectInelGt0);
+  h.Add(fUseITSTPCCluCorrelationCut).Add(fUseStrongVarCorrelationCut).Add(fUseTPCTracklCorrelationCut);
+  h.Add(fITSvsTPCcluPolCut).Add(fVZEROvsTPCoutPolCut).Add(fFB128vsTrklLinearCut);
+  h.Add(fCentralityFramework).Add(fCentEstimators[0]).Add(fCentEstimators[1]).Add(fMultSelectionEvCuts);
+  h.Add(fUseEstimatorsCorrelationCut).Add(fEstimatorsCorrelationCoef).Add(fEstimatorsSigmaPars).Add(fDeltaEstimatorNsigma);
+  h.Add(fMinCentrality).Add(fMaxCentrality);
+  h.Add(fUseVariablesCorrelationCuts).Add(fTOFvsFB32correlationPars).Add(fTOFvsFB32sigmaPars).Add(fTOFvsFB32nSigmaCut);
+  h.Add(fESDvsTPConlyLinearCut).Add(fMultiplicityV0McorrCut);
+  h.Add(fUseTimeRangeCut).Add(fUseEMCALLEDEventsCut);
+  if (fUseEMCALLEDEventsCut) h.Add(this);
+  return h.fValue;
+}
+
 void AliEventCuts::ComputeTrackMultiplicity(AliVEvent *ev) {
   AliEventCutsContainer* tmp_cont = static_cast<AliEventCutsContainer*>(ev->FindListObject("AliEventCutsContainer"));
   if (tmp_cont) {
@@ -595,7 +722,7 @@ void AliEventCuts::ComputeTrackMultiplicity(AliVEvent *ev) {
     tmp_cont->fEventId = evid;
 
     if (!fNewEvent) {
-      fContainer = *tmp_cont;
+      fContainer.CopyMultiplicities(*tmp_cont);
       return;
     }
   } else {
@@ -670,7 +797,7 @@ void AliEventCuts::ComputeTrackMultiplicity(AliVEvent *ev) {
     for(int ich=0; ich < 64; ich++)
       tmp_cont->fMultVZERO += vzero->GetMultiplicity(ich);
   }
-  fContainer = *tmp_cont;
+  fContainer.CopyMultiplicities(*tmp_cont);
 }
 
 void AliEventCuts::SetupRun1pp() {
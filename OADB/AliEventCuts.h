@@ -6,6 +6,7 @@
 #include <TNamed.h>
 #include <TString.h> /// required to have easy access to tokenize
 #include <cmath>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -33,7 +34,48 @@ class AliEventCutsContainer : public TNamed {
     fMultTrkFB32TOF(-1),
     fMultTrkTPC(-1),
     fMultTrkTPCout(-1),
-    fMultVZERO(-1.) {}
+    fMultVZERO(-1.),
+    fCacheEntry(-1),
+    fCacheEventId(0u),
+    fQuantities(),
+    fSelections() {}
+
+    /// Result of the event selection of one cut configuration
+    struct Selection {
+      unsigned long fConfigHash;        ///< Hash of the cut configuration, see AliEventCuts::GetConfigurationHash
+      unsigned long fFlag;              ///< Flag of the passed cuts (without kAllCuts)
+      float fCentPercentiles[2];        ///< Centrality percentiles
+      double fDeltaZ;                   ///< Difference between the track and the SPD vertex
+      int fNTracklets;                  ///< Number of SPD tracklets
+      int fSPDpileupMinContributors;    ///< Multiplicity dependent SPD pile-up setting
+    };
+
+    /// The cache below is shared by all the AliEventCuts of a train that use it (see AliEventCuts::SetUseEventCache)
+    /// and is valid for a single event only.
+    void ResetCache(long long entry, unsigned long evid) { fCacheEntry = entry; fCacheEventId = evid; fQuantities.clear(); fSelections.clear(); }
+    bool GetQuantity(unsigned long key, double &value) const {
+      std::map<unsigned long,double>::const_iterator it = fQuantities.find(key);
+      if (it == fQuantities.end()) return false;
+      value = it->second;
+      return true;
+    }
+    void SetQuantity(unsigned long key, double value) { fQuantities[key] = value; }
+    const Selection* FindSelection(unsigned long configHash) const {
+      for (const Selection& sel : fSelections)
+        if (sel.fConfigHash == configHash) return &sel;
+      return nullptr;
+    }
+    void AddSelection(const Selection& sel) { fSelections.push_back(sel); }
+    void CopyMultiplicities(const AliEventCutsContainer& cont) {
+      fEventId = cont.fEventId;
+      fMultESD = cont.fMultESD;
+      fMultTrkFB32 = cont.fMultTrkFB32;
+      fMultTrkFB32Acc = cont.fMultTrkFB32Acc;
+      fMultTrkFB32TOF = cont.fMultTrkFB32TOF;
+      fMultTrkTPC = cont.fMultTrkTPC;
+      fMultTrkTPCout = cont.fMultTrkTPCout;
+      fMultVZERO = cont.fMultVZERO;
+    }
 
     unsigned long fEventId;
     int fMultESD;
@@ -43,7 +85,12 @@ class AliEventCutsContainer : public TNamed {
     int fMultTrkTPC;
     int fMultTrkTPCout;
     double fMultVZERO;
-  ClassDef(AliEventCutsContainer,2)
+
+    long long fCacheEntry;                      //!<! Analysis entry of the cached event
+    unsigned long fCacheEventId;                //!<! Identifier (bunch crossing and time stamp) of the cached event
+    std::map<unsigned long,double> fQuantities; //!<! Intermediate quantities (pile-up checks, centrality), keyed by quantity and settings
+    std::vector<Selection> fSelections;         //!<! Event selection results, one per cut configuration
+  ClassDef(AliEventCutsContainer,3)
 };
 
 class AliEventCuts : public TList {
@@ -102,6 +149,9 @@ class AliEventCuts : public TList {
     void   SetupRun2pA(int iPeriod);
     void   UseMultSelectionEventSelection(bool useIt = true);
     void   SetAcceptedTriggerClasses(TString classes);
+    /// Share the event selection with the other AliEventCuts of the train through the event (see AliEventCutsContainer):
+    /// identically configured instances reuse the result, the others the intermediate quantities.
+    void   SetUseEventCache(bool useIt = true) { fUseEventCache = useIt; }
 
     static bool GoodPrimaryAODVertex(AliVEvent *ev);
 
@@ -197,6 +247,9 @@ class AliEventCuts : public TList {
     AliEventCuts operator=(const AliEventCuts& copy);
     void          AutomaticSetup (AliVEvent *ev);
     void          ComputeTrackMultiplicity(AliVEvent *ev);
+    void          ComputeSelection(AliVEvent *ev, AliEventCutsContainer *cache, AliEventCutsContainer::Selection &sel);
+    AliEventCutsContainer* GetEventCache(AliVEvent *ev);
+    unsigned long GetConfigurationHash() const;
     template<typename F> F PolN(F x, F* coef, int n);
 
     bool          fManualMode;                    ///< if true the cuts are not loaded automatically looking at the run number
@@ -220,6 +273,7 @@ class AliEventCuts : public TList {
     bool          fSelectInelGt0;                 ///< Select only INEL > 0 events
     bool          fOverrideInelGt0;               ///< If the user ask for a configuration, let's not touch it
     bool          fOverrideCentralityFramework;   ///< If the user ask (not) to run a centrality framework this should be onored by AliEventCuts 
+    bool          fUseEventCache;                 ///< Share the event selection through the event, see SetUseEventCache
 
     AliTimeRangeCut fTimeRangeCut;       ///< Time Range cut
   
@@ -245,7 +299,7 @@ class AliEventCuts : public TList {
     AliESDtrackCuts* fFB32trackCuts; //!<! Cuts corresponding to FB32 in the ESD (used only for correlations cuts in ESDs)
     AliESDtrackCuts* fTPConlyCuts;   //!<! Cuts corresponding to the standalone TPC cuts in the ESDs (used only for correlations cuts in ESDs)
 
-    ClassDef(AliEventCuts, 16)
+    ClassDef(AliEventCuts, 17)
 };
 
 template<typename F> F AliEventCuts::PolN(F x,F* coef, int n) {
@@ -62,6 +62,7 @@ ClassImp(AliCaloTrackReader) ;
 //________________________________________
 AliCaloTrackReader::AliCaloTrackReader() :
 TObject(),                   fEventNumber(-1), //fCurrentFileName(""),
+fEventSerial(0),             fEtaPhiIndices(),
 fDataType(0),                fDebug(0),
 fFiducialCut(0x0),           fCheckFidCut(kFALSE),
 fComparePtHardAndJetPt(0),   fPtHardAndJetPtFactor(0),
@@ -4232,6 +4233,9 @@ void AliCaloTrackReader::RemapMCLabelForAODs(Int_t & label)
 //___________________________________
 void AliCaloTrackReader::ResetLists()
 {  
+  // The eta-phi indices of the lists have to be rebuilt in the next event
+  fEventSerial++;
+  
   if(fCTSTracks)       fCTSTracks     -> Clear();
   if(fEMCALClusters)   fEMCALClusters -> Clear("C");
   if(fPHOSClusters)    fPHOSClusters  -> Clear("C");
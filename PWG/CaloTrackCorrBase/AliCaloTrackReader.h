@@ -24,6 +24,8 @@
 //_________________________________________________________________________
 
 // --- ROOT system ---
+#include <map>
+#include <vector>
 #include <TObject.h> 
 #include <TString.h>
 class TObjArray ; 
@@ -86,6 +88,41 @@ public:
   virtual void    SetDataType(Int_t data )                 { fDataType = data              ; }
 
   virtual Int_t   GetEventNumber()                   const { return fEventNumber           ; }
+  
+  /// \return Serial number of the event in this reader, changed by ResetLists().
+  /// Unlike GetEventNumber(), the entry in the current file, it is different for every event.
+  Long64_t        GetEventSerial()                   const { return fEventSerial           ; }
+  
+  //------------------------------------------------
+  // Eta-phi index of the lists, used by AliIsolationCut
+  //------------------------------------------------
+  
+  //____________________________________________________________________________
+  /// \struct EtaPhiIndex
+  /// Kinematics of the tracks or clusters of one list of the reader and their 
+  /// binning in (eta, phi) cells. Built by AliIsolationCut once per event, shared 
+  /// by all candidates and all the isolation cuts working with this reader.
+  //____________________________________________________________________________
+  struct EtaPhiIndex
+  {
+    EtaPhiIndex() : fEventSerial(-1), fNEntries(0), fPt(), fEta(), fPhi(), fNotBinned(), 
+                    fEtaMin(0), fEtaWidth(1), fCellOffsets(), fCellEntries() { }
+    
+    Long64_t             fEventSerial;   ///< Reader event serial number when the index was built, see GetEventSerial().
+    Int_t                fNEntries;      ///< Entries in the list when the index was built.
+    std::vector<Float_t> fPt;            ///< pT of each entry.
+    std::vector<Float_t> fEta;           ///< Eta of each entry.
+    std::vector<Float_t> fPhi;           ///< Phi of each entry, in [0, 2 pi[.
+    std::vector<Int_t>   fNotBinned;     ///< Entries checked for every candidate: not a track/cluster or kinematics out of the cells.
+    Double_t             fEtaMin;        ///< Lower edge of the eta cells.
+    Double_t             fEtaWidth;      ///< Width of the eta cells.
+    std::vector<Int_t>   fCellOffsets;   ///< Entries of cell i are fCellEntries[fCellOffsets[i]] ... fCellEntries[fCellOffsets[i+1]-1].
+    std::vector<Int_t>   fCellEntries;   ///< Binned entries, cell after cell, in increasing order in each cell.
+  };
+  
+  /// \return Eta-phi index of a list of this reader, to be rebuilt if its 
+  /// serial number is not the current GetEventSerial().
+  EtaPhiIndex &   GetEtaPhiIndex(const TObjArray * list)   { return fEtaPhiIndices[list]   ; }
 	
   virtual TObjString *  GetListOfParameters() ;
   
@@ -889,6 +926,8 @@ public:
  protected:
   
   Int_t	           fEventNumber;                   ///<  Event number.
+  Long64_t         fEventSerial;                   //!<! Serial number of the event, changed by ResetLists().
+  std::map<const TObjArray*, EtaPhiIndex> fEtaPhiIndices; //!<! Eta-phi indices of the lists, see GetEtaPhiIndex().
   Int_t            fDataType ;                     ///<  Select MC: Kinematics, Data: ESD/AOD, MCData: Both.
   Int_t            fDebug;                         ///<  Debugging level.
   AliFiducialCut * fFiducialCut;                   ///<  Acceptance cuts.
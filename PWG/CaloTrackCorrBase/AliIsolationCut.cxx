@@ -14,6 +14,8 @@
  **************************************************************************/
 
 // --- ROOT system ---
+#include <vector>
+#include <algorithm>
 #include <TObjArray.h>
 #include <TH3F.h>
 #include <TCustomBinning.h>
@@ -40,13 +42,201 @@
 ClassImp(AliIsolationCut) ;
 /// \endcond
 
+namespace
+{
+  const Int_t kNEtaCells = 20; ///< Number of eta cells of the index, over the eta range of the list.
+  const Int_t kNPhiCells = 36; ///< Number of phi cells of the index, over 2 pi.
+
+  typedef AliCaloTrackReader::EtaPhiIndex EtaPhiIndex;
+
+  //____________________________________________________________________________
+  /// \return Index of the reader list of tracks or clusters, built if not yet 
+  /// done in this event. The index is kept by the reader and rebuilt after 
+  /// AliCaloTrackReader::ResetLists(). The kinematics are calculated as in 
+  /// AliIsolationCut::CalculateTrackSignalInCone() and CalculateCaloSignalInCone().
+  //____________________________________________________________________________
+  const EtaPhiIndex & GetEtaPhiIndex(const TObjArray * list, AliCaloTrackReader * reader, Bool_t clusters)
+  {
+    EtaPhiIndex & index = reader->GetEtaPhiIndex(list);
+    
+    if ( index.fEventSerial == reader->GetEventSerial() && 
+         index.fNEntries    == list->GetEntries()          ) return index;
+    
+    Int_t nEntries = list->GetEntries();
+    index.fEventSerial = reader->GetEventSerial();
+    index.fNEntries    = nEntries;
+    index.fPt .assign(nEntries, 0.);
+    index.fEta.assign(nEntries, 0.);
+    index.fPhi.assign(nEntries, 0.);
+    index.fNotBinned.clear();
+    
+    std::vector<Int_t> cells(nEntries, -1);
+    Double_t etaMin = 0, etaMax = 0;
+    Bool_t   first  = kTRUE;
+    TLorentzVector momentum;
+    TVector3       trackVector;
+    for(Int_t ipr = 0; ipr < nEntries; ipr++)
+    {
+      Float_t pt = 0, eta = 0, phi = 0;
+      Bool_t  ok = kTRUE;
+      
+      AliVCluster * calo  = 0x0;
+      AliVTrack   * track = 0x0;
+      if ( clusters ) calo  = dynamic_cast<AliVCluster*>(list->At(ipr));
+      else            track = dynamic_cast<AliVTrack*>  (list->At(ipr));
+      
+      if ( calo )
+      {
+        Int_t evtIndex = 0 ;
+        if ( reader->GetMixedEvent() )
+          evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
+        
+        calo->GetMomentum(momentum,reader->GetVertex(evtIndex)) ;
+        pt  = momentum.Pt()  ;
+        eta = momentum.Eta() ;
+        phi = momentum.Phi() ;
+      }
+      else if ( track )
+      {
+        trackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
+        pt  = trackVector.Pt();
+        eta = trackVector.Eta();
+        phi = trackVector.Phi() ;
+      }
+      else
+      {
+        AliCaloTrackParticle * mix = dynamic_cast<AliCaloTrackParticle*>(list->At(ipr)) ;
+        if ( mix )
+        {
+          pt  = mix->Pt();
+          eta = mix->Eta();
+          phi = mix->Phi() ;
+        }
+        else ok = kFALSE;
+      }
+      
+      if ( phi < 0 ) phi+=TMath::TwoPi();
+      
+      index.fPt [ipr] = pt;
+      index.fEta[ipr] = eta;
+      index.fPhi[ipr] = phi;
+      
+      // Wrong type, or position where the cells could miss it
+      if ( !ok || !TMath::Finite(eta) || TMath::Abs(eta) > 10 || 
+           !TMath::Finite(phi) || phi < 0 || phi >= TMath::TwoPi() )
+      {
+        index.fNotBinned.push_back(ipr);
+        continue;
+      }
+      
+      if ( first || eta < etaMin ) etaMin = eta;
+      if ( first || eta > etaMax ) etaMax = eta;
+      first = kFALSE;
+      cells[ipr] = 0;
+    }
+    
+    index.fEtaMin   = etaMin;
+    index.fEtaWidth = etaMax > etaMin ? (etaMax-etaMin)/kNEtaCells : 1.;
+    
+    index.fCellOffsets.assign(kNEtaCells*kNPhiCells+1, 0);
+    for(Int_t ipr = 0; ipr < nEntries; ipr++)
+    {
+      if ( cells[ipr] < 0 ) continue;
+      Int_t ieta = TMath::Min(kNEtaCells-1, (Int_t) ((index.fEta[ipr]-index.fEtaMin)/index.fEtaWidth));
+      Int_t iphi = TMath::Min(kNPhiCells-1, (Int_t) (index.fPhi[ipr]/(TMath::TwoPi()/kNPhiCells)));
+      cells[ipr] = ieta*kNPhiCells+iphi;
+      index.fCellOffsets[cells[ipr]+1]++;
+    }
+    
+    for(Int_t icell = 0; icell < kNEtaCells*kNPhiCells; icell++) 
+      index.fCellOffsets[icell+1] += index.fCellOffsets[icell];
+    
+    index.fCellEntries.resize(index.fCellOffsets.back());
+    std::vector<Int_t> fill(index.fCellOffsets.begin(), index.fCellOffsets.end()-1);
+    for(Int_t ipr = 0; ipr < nEntries; ipr++)
+    {
+      if ( cells[ipr] >= 0 ) index.fCellEntries[fill[cells[ipr]]++] = ipr;
+    }
+    
+    return index;
+  }
+  
+  //____________________________________________________________________________
+  /// Add the entries of the cells overlapping the eta range [etaLow, etaHigh] 
+  /// and the phi range [phiLow, phiHigh], modulo 2 pi. One cell of margin 
+  /// is added on each side, for the rounding of the selections.
+  //____________________________________________________________________________
+  void AddEntriesInCells(const EtaPhiIndex & index, 
+                         Bool_t allEta, Double_t etaLow, Double_t etaHigh,
+                         Bool_t allPhi, Double_t phiLow, Double_t phiHigh,
+                         std::vector<Int_t> & entries)
+  {
+    Int_t ietaMin = 0, ietaMax = kNEtaCells-1;
+    if ( !allEta )
+    {
+      ietaMin = (Int_t) TMath::Max(0., TMath::Min(kNEtaCells-1., TMath::Floor((etaLow -index.fEtaMin)/index.fEtaWidth) - 1));
+      ietaMax = (Int_t) TMath::Max(0., TMath::Min(kNEtaCells-1., TMath::Floor((etaHigh-index.fEtaMin)/index.fEtaWidth) + 1));
+    }
+    
+    const Double_t phiWidth = TMath::TwoPi()/kNPhiCells;
+    Int_t iphiMin = 0, nphi = kNPhiCells;
+    if ( !allPhi )
+    {
+      iphiMin = (Int_t) TMath::Floor(phiLow/phiWidth) - 1;
+      nphi    = TMath::Min(kNPhiCells, (Int_t) TMath::Floor(phiHigh/phiWidth) + 1 - iphiMin + 1);
+    }
+    
+    for(Int_t ieta = ietaMin; ieta <= ietaMax; ieta++)
+    {
+      for(Int_t jphi = 0; jphi < nphi; jphi++)
+      {
+        Int_t icell = ieta*kNPhiCells + ((iphiMin+jphi)%kNPhiCells+kNPhiCells)%kNPhiCells;
+        entries.insert(entries.end(), 
+                       index.fCellEntries.begin()+index.fCellOffsets[icell], 
+                       index.fCellEntries.begin()+index.fCellOffsets[icell+1]);
+      }
+    }
+  }
+  
+  //____________________________________________________________________________
+  /// Fill the list of entries that can enter the isolation cone of the candidate 
+  /// or, if bands is true, the eta and phi UE bands or the perpendicular cones.
+  /// Entries are given in increasing order, as in the loop over the full list.
+  //____________________________________________________________________________
+  void GetEntriesAroundCandidate(const EtaPhiIndex & index, Float_t etaC, Float_t phiC, 
+                                 Float_t coneSize, Bool_t bands, std::vector<Int_t> & entries)
+  {
+    entries = index.fNotBinned;
+    
+    if ( !TMath::Finite(etaC) || !TMath::Finite(phiC) || phiC < 0 || phiC >= TMath::TwoPi() )
+    {
+      // Unexpected candidate direction, check everything
+      AddEntriesInCells(index, kTRUE, 0, 0, kTRUE, 0, 0, entries);
+    }
+    else
+    {
+      Bool_t allPhi = coneSize >= TMath::Pi();
+      
+      // Cone, the eta band is the same phi range for all eta
+      AddEntriesInCells(index, bands, etaC-coneSize, etaC+coneSize, allPhi, phiC-coneSize, phiC+coneSize, entries);
+      
+      // Phi band and perpendicular cones, same eta range for all phi
+      if ( bands ) 
+        AddEntriesInCells(index, kFALSE, etaC-coneSize, etaC+coneSize, kTRUE, 0, 0, entries);
+    }
+    
+    std::sort(entries.begin(), entries.end());
+    entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+  }
+}
+
 //____________________________________
 /// Default constructor. Initialize parameters
 //____________________________________
 AliIsolationCut::AliIsolationCut() :
 TObject(),
 fFillHistograms(0),  fFillEtaPhiHistograms(0),      fFillHighMultHistograms(0), 
-fMakeConeExcessCorr(0),
+fMakeConeExcessCorr(0), fUseEtaPhiIndex(0),
 fConeSize(0.),       fConeSizeBandGap(0.),          fUEBandRectangularExclusion(0),
 fPtThreshold(0.),    fPtThresholdMax(10000.),
 fSumPtThreshold(0.), fSumPtThresholdMax(10000.),    fSumPtThresholdGap(0.),
@@ -195,11 +385,24 @@ void AliIsolationCut::CalculateCaloSignalInCone
   TObjArray * refclusters  = 0x0;
   Int_t       nclusterrefs = 0;
   
+  // With the eta-phi index, look only at the clusters in the cells around the candidate
+  //
+  const EtaPhiIndex * index = 0x0;
+  std::vector<Int_t>  entries;
+  if ( fUseEtaPhiIndex && !bgCls && !useRefs && !(fFillHistograms && fFillEtaPhiHistograms) )
+  {
+    index = &GetEtaPhiIndex(plNe, reader, kTRUE);
+    GetEntriesAroundCandidate(*index, etaC, phiC, fConeSize, fICMethod >= kSumBkgSubIC, entries);
+  }
+  Int_t nEntries = index ? (Int_t) entries.size() : plNe->GetEntries();
+  
   // Get the clusters
   //
   //printf("Loop calo\n");
-  for(Int_t ipr = 0;ipr < plNe->GetEntries() ; ipr ++ )
+  for(Int_t ientry = 0;ientry < nEntries ; ientry ++ )
   {
+    Int_t ipr = index ? entries[ientry] : ientry;
+    
     AliVCluster * calo = dynamic_cast<AliVCluster *>(plNe->At(ipr)) ;
     
     if ( calo )
@@ -223,12 +426,21 @@ void AliIsolationCut::CalculateCaloSignalInCone
         if ( fPartInCone == kNeutralAndCharged && matched ) continue ;
       }
       
-      // Assume that come from vertex in straight line
-      calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
-      
-      pt  = fMomentum.Pt()  ;
-      eta = fMomentum.Eta() ;
-      phi = fMomentum.Phi() ;
+      if ( index )
+      {
+        pt  = index->fPt [ipr];
+        eta = index->fEta[ipr];
+        phi = index->fPhi[ipr];
+      }
+      else
+      {
+        // Assume that come from vertex in straight line
+        calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
+        
+        pt  = fMomentum.Pt()  ;
+        eta = fMomentum.Eta() ;
+        phi = fMomentum.Phi() ;
+      }
     }
     else
     {// Mixed event stored in AliCaloTrackParticles
@@ -548,12 +760,25 @@ void AliIsolationCut::CalculateTrackSignalInCone
   TObjArray * reftracks  = 0x0;
   Int_t       ntrackrefs = 0;
     
+  // With the eta-phi index, look only at the tracks in the cells around the candidate
+  //
+  const EtaPhiIndex * index = 0x0;
+  std::vector<Int_t>  entries;
+  if ( fUseEtaPhiIndex && !bgTrk && !useRefs && !(fFillHistograms && fFillEtaPhiHistograms) )
+  {
+    index = &GetEtaPhiIndex(plCTS, reader, kFALSE);
+    GetEntriesAroundCandidate(*index, etaTrig, phiTrig, fConeSize, fICMethod >= kSumBkgSubIC, entries);
+  }
+  Int_t nEntries = index ? (Int_t) entries.size() : plCTS->GetEntries();
+  
   //-----------------------------------------------------------
   // Get the tracks in cone
   //
   //-----------------------------------------------------------
-  for(Int_t ipr = 0;ipr < plCTS->GetEntries() ; ipr ++ )
+  for(Int_t ientry = 0;ientry < nEntries ; ientry ++ )
   {
+    Int_t ipr = index ? entries[ientry] : ientry;
+    
     AliVTrack* track = dynamic_cast<AliVTrack*>(plCTS->At(ipr)) ;
     
     if(track)
@@ -574,10 +799,19 @@ void AliIsolationCut::CalculateTrackSignalInCone
         if ( contained ) continue ;
       }
       
-      fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
-      ptTrack  = fTrackVector.Pt();
-      etaTrack = fTrackVector.Eta();
-      phiTrack = fTrackVector.Phi() ;
+      if ( index )
+      {
+        ptTrack  = index->fPt [ipr];
+        etaTrack = index->fEta[ipr];
+        phiTrack = index->fPhi[ipr];
+      }
+      else
+      {
+        fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
+        ptTrack  = fTrackVector.Pt();
+        etaTrack = fTrackVector.Eta();
+        phiTrack = fTrackVector.Phi() ;
+      }
     }
     else
     {// Mixed event stored in AliCaloTrackParticles
@@ -2228,6 +2462,8 @@ TString AliIsolationCut::GetICParametersList()
   parList+=onePar ;
   snprintf(onePar,buffersize,"fMakeConeExcessCorr=%d;",fMakeConeExcessCorr) ;
   parList+=onePar ;
+  snprintf(onePar,buffersize,"fUseEtaPhiIndex=%d;",fUseEtaPhiIndex) ;
+  parList+=onePar ;
   snprintf(onePar,buffersize,"fNeutralOverChargedRatio={%1.2e,%1.2e,%1.2e,%1.2e};",
            fNeutralOverChargedRatio[0],fNeutralOverChargedRatio[1],fNeutralOverChargedRatio[2],fNeutralOverChargedRatio[3]) ;
   parList+=onePar ;
@@ -2248,6 +2484,7 @@ void AliIsolationCut::InitParameters()
   fConeSizeBandGap      = 0.0 ;
   fUEBandRectangularExclusion = kTRUE;
   fMakeConeExcessCorr   = kFALSE;
+  fUseEtaPhiIndex       = kFALSE;
   fPtThreshold          = 0.5  ;
   fPtThresholdMax       = 10000.;
   fSumPtThreshold       = 2.0 ;
@@ -2793,6 +3030,7 @@ void AliIsolationCut::Print(const Option_t * opt) const
   printf("using fraction for high pt leading instead of frac ? %i\n",fFracIsThresh);
   printf("minimum distance to candidate, R>%1.2f\n",fDistMinToTrigger);
   printf("correct cone excess = %d \n",fMakeConeExcessCorr);
+  printf("use eta-phi index = %d \n",fUseEtaPhiIndex);
   printf("NeutralOverChargedRatio param={%1.2e,%1.2e,%1.2e,%1.2e} \n",
   fNeutralOverChargedRatio[0],fNeutralOverChargedRatio[1],fNeutralOverChargedRatio[2],fNeutralOverChargedRatio[3]) ;
   printf("    \n") ;
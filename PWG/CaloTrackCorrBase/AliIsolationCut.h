@@ -193,6 +193,10 @@ class AliIsolationCut : public TObject {
   void       SwitchOnConeExcessCorrection ()                   { fMakeConeExcessCorr = kTRUE  ; }
   void       SwitchOffConeExcessCorrection()                   { fMakeConeExcessCorr = kFALSE ; }
   
+  void       SwitchOnEtaPhiIndex ()                            { fUseEtaPhiIndex = kTRUE  ; }
+  void       SwitchOffEtaPhiIndex()                            { fUseEtaPhiIndex = kFALSE ; }
+  Bool_t     IsEtaPhiIndexUsed()                         const { return fUseEtaPhiIndex ; }
+  
  private:
 
   Bool_t     fFillHistograms;                          ///< Fill histograms if GetCreateOuputObjects() was called. 
@@ -203,6 +207,8 @@ class AliIsolationCut : public TObject {
   
   Bool_t     fMakeConeExcessCorr;                      ///< Make cone excess from detector correction. 
   
+  Bool_t     fUseEtaPhiIndex;                          ///< Check only the tracks/clusters in the eta-phi cells around the candidate, from an index of the reader lists built once per event.
+  
   Float_t    fConeSize ;                               ///< Size of the isolation cone
  
   Float_t    fConeSizeBandGap ;                        ///< Gap to add to size of the isolation cone when filling eta/phi bands for UE estimation
@@ -372,7 +378,7 @@ class AliIsolationCut : public TObject {
   AliIsolationCut & operator = (const AliIsolationCut & g) ; 
 
   /// \cond CLASSIMP
-  ClassDef(AliIsolationCut,15) ;
+  ClassDef(AliIsolationCut,16) ;
   /// \endcond
 
 } ;
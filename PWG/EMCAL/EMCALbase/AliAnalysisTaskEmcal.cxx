@@ -1667,15 +1667,21 @@ Bool_t AliAnalysisTaskEmcal::RetrieveEventObjects()
 
   fTriggers = GetTriggerList();
 
+  // Serial number of the event in the train, identifies the event for the acceptance caches of the containers
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  Long64_t eventSerial = mgr ? mgr->GetNcalls() : -1;
+
   AliEmcalContainer* cont = 0;
 
   TIter nextPartColl(&fParticleCollArray);
   while ((cont = static_cast<AliEmcalContainer*>(nextPartColl()))){
+    cont->SetEventSerial(eventSerial);
     cont->NextEvent(InputEvent());
   }
 
   TIter nextClusColl(&fClusterCollArray);
   while ((cont = static_cast<AliParticleContainer*>(nextClusColl()))){
+    cont->SetEventSerial(eventSerial);
     cont->NextEvent(InputEvent());
   }
 
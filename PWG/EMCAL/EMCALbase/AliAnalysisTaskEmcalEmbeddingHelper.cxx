@@ -26,9 +26,12 @@
 #include <TMath.h>
 #include <TRandom.h>
 #include <TChain.h>
+#include <TChainElement.h>
+#include <TFileCacheRead.h>
 #include <TGrid.h>
 #include <TGridResult.h>
 #include <TSystem.h>
+#include <TUrl.h>
 #include <TUUID.h>
 #include <TKey.h>
 #include <TProfile.h>
@@ -171,7 +174,13 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper() :
   fPythiaCrossSectionFromFile(0.),
   fPythiaPtHard(0.),
   fPrintTimingInfoToLog(false),
-  fTimer()
+  fTimer(),
+  fReadTimer(),
+  fPrefetch(false),
+  fTreeCacheSize(50000000),
+  fPrefetchBranches(),
+  fFileOpenedAhead(-1),
+  fFileOpenedAheadHandle(nullptr)
 {
   if (fgInstance != nullptr) {
     AliError("An instance of AliAnalysisTaskEmcalEmbeddingHelper already exists: it will be deleted!!!");
@@ -246,7 +255,13 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
   fPythiaCrossSectionFromFile(0.),
   fPythiaPtHard(0.),
   fPrintTimingInfoToLog(false),
-  fTimer()
+  fTimer(),
+  fReadTimer(),
+  fPrefetch(false),
+  fTreeCacheSize(50000000),
+  fPrefetchBranches(),
+  fFileOpenedAhead(-1),
+  fFileOpenedAheadHandle(nullptr)
 {
   if (fgInstance != 0) {
     AliError("An instance of AliAnalysisTaskEmcalEmbeddingHelper already exists: it will be deleted!!!");
@@ -268,6 +283,7 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
 AliAnalysisTaskEmcalEmbeddingHelper::~AliAnalysisTaskEmcalEmbeddingHelper()
 {
   if (fgInstance == this) fgInstance = nullptr;
+  ReleaseFileOpenedAhead();
   if (fExternalEvent) delete fExternalEvent;
   if (fExternalMCEvent) delete fExternalMCEvent;
   if (fExternalFile) {
@@ -332,6 +348,11 @@ void AliAnalysisTaskEmcalEmbeddingHelper::RetrieveTaskPropertiesFromYAMLConfig()
   res = fYAMLConfig.GetProperty("randomFileAccess", fRandomFileAccess, false);
   res = fYAMLConfig.GetProperty("createHisto", fCreateHisto, false);
   res = fYAMLConfig.GetProperty("printTimingInfoInLog", fPrintTimingInfoToLog, false);
+  // Prefetch mode
+  std::string prefetchBaseName = "prefetch";
+  res = fYAMLConfig.GetProperty({prefetchBaseName, "enabled"}, fPrefetch, false);
+  res = fYAMLConfig.GetProperty({prefetchBaseName, "treeCacheSize"}, fTreeCacheSize, false);
+  res = fYAMLConfig.GetProperty({prefetchBaseName, "branches"}, fPrefetchBranches, false);
   // More general embedding helper properties
   res = fYAMLConfig.GetProperty("filePattern", fFilePattern, false);
   res = fYAMLConfig.GetProperty("inputFilename", fInputFilename, false);
@@ -827,6 +848,12 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
 {
   Int_t attempts = -1;
 
+  // Time spent by the event loop waiting for the embedded event
+  const bool recordReadTime = fCreateHisto && (fPrefetch || fPrintTimingInfoToLog);
+  if (recordReadTime) {
+    fReadTimer.Start(kTRUE);
+  }
+
   do {
     // Reset to start of tree
     if (fCurrentEntry == fUpperEntry) {
@@ -897,6 +924,13 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
     fHistManager.FillTH1("fHistEmbeddedEventsAttempted", attempts);
   }
 
+  if (recordReadTime) {
+    fReadTimer.Stop();
+    fHistManager.FillTH1("fHistEmbeddedEventReadTime", fReadTimer.RealTime()*1000);
+    fHistManager.FillTH1("fHistEmbeddedEventStallTime", "RealTime", fReadTimer.RealTime());
+    fHistManager.FillTH1("fHistEmbeddedEventStallTime", "Events", 1);
+  }
+
   if (!fChain) return kFALSE;
 
   return kTRUE;
@@ -1259,6 +1293,22 @@ void AliAnalysisTaskEmcalEmbeddingHelper::UserCreateOutputObjects()
     fHistManager.CreateTH1(histName, histTitle, 200, 0, 2000);
   }
 
+  // Time that the event loop waits for the embedded event
+  if (fPrefetch || fPrintTimingInfoToLog) {
+    histName = "fHistEmbeddedEventReadTime";
+    histTitle = "Real time to get the next embedded event, including the rejected ones;t (ms);Counts";
+    fHistManager.CreateTH1(histName, histTitle, 500, 0, 500);
+
+    histName = "fHistEmbeddedEventStallTime";
+    histTitle = "Total real time to get the embedded events";
+    binLabels = {"RealTime", "Events"};
+    auto histEmbeddedEventStallTime = fHistManager.CreateTH1(histName, histTitle, binLabels.size(), 0, binLabels.size());
+    for (unsigned int i = 1; i <= binLabels.size(); i++) {
+      histEmbeddedEventStallTime->GetXaxis()->SetBinLabel(i, binLabels.at(i-1).c_str());
+    }
+    histEmbeddedEventStallTime->GetYaxis()->SetTitle("Real time (s) / Number of events");
+  }
+
   // Add all histograms to output list
   TIter next(fHistManager.GetListOfHistograms());
   TObject* obj = 0;
@@ -1332,6 +1382,11 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::SetupInputFiles()
   // Keep track of the total number of files in the TChain to ensure that we don't start repeating within the chain
   fMaxNumberOfFiles = fChain->GetListOfFiles()->GetEntries();
 
+  // The cache is created by the chain when the first tree is loaded. It is configured in InitTree()
+  if (fPrefetch) {
+    fChain->SetCacheSize(fTreeCacheSize);
+  }
+
   if (fFilenames.size() > fMaxNumberOfFiles) {
     AliErrorStream() << "Number of input files (" << fFilenames.size() << ") is larger than the number of available files (" << fMaxNumberOfFiles << "). Something went wrong when adding some of those files to the TChain!\n";
   }
@@ -1512,6 +1567,12 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
 
   // Note that the tree in the new file has been initialized
   fInitializedNewFile = kTRUE;
+
+  // Prefetch the entries of the new tree and open the following file while this one is being read
+  if (fPrefetch) {
+    ConfigureTreeCache();
+    OpenNextFileAhead();
+  }
   
   // Stop timer (for logging purposes)
   if (fPrintTimingInfoToLog) {
@@ -1523,6 +1584,99 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
 
 }
 
+/**
+ * Configure the TTreeCache of the tree which was just loaded in the chain (prefetch mode). The requested
+ * branches are added to the cache (otherwise the cache learns them from the first entries read), and the
+ * baskets of the next cache block are read asynchronously while the current block is being used.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::ConfigureTreeCache()
+{
+  TFile * file = fChain->GetCurrentFile();
+  if (!file || fTreeCacheSize <= 0) {
+    return;
+  }
+
+  if (fPrefetchBranches.size() > 0) {
+    for (const auto & branch : fPrefetchBranches) {
+      fChain->AddBranchToCache(branch.c_str(), kTRUE);
+    }
+    fChain->StopCacheLearningPhase();
+  }
+
+  TFileCacheRead * cache = file->GetCacheRead(fChain->GetTree());
+  if (!cache) {
+    cache = file->GetCacheRead(fChain);
+  }
+  if (cache) {
+    cache->SetEnablePrefetching(kTRUE);
+  }
+  else {
+    AliWarningStream() << "No TTreeCache available for \"" << file->GetName() << "\". The embedded events will be read without prefetching.\n";
+  }
+}
+
+/**
+ * Start opening the file which follows the current one in the chain (prefetch mode). TFile::Open() picks
+ * up the pending request when the chain moves to that file, such that the time to open it (in particular
+ * for remote files) overlaps with the reading of the current file.
+ *
+ * Only done for the xrootd protocols: for other files TFile::AsyncOpen() opens the file right away,
+ * which would only block the reading of the current file.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::OpenNextFileAhead()
+{
+  if (fFileOpenedAheadHandle && fChain->GetTreeNumber() == fFileOpenedAhead) {
+    // The chain moved to this file: TFile::Open() used the pending request and deleted the handle
+    fFileOpenedAheadHandle = nullptr;
+  }
+
+  if (fMaxNumberOfFiles < 2) {
+    ReleaseFileOpenedAhead();
+    return;
+  }
+
+  Int_t nextTree = (fChain->GetTreeNumber() + 1) % fMaxNumberOfFiles;
+  if (nextTree == fFileOpenedAhead) {
+    return;
+  }
+
+  // The chain did not move to the file opened before (e.g. it started again from a random file)
+  ReleaseFileOpenedAhead();
+
+  TChainElement * element = static_cast<TChainElement *>(fChain->GetListOfFiles()->At(nextTree));
+  if (!element) {
+    return;
+  }
+
+  TString protocol = TUrl(element->GetTitle()).GetProtocol();
+  if (protocol != "root" && protocol != "roots" && protocol != "xroot" && protocol != "xroots") {
+    return;
+  }
+
+  AliDebugStream(3) << "Opening the next file to embed ahead of time: \"" << element->GetTitle() << "\".\n";
+  fFileOpenedAheadHandle = TFile::AsyncOpen(element->GetTitle());
+  fFileOpenedAhead = nextTree;
+}
+
+/**
+ * Release the pending asynchronous open of the file opened ahead of time, if the chain did not use it.
+ * TFile::Open() waits for the request to complete and deletes the handle, the file is then closed.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::ReleaseFileOpenedAhead()
+{
+  if (fFileOpenedAheadHandle) {
+    if (!fChain || fChain->GetTreeNumber() != fFileOpenedAhead) {
+      TFile * file = TFile::Open(fFileOpenedAheadHandle);
+      if (file) {
+        file->Close();
+        delete file;
+      }
+    }
+    fFileOpenedAheadHandle = nullptr;
+  }
+  fFileOpenedAhead = -1;
+}
+
 /**
  * Extract pythia information from a cross section file. Modified from AliAnalysisTaskEmcal::PythiaInfoFromFile().
  *
@@ -1902,6 +2056,18 @@ std::string AliAnalysisTaskEmcalEmbeddingHelper::toString(bool includeFileList)
   tempSS << "File list filename: \"" << fFileListFilename << "\"\n";
   tempSS << "Tree name: " << fTreeName << "\n";
   tempSS << "Print timing info to log: " << fPrintTimingInfoToLog << "\n";
+  tempSS << "Prefetch mode: " << fPrefetch << "\n";
+  if (fPrefetch) {
+    tempSS << "\tTTree cache size: " << fTreeCacheSize << " bytes\n";
+    tempSS << "\tCached branches:";
+    if (fPrefetchBranches.size() == 0) {
+      tempSS << " learnt from the first entries";
+    }
+    for (const auto & branch : fPrefetchBranches) {
+      tempSS << " " << branch;
+    }
+    tempSS << "\n";
+  }
   tempSS << "Random event number access: " << fRandomEventNumberAccess << "\n";
   tempSS << "Random file access: " << fRandomFileAccess << "\n";
   tempSS << "Starting file index: " << fFilenameIndex << "\n";
@@ -19,6 +19,7 @@
 class TString;
 class TChain;
 class TFile;
+class TFileOpenHandle;
 class AliVEvent;
 class AliMCEvent;
 class AliVHeader;
@@ -123,6 +124,9 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Int_t GetStartingFileIndex()                              const { return fFilenameIndex; }
   TString GetFileListFilename()                             const { return fFileListFilename; }
   bool GetCreateHistos()                                    const { return fCreateHisto; }
+  bool GetPrefetch()                                        const { return fPrefetch; }
+  Long64_t GetTreeCacheSize()                               const { return fTreeCacheSize; }
+  std::vector<std::string> GetPrefetchBranches()            const { return fPrefetchBranches; }
   TString GetExternalFilePath()                             const ;
   
   // Set
@@ -136,6 +140,15 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   void SetAOD(const char * treeName = "aodTree")                  { fTreeName     = treeName; }
   /// Set whether to print and plot execution time of InitTree()
   void SetPrintTimingInfoToLog(bool b)                            { fPrintTimingInfoToLog = b;}
+  /**
+   * Enable the prefetch mode: the embedded events are read through a TTreeCache whose baskets are
+   * prefetched asynchronously, and the next file of the chain is opened ahead of time.
+   */
+  void SetPrefetch(bool b = true)                                 { fPrefetch = b; }
+  /// Set the size of the TTreeCache used in prefetch mode (bytes)
+  void SetTreeCacheSize(Long64_t size)                            { fTreeCacheSize = size; }
+  /// Set the branches to be cached in prefetch mode. If empty, the cache learns them from the first entries read.
+  void SetPrefetchBranches(const std::vector<std::string> & branches) { fPrefetchBranches = branches; }
   /**
    * Enable to begin embedding at a random entry in each embedded file. Will then loop around in order
    * so that all entries are made available.
@@ -307,6 +320,9 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   virtual Bool_t  CheckIsEmbeddedEventSelected();
   Bool_t          InitEvent()           ;
   void            InitTree()            ;
+  void            ConfigureTreeCache()  ;
+  void            OpenNextFileAhead()   ;
+  void            ReleaseFileOpenedAhead();
   bool            PythiaInfoFromCrossSectionFile(std::string filename);
   // Validation helper
   void            ValidatePhysicsSelectionForInternalEventSelection();
@@ -383,6 +399,13 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   
   bool                                          fPrintTimingInfoToLog; ///< Flag to print time to execute InitTree(), for logging purposes
   TStopwatch                                    fTimer            ;    //!<! Timer for the InitTree() function
+  TStopwatch                                    fReadTimer        ;    //!<! Timer for the blocking reads of the embedded events in GetNextEntry()
+
+  bool                                          fPrefetch         ; ///<  If true, read through a TTreeCache with asynchronous prefetching and open the next file ahead of time
+  Long64_t                                      fTreeCacheSize    ; ///<  Size of the TTreeCache in prefetch mode (bytes)
+  std::vector <std::string>                     fPrefetchBranches ; ///<  Branches added to the TTreeCache in prefetch mode. If empty, they are learnt from the first entries
+  Int_t                                         fFileOpenedAhead  ; //!<! Tree number in the chain of the last file opened ahead of time
+  TFileOpenHandle                              *fFileOpenedAheadHandle; //!<! Pending asynchronous open of the file opened ahead of time (null once TFile::Open() picked it up)
 
   static AliAnalysisTaskEmcalEmbeddingHelper   *fgInstance        ; //!<! Global instance of this class
 
@@ -391,7 +414,7 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   AliAnalysisTaskEmcalEmbeddingHelper &operator=(const AliAnalysisTaskEmcalEmbeddingHelper&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 13);
+  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 14);
   /// \endcond
 };
 #endif
@@ -1137,8 +1137,18 @@ Bool_t AliAnalysisTaskEmcalLight::RetrieveEventObjects()
     }
   }
 
-  for (auto cont_it : fParticleCollArray) cont_it.second->NextEvent(InputEvent());
-  for (auto cont_it : fClusterCollArray) cont_it.second->NextEvent(InputEvent());
+  // Serial number of the event in the train, identifies the event for the acceptance caches of the containers
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  Long64_t eventSerial = mgr ? mgr->GetNcalls() : -1;
+
+  for (auto cont_it : fParticleCollArray) {
+    cont_it.second->SetEventSerial(eventSerial);
+    cont_it.second->NextEvent(InputEvent());
+  }
+  for (auto cont_it : fClusterCollArray) {
+    cont_it.second->SetEventSerial(eventSerial);
+    cont_it.second->NextEvent(InputEvent());
+  }
 
   return kTRUE;
 }
@@ -17,7 +17,9 @@
 #include <iostream>
 #include <vector>
 #include <TClonesArray.h>
+#include <TMath.h>
 
+#include "AliAODCaloCluster.h"
 #include "AliAODEvent.h"
 #include "AliESDEvent.h"
 #include "AliVCaloCells.h"
@@ -29,6 +31,7 @@
 
 /// \cond CLASSIMP
 ClassImp(AliClusterContainer);
+ClassImp(PWG::EMCAL::TestAliClusterContainer);
 /// \endcond
 
 // string to enum map for use with the %YAML config
@@ -151,7 +154,7 @@ AliVCluster* AliClusterContainer::GetAcceptCluster(Int_t i) const
   if (!vc) return 0;
 
   UInt_t rejectionReason = 0;
-  if (AcceptCluster(vc, rejectionReason))
+  if (IsAccepted(i, rejectionReason))
     return vc;
   else {
     AliDebug(2,"Cluster not accepted.");
@@ -640,3 +643,122 @@ int TestClusterContainerIterator(const AliClusterContainer *const cont, int iter
   }
   return testresult;
 }
+
+namespace PWG {
+
+namespace EMCAL {
+
+bool TestAliClusterContainer::RunAllTests() const {
+  return TestSelectionHash() && TestCachedAcceptance() && TestCacheInvalidation();
+}
+
+bool TestAliClusterContainer::TestSelectionHash() const {
+  AliAODEvent event;
+  event.CreateStdContent();
+
+  // SetArray connects the EMCAL cells of the event, which must not enter the hash
+  AliClusterContainer cont1("caloClusters"), cont2("caloClusters"), cont3("caloClusters");
+  cont1.SetClusECut(0.3);
+  cont2.SetClusECut(0.3);
+  cont3.SetClusECut(0.5);
+  cont1.SetArray(&event);
+  cont2.SetArray(&event);
+  cont3.SetArray(&event);
+
+  int nfailure = 0;
+  if (cont1.GetSelectionHash() != cont2.GetSelectionHash()) {
+    AliErrorStream() << "Containers with the same cuts have different selection hashes" << std::endl;
+    nfailure++;
+  }
+  if (cont1.GetSelectionHash() == cont3.GetSelectionHash()) {
+    AliErrorStream() << "Containers with different cuts have the same selection hash" << std::endl;
+    nfailure++;
+  }
+  return nfailure == 0;
+}
+
+bool TestAliClusterContainer::TestCachedAcceptance() const {
+  AliAODEvent event;
+  event.CreateStdContent();
+  FillClusters(event, {0.1, 1.2, 0.25, 5.0, 0.35, 0.05, 2.0, 0.31, 0.29, 10.0});
+
+  AliClusterContainer cached("caloClusters"), uncached("caloClusters");
+  cached.SetClusECut(0.3);
+  uncached.SetClusECut(0.3);
+  cached.SetUseAcceptanceCache();
+  cached.SetArray(&event);
+  uncached.SetArray(&event);
+  cached.SetEventSerial(0);
+  cached.NextEvent(&event);
+  uncached.NextEvent(&event);
+
+  return CompareWithUncached(cached, uncached) == 0;
+}
+
+bool TestAliClusterContainer::TestCacheInvalidation() const {
+  AliAODEvent event;
+  event.CreateStdContent();
+  FillClusters(event, {0.1, 1.2, 0.25, 5.0, 0.35, 0.05});
+
+  // first builds the cache, second reads it
+  AliClusterContainer first("caloClusters"), second("caloClusters"), uncached("caloClusters");
+  first.SetClusECut(0.3);
+  second.SetClusECut(0.3);
+  uncached.SetClusECut(0.3);
+  first.SetUseAcceptanceCache();
+  second.SetUseAcceptanceCache();
+  first.SetArray(&event);
+  second.SetArray(&event);
+  uncached.SetArray(&event);
+
+  int nfailure = 0;
+  for (int ievent = 0; ievent < 2; ievent++) {
+    // same number of clusters, opposite selection in the second event
+    if (ievent == 1) FillClusters(event, {1.2, 0.1, 5.0, 0.25, 0.05, 0.35});
+    // serial numbers not used by the other tests, the caches are shared by all containers of the process
+    first.SetEventSerial(ievent + 1);
+    second.SetEventSerial(ievent + 1);
+    first.NextEvent(&event);
+    second.NextEvent(&event);
+    uncached.NextEvent(&event);
+
+    Int_t nfirst = CompareWithUncached(first, uncached), nsecond = CompareWithUncached(second, uncached);
+    if (nfirst || nsecond) {
+      AliErrorStream() << "Event " << ievent << ": " << nfirst << " and " << nsecond << " differences to the selection without cache" << std::endl;
+      nfailure++;
+    }
+  }
+  return nfailure == 0;
+}
+
+void TestAliClusterContainer::FillClusters(AliAODEvent &event, const std::vector<double> &energies) const {
+  TClonesArray *clusters = event.GetCaloClusters();
+  clusters->Clear("C");
+  for (size_t i = 0; i < energies.size(); i++) {
+    AliAODCaloCluster *cluster = new ((*clusters)[i]) AliAODCaloCluster();
+    cluster->SetType(AliVCluster::kEMCALClusterv1);
+    cluster->SetE(energies[i]);
+    Float_t position[3] = {static_cast<Float_t>(440. * TMath::Cos(1.5 + 0.1 * i)), static_cast<Float_t>(440. * TMath::Sin(1.5 + 0.1 * i)), 50.};
+    cluster->SetPosition(position);
+  }
+}
+
+int TestAliClusterContainer::CompareWithUncached(const AliClusterContainer &cached, const AliClusterContainer &uncached) const {
+  int ndiff = 0;
+  std::vector<const AliVCluster *> reference, iterated;
+  for (int i = 0; i < uncached.GetNEntries(); i++) {
+    UInt_t reasonCached = 0, reasonUncached = 0;
+    bool accepted = uncached.AcceptCluster(i, reasonUncached);
+    if (cached.IsAccepted(i, reasonCached) != accepted || reasonCached != reasonUncached) ndiff++;
+    if ((cached.GetAcceptCluster(i) != nullptr) != accepted) ndiff++;
+    if (accepted) reference.push_back(uncached.GetCluster(i));
+  }
+  for (auto cluster : cached.accepted()) iterated.push_back(cluster);
+  if (iterated != reference) ndiff++;
+  if (cached.GetNAcceptEntries() != static_cast<Int_t>(reference.size())) ndiff++;
+  return ndiff;
+}
+
+}
+
+}
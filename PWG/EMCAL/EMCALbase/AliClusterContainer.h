@@ -6,9 +6,11 @@
 class TLorentzVector;
 
 class AliVCaloCells;
+class AliAODEvent;
 class AliVEvent;
 
 #include <map>
+#include <vector>
 #include <TArrayI.h>
 #include <AliVCluster.h>
 
@@ -118,7 +120,7 @@ class AliClusterContainer : public AliEmcalContainer {
   static AliEmcalContainerIndexMap <TClonesArray, AliVCluster> fgEmcalContainerIndexMap; //!<! Mapping from containers to indices
 #endif
 
-  AliVCaloCells   *fEMCALCells;                 ///< pointer to EMCAL cells object
+  AliVCaloCells   *fEMCALCells;                 //!<! pointer to EMCAL cells object
   Double_t         fClusTimeCutLow;             ///< low time cut for clusters
   Double_t         fClusTimeCutUp;              ///< up time cut for clusters
   Bool_t           fExoticCut;                  ///< reject clusters marked as "exotic"
@@ -138,7 +140,7 @@ class AliClusterContainer : public AliEmcalContainer {
   AliClusterContainer& operator=(const AliClusterContainer& other); // assignment
 
   /// \cond CLASSIMP
-  ClassDef(AliClusterContainer,12);
+  ClassDef(AliClusterContainer,13);
   /// \endcond
 };
 
@@ -153,5 +155,99 @@ class AliClusterContainer : public AliEmcalContainer {
  */
 int TestClusterContainerIterator(const AliClusterContainer *const cont, int iteratorType = 0, bool verbose = false);
 
+namespace PWG {
+
+namespace EMCAL {
+
+/**
+ * @class TestAliClusterContainer
+ * @brief Unit test for the acceptance cache of AliClusterContainer
+ * @ingroup EMCALCOREFW
+ *
+ * The selection hash decides which containers share the acceptance cache
+ * (see AliEmcalContainer::SetUseAcceptanceCache). Containers connected to
+ * the same event with the same cuts must get the same hash, containers
+ * with different cuts a different one. The cached selection must agree
+ * with AcceptCluster, also after the event changed.
+ */
+class TestAliClusterContainer : public TObject {
+public:
+  /**
+   * @brief Constructor
+   */
+  TestAliClusterContainer() {}
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~TestAliClusterContainer() {}
+
+  /**
+   * @brief Run all tests
+   *
+   * @return true  All tests passed
+   * @return false At least one test failed
+   */
+  bool RunAllTests() const;
+
+  /**
+   * @brief Test the selection hash of containers connected to the same AOD event
+   *
+   * - Two containers with the same cuts have the same hash
+   * - A container with a different cut has a different hash
+   *
+   * @return true  Test passed
+   * @return false Test failed
+   */
+  bool TestSelectionHash() const;
+
+  /**
+   * @brief Test the cached selection against AcceptCluster
+   *
+   * IsAccepted, GetAcceptCluster, GetNAcceptEntries and the accepted iterator of
+   * a container with acceptance cache agree with AcceptCluster of a container without
+   *
+   * @return true  Test passed
+   * @return false Test failed
+   */
+  bool TestCachedAcceptance() const;
+
+  /**
+   * @brief Test the invalidation of the cache when the event changes
+   *
+   * The clusters of the event are replaced by the same number of clusters with a
+   * different selection, as when the next file of the chain is read at the same
+   * entry. The cache built for the first event must not be used for the second.
+   *
+   * @return true  Test passed
+   * @return false Test failed
+   */
+  bool TestCacheInvalidation() const;
+
+private:
+  /**
+   * @brief Replace the clusters of the event by EMCAL clusters with the given energies
+   * @param event AOD event with standard content
+   * @param energies Energies of the clusters
+   */
+  void FillClusters(AliAODEvent &event, const std::vector<double> &energies) const;
+
+  /**
+   * @brief Compare the cached selection of a container with AcceptCluster of a container without cache
+   * @param cached Container with acceptance cache
+   * @param uncached Container with the same cuts, without acceptance cache
+   * @return Number of differences
+   */
+  int CompareWithUncached(const AliClusterContainer &cached, const AliClusterContainer &uncached) const;
+
+  /// \cond CLASSIMP
+  ClassDef(TestAliClusterContainer, 1);
+  /// \endcond
+};
+
+}
+
+}
+
 #endif
 
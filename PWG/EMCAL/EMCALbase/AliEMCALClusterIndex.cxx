@@ -0,0 +1,249 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+
+// ROOT includes
+#include <TMath.h>
+#include <TVector3.h>
+
+// STEER includes
+#include "AliVCluster.h"
+
+// EMCAL includes
+#include "AliEMCALClusterIndex.h"
+
+namespace {
+  const Double_t kEtaEdge   = 0.8;                                // Binned eta range is [-kEtaEdge,kEtaEdge]
+  const Double_t kEtaWidth  = 0.1;                                // Width of the eta cells
+  const Double_t kPhiWidth  = 5*TMath::DegToRad();                // Width of the phi cells
+}
+
+///
+/// Constructor, empty index.
+//_____________________________________________________________________
+AliEMCALClusterIndex::AliEMCALClusterIndex() :
+  fIndex(),     fEta(),        fPhi(),        fR(),
+  fNotBinned(), fCellOffsets(), fCellEntries(),
+  fRMin(1e30),  fRMax(-1e30)
+{
+}
+
+///
+/// Remove all the clusters, to be called before filling a new event.
+//_____________________________________________________________________
+void AliEMCALClusterIndex::Reset()
+{
+  fIndex.clear();
+  fEta.clear();
+  fPhi.clear();
+  fR.clear();
+  fNotBinned.clear();
+  fCellOffsets.clear();
+  fCellEntries.clear();
+  fRMin =  1e30;
+  fRMax = -1e30;
+}
+
+///
+/// Add a cluster to the index. Clusters should be added in increasing index
+/// order, Build() has to be called once all of them are added.
+///
+/// \param index: index of the cluster in the array of the caller, returned by the selections
+/// \param cluster: cluster pointer, null clusters are ignored
+//_____________________________________________________________________
+void AliEMCALClusterIndex::AddCluster(Int_t index, const AliVCluster *cluster)
+{
+  if (!cluster) return;
+
+  Float_t pos[3] = {0.,0.,0.};
+  cluster->GetPosition(pos);
+
+  Double_t eta = 0, phi = 0, r = -1;
+  if (TMath::Finite(pos[0]) && TMath::Finite(pos[1]) && TMath::Finite(pos[2]))
+  {
+    TVector3 cpos(pos);
+    if (cpos.Perp() > 0)
+    {
+      eta = cpos.Eta();
+      phi = cpos.Phi();
+      if (phi < 0) phi += TMath::TwoPi();
+      if (TMath::Abs(eta) < kEtaEdge) r = cpos.Perp();
+    }
+  }
+
+  fIndex.push_back(index);
+  fEta  .push_back(eta);
+  fPhi  .push_back(phi);
+  fR    .push_back(r);
+}
+
+///
+/// Bin the added clusters by eta-phi cell. Clusters with a non finite
+/// position or outside the binned eta range are kept apart and returned
+/// by every selection.
+//_____________________________________________________________________
+void AliEMCALClusterIndex::Build()
+{
+  const Int_t nCells = kNEtaCells*kNPhiCells;
+  const Int_t nClusters = fIndex.size();
+
+  fNotBinned.clear();
+  fCellOffsets.assign(nCells+1, 0);
+  fCellEntries.clear();
+  fRMin =  1e30;
+  fRMax = -1e30;
+
+  std::vector<Int_t> cells(nClusters, -1);
+  for (Int_t i = 0; i < nClusters; i++)
+  {
+    if (fR[i] < 0)
+    {
+      fNotBinned.push_back(fIndex[i]);
+      continue;
+    }
+
+    Int_t ieta = TMath::Min(kNEtaCells-1, Int_t((fEta[i] + kEtaEdge)/kEtaWidth));
+    Int_t iphi = TMath::Min(kNPhiCells-1, Int_t(fPhi[i]/kPhiWidth));
+    cells[i] = ieta*kNPhiCells + iphi;
+    fCellOffsets[cells[i]+1]++;
+
+    fRMin = TMath::Min(fRMin, fR[i]);
+    fRMax = TMath::Max(fRMax, fR[i]);
+  }
+
+  for (Int_t ic = 0; ic < nCells; ic++) fCellOffsets[ic+1] += fCellOffsets[ic];
+
+  // Entries of each cell keep the order in which the clusters were added
+  fCellEntries.resize(fCellOffsets[nCells]);
+  std::vector<Int_t> next(fCellOffsets.begin(), fCellOffsets.end()-1);
+  for (Int_t i = 0; i < nClusters; i++)
+  {
+    if (cells[i] >= 0) fCellEntries[next[cells[i]]++] = fIndex[i];
+  }
+}
+
+///
+/// Select the clusters that can be within a 3D distance of a point,
+/// typically the track extrapolated to the EMCal surface.
+///
+/// \param pos: global position of the point
+/// \param window: maximum distance between the point and the cluster position
+/// \param clusters: selected cluster indices, in increasing order
+//_____________________________________________________________________
+void AliEMCALClusterIndex::FindClustersNear(const Double_t pos[3], Double_t window, std::vector<Int_t> &clusters) const
+{
+  if (!TMath::Finite(pos[0]) || !TMath::Finite(pos[1]) || !TMath::Finite(pos[2]) || !TMath::Finite(window))
+  {
+    GetAllClusters(clusters);
+    return;
+  }
+
+  if (window < 0 || fRMin > fRMax)
+  {
+    clusters.assign(fNotBinned.begin(), fNotBinned.end());
+    return;
+  }
+
+  // The transverse distance is larger than 2 sqrt(r1 r2) sin(dphi/2)
+  const Double_t rt = TMath::Sqrt(pos[0]*pos[0] + pos[1]*pos[1]);
+  Double_t dPhi = TMath::Pi();
+  if (rt > 0 && window < 2*TMath::Sqrt(rt*fRMin))
+    dPhi = 2*TMath::ASin(window/(2*TMath::Sqrt(rt*fRMin)));
+
+  // Eta range of the positions with |z-zt| < window and fRMin < r < fRMax
+  const Double_t zLow  = pos[2] - window;
+  const Double_t zHigh = pos[2] + window;
+  const Double_t etaMin = TMath::ASinH(zLow  / (zLow  >= 0 ? fRMax : fRMin));
+  const Double_t etaMax = TMath::ASinH(zHigh / (zHigh >= 0 ? fRMin : fRMax));
+
+  FindClustersInCells(etaMin, etaMax, TMath::ATan2(pos[1], pos[0]), dPhi, clusters);
+}
+
+///
+/// Select the clusters whose position can be within an eta-phi window.
+///
+/// \param eta: eta of the window center
+/// \param phi: phi of the window center
+/// \param dEta: half width of the window in eta
+/// \param dPhi: half width of the window in phi
+/// \param clusters: selected cluster indices, in increasing order
+//_____________________________________________________________________
+void AliEMCALClusterIndex::FindClustersInEtaPhi(Double_t eta, Double_t phi, Double_t dEta, Double_t dPhi, std::vector<Int_t> &clusters) const
+{
+  if (!TMath::Finite(eta) || !TMath::Finite(phi) || !TMath::Finite(dEta) || !TMath::Finite(dPhi))
+  {
+    GetAllClusters(clusters);
+    return;
+  }
+
+  dEta = TMath::Abs(dEta);
+  dPhi = TMath::Abs(dPhi);
+  FindClustersInCells(eta - dEta, eta + dEta, phi, dPhi, clusters);
+}
+
+///
+/// Collect the clusters of the cells overlapping the eta range and the phi
+/// window, with one cell of margin on each side, plus the not binned ones.
+//_____________________________________________________________________
+void AliEMCALClusterIndex::FindClustersInCells(Double_t etaMin, Double_t etaMax, Double_t phi, Double_t dPhi, std::vector<Int_t> &clusters) const
+{
+  clusters.assign(fNotBinned.begin(), fNotBinned.end());
+  if (fCellOffsets.empty()) return;
+
+  const Double_t etaCellMin = TMath::Floor((etaMin + kEtaEdge)/kEtaWidth) - 1;
+  const Double_t etaCellMax = TMath::Floor((etaMax + kEtaEdge)/kEtaWidth) + 1;
+  if (etaCellMax < 0 || etaCellMin > kNEtaCells-1) return;
+  const Int_t ietaMin = Int_t(TMath::Max(etaCellMin, 0.));
+  const Int_t ietaMax = Int_t(TMath::Min(etaCellMax, kNEtaCells-1.));
+
+  Int_t iphiMin = 0, nPhiCells = kNPhiCells;
+  if (dPhi < TMath::Pi())
+  {
+    phi = std::fmod(phi, TMath::TwoPi());
+    if (phi < 0) phi += TMath::TwoPi();
+    const Int_t phiCellMin = Int_t(TMath::Floor((phi - dPhi)/kPhiWidth)) - 1;
+    const Int_t phiCellMax = Int_t(TMath::Floor((phi + dPhi)/kPhiWidth)) + 1;
+    if (phiCellMax - phiCellMin + 1 < kNPhiCells)
+    {
+      iphiMin   = phiCellMin;
+      nPhiCells = phiCellMax - phiCellMin + 1;
+    }
+  }
+
+  for (Int_t ieta = ietaMin; ieta <= ietaMax; ieta++)
+  {
+    for (Int_t jphi = 0; jphi < nPhiCells; jphi++)
+    {
+      const Int_t iphi = ((iphiMin + jphi) % kNPhiCells + kNPhiCells) % kNPhiCells;
+      const Int_t cell = ieta*kNPhiCells + iphi;
+      clusters.insert(clusters.end(), fCellEntries.begin() + fCellOffsets[cell], fCellEntries.begin() + fCellOffsets[cell+1]);
+    }
+  }
+
+  // Same order as the loop over the full array
+  std::sort(clusters.begin(), clusters.end());
+}
+
+///
+/// All the clusters added to the index, in increasing order.
+//_____________________________________________________________________
+void AliEMCALClusterIndex::GetAllClusters(std::vector<Int_t> &clusters) const
+{
+  clusters.assign(fIndex.begin(), fIndex.end());
+  std::sort(clusters.begin(), clusters.end());
+}
@@ -0,0 +1,64 @@
+#ifndef ALIEMCALCLUSTERINDEX_H
+#define ALIEMCALCLUSTERINDEX_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <vector>
+#include <Rtypes.h>
+
+class AliVCluster;
+
+///
+/// \class AliEMCALClusterIndex
+/// \ingroup EMCALbase
+/// \brief Eta-phi index of the cluster positions, for the track-cluster matching
+///
+/// The clusters of one event are binned by the eta and phi of their position
+/// on the EMCal/DCal surface. The phi cells are 5 degrees wide, four per
+/// 20 degrees supermodule sector, and the eta cells are 0.1 wide, eight per
+/// side, such that each cell lies in a single supermodule. A track is then
+/// only compared with the clusters in the cells around its position instead
+/// of with all the clusters of the event.
+///
+/// The selections are conservative: all the clusters that can pass the
+/// matching window are returned, together with the clusters outside the
+/// binned acceptance or with a non finite position. The returned indices
+/// are in increasing order, so the matching visits the clusters in the same
+/// order as the loop over the full array.
+///
+//_________________________________________________________________________
+class AliEMCALClusterIndex
+{
+public:
+  AliEMCALClusterIndex();
+  ~AliEMCALClusterIndex() {}
+
+  void     Reset();
+  void     AddCluster(Int_t index, const AliVCluster *cluster);
+  void     Build();
+
+  Int_t    GetNClusters()                        const { return fIndex.size(); }
+
+  void     FindClustersNear(const Double_t pos[3], Double_t window, std::vector<Int_t> &clusters) const;
+  void     FindClustersInEtaPhi(Double_t eta, Double_t phi, Double_t dEta, Double_t dPhi, std::vector<Int_t> &clusters) const;
+
+private:
+  void     FindClustersInCells(Double_t etaMin, Double_t etaMax, Double_t phi, Double_t dPhi, std::vector<Int_t> &clusters) const;
+  void     GetAllClusters(std::vector<Int_t> &clusters) const;
+
+  static const Int_t kNEtaCells = 16;    ///< Eta cells in [-0.8,0.8]
+  static const Int_t kNPhiCells = 72;    ///< Phi cells in [0,2pi]
+
+  std::vector<Int_t>    fIndex;          ///< Index in the caller array of the added clusters
+  std::vector<Double_t> fEta;            ///< Eta of the cluster position
+  std::vector<Double_t> fPhi;            ///< Phi of the cluster position, in [0,2pi)
+  std::vector<Double_t> fR;              ///< Transverse radius of the cluster position, <0 if not binned
+
+  std::vector<Int_t>    fNotBinned;      ///< Clusters returned by every selection
+  std::vector<Int_t>    fCellOffsets;    ///< Clusters of cell c are fCellEntries[fCellOffsets[c]..fCellOffsets[c+1])
+  std::vector<Int_t>    fCellEntries;    ///< Caller indices, grouped by cell
+  Double_t              fRMin;           ///< Smallest transverse radius of the binned clusters
+  Double_t              fRMax;           ///< Largest transverse radius of the binned clusters
+};
+
+#endif //ALIEMCALCLUSTERINDEX_H
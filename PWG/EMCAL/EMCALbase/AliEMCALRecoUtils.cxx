@@ -74,6 +74,8 @@ AliEMCALRecoUtils::AliEMCALRecoUtils():
   fStepSurface(0),                        fStepCluster(0),
   fITSTrackSA(kFALSE),                    fUseTrackDCA(kTRUE), // keep it active, but not working for old MC
   fUseOuterTrackParam(kFALSE),            fEMCalSurfaceDistance(440.),
+  fUseClusterIndex(kFALSE),               fClusterIndex(),                        fClusterIndexArray(0x0),
+  fClusterIndexCandidates(),
   fTrackCutsType(0),                      fCutMinTrackPt(0),                      fCutMinNClusterTPC(0),
   fCutMinNClusterITS(0),                  fCutMaxChi2PerClusterTPC(0),            fCutMaxChi2PerClusterITS(0),
   fCutRequireTPCRefit(kFALSE),            fCutRequireITSRefit(kFALSE),            fCutAcceptKinkDaughters(kFALSE),
@@ -138,6 +140,8 @@ AliEMCALRecoUtils::AliEMCALRecoUtils(const AliEMCALRecoUtils & reco)
   fMass(reco.fMass),        fStepSurface(reco.fStepSurface), fStepCluster(reco.fStepCluster),
   fITSTrackSA(reco.fITSTrackSA),                             fUseTrackDCA(reco.fUseTrackDCA),
   fUseOuterTrackParam(reco.fUseOuterTrackParam),             fEMCalSurfaceDistance(440.),
+  fUseClusterIndex(reco.fUseClusterIndex),                   fClusterIndex(),
+  fClusterIndexArray(0x0),                                   fClusterIndexCandidates(),
   fTrackCutsType(reco.fTrackCutsType),                       fCutMinTrackPt(reco.fCutMinTrackPt),
   fCutMinNClusterTPC(reco.fCutMinNClusterTPC),               fCutMinNClusterITS(reco.fCutMinNClusterITS),
   fCutMaxChi2PerClusterTPC(reco.fCutMaxChi2PerClusterTPC),   fCutMaxChi2PerClusterITS(reco.fCutMaxChi2PerClusterITS),
@@ -259,6 +263,7 @@ AliEMCALRecoUtils & AliEMCALRecoUtils::operator = (const AliEMCALRecoUtils & rec
   fUseTrackDCA               = reco.fUseTrackDCA;
   fUseOuterTrackParam        = reco.fUseOuterTrackParam;
   fEMCalSurfaceDistance      = reco.fEMCalSurfaceDistance;
+  fUseClusterIndex           = reco.fUseClusterIndex;
 
   fTrackCutsType             = reco.fTrackCutsType;
   fCutMinTrackPt             = reco.fCutMinTrackPt;
@@ -3221,6 +3226,20 @@ void AliEMCALRecoUtils::FindMatches(AliVEvent *event,
     }
   }
 
+  // Index the clusters once, it is used for all the tracks of the event
+  if (fUseClusterIndex)
+  {
+    fClusterIndexArray = clusterArr ? clusterArr : clusterArray;
+    fClusterIndex.Reset();
+    for (Int_t icl=0; icl<fClusterIndexArray->GetEntriesFast(); icl++)
+    {
+      AliVCluster *cluster = dynamic_cast<AliVCluster*> (fClusterIndexArray->At(icl));
+      if (!cluster || !cluster->IsEMCAL()) continue;
+      fClusterIndex.AddCluster(icl,cluster);
+    }
+    fClusterIndex.Build();
+  }
+
   Int_t    matched=0;
   Double_t cv[21];
   TString  genName;
@@ -3317,6 +3336,7 @@ void AliEMCALRecoUtils::FindMatches(AliVEvent *event,
     else
     {
       AliWarning("Wrong input data type! Should be \"AOD\" or \"ESD\" ");
+      fClusterIndexArray = 0x0;
       if (clusterArray)
       {
         clusterArray->Clear();
@@ -3390,6 +3410,8 @@ void AliEMCALRecoUtils::FindMatches(AliVEvent *event,
     if (fITSTrackSA && trackParam) delete trackParam;
   }//track loop
 
+  fClusterIndexArray = 0x0;
+
   if (clusterArray)
   {
     clusterArray->Clear();
@@ -3508,9 +3530,15 @@ Int_t  AliEMCALRecoUtils::FindMatchedClusterInClusterArr(const AliExternalTrackP
   Double_t exPos[3] = {0.,0.,0.};
   if (!emcalParam->GetXYZ(exPos)) return index;
 
+  // Only the clusters of the cells around the track if the array is indexed
+  const Bool_t useIndex = fClusterIndexArray && fClusterIndexArray == clusterArr;
+  if (useIndex) fClusterIndex.FindClustersNear(exPos, fClusterWindow, fClusterIndexCandidates);
+  const Int_t nClusters = useIndex ? (Int_t) fClusterIndexCandidates.size() : clusterArr->GetEntriesFast();
+
   Float_t clsPos[3] = {0.,0.,0.};
-  for (Int_t icl=0; icl<clusterArr->GetEntriesFast(); icl++)
+  for (Int_t icand=0; icand<nClusters; icand++)
   {
+    Int_t icl = useIndex ? fClusterIndexCandidates[icand] : icand;
     AliVCluster *cluster = dynamic_cast<AliVCluster*> (clusterArr->At(icl)) ;
 
     if (!cluster || !cluster->IsEMCAL()) continue;
@@ -4410,6 +4438,7 @@ void AliEMCALRecoUtils::Print(const Option_t *) const
 
   printf("\tMass hypothesis = %2.3f [GeV/c^2], extrapolation step to surface = %2.2f[cm], step to cluster = %2.2f[cm]\n",fMass,fStepSurface, fStepCluster);
   printf("\tCluster selection window: dR < %2.0f\n",fClusterWindow);
+  printf("\tCluster eta-phi index in FindMatches: %d\n",fUseClusterIndex);
 
   printf("\tTrack cuts: \n");
   printf("\t\tMinimum track pT: %1.2f\n",fCutMinTrackPt);
@@ -31,6 +31,9 @@
 ///
 ///////////////////////////////////////////////////////////////////////////////
 
+// C++ includes
+#include <vector>
+
 // Root includes
 #include <TArray.h>
 #include <TArrayL64.h>
@@ -53,6 +56,7 @@ class AliMCEvent;
 
 // EMCAL includes
 #include "AliEMCALRecoUtilsBase.h"
+#include "AliEMCALClusterIndex.h"
 class AliEMCALGeometry;
 class AliEMCALPIDUtils;
 class AliESDtrack;
@@ -425,6 +429,9 @@ public:
   void     SetITSTrackSA(Bool_t isITS)                { fITSTrackSA = isITS           ; } //Special Handle of AliExternTrackParam    
   void     SwitchOnOuterTrackParam()                  { fUseOuterTrackParam = kTRUE   ; } 
   void     SwitchOffOuterTrackParam()                 { fUseOuterTrackParam = kFALSE  ; } 
+  void     SwitchOnClusterIndex()                     { fUseClusterIndex = kTRUE      ; }
+  void     SwitchOffClusterIndex()                    { fUseClusterIndex = kFALSE     ; }
+  Bool_t   IsClusterIndexUsed()                 const { return fUseClusterIndex       ; }
   
   
   // Track Cuts 
@@ -628,6 +635,11 @@ private:
   Bool_t     fUseTrackDCA;               ///< Activate use of aodtrack->GetXYZ or XvYxZv like in AliEMCALRecoUtilsBase::ExtrapolateTrackToEMCalSurface 
   Bool_t     fUseOuterTrackParam;        ///< Use OuterTrackParam not InnerTrackParam, ESDs
   Double_t   fEMCalSurfaceDistance;      ///< EMCal surface distance (= 430 by default, the last 10 cm are propagated on a cluster-track pair basis)
+  Bool_t     fUseClusterIndex;           ///< In FindMatches, compare each track only with the clusters of the eta-phi cells around it
+
+  AliEMCALClusterIndex fClusterIndex;            //!<! Eta-phi index of the clusters of the event, filled in FindMatches
+  const TObjArray     *fClusterIndexArray;       //!<! Cluster array indexed in fClusterIndex, null if none
+  std::vector<Int_t>   fClusterIndexCandidates;  //!<! Clusters selected in the index for the current track
  
   // Track cuts  
   Int_t      fTrackCutsType;             ///< ESD track cuts type for matching, see enum TrackCutsType
@@ -651,7 +663,7 @@ private:
   Bool_t     fMCGenerToAcceptForTrack;   ///<  Activate the removal of tracks entering the track matching that come from a particular generator
   
   /// \cond CLASSIMP
-  ClassDef(AliEMCALRecoUtils, 35) ;
+  ClassDef(AliEMCALRecoUtils, 36) ;
   /// \endcond
 
 };
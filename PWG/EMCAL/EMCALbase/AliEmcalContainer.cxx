@@ -24,7 +24,14 @@
  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
  ************************************************************************************/
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <utility>
+#include <TClass.h>
 #include <TClonesArray.h>
+#include <TDataMember.h>
+#include <TRealData.h>
 #include "AliVEvent.h"
 #include "AliLog.h"
 #include "AliNamedArrayI.h"
@@ -37,6 +44,21 @@
 
 ClassImp(AliEmcalContainer);
 
+namespace {
+  /// Acceptance caches shared by the containers, by input array and selection hash
+  std::map<std::pair<const TClonesArray*, ULong64_t>, AliEmcalContainer::AcceptanceCache> gAcceptanceCaches;
+
+  /// FNV-1a hash of a block of bytes
+  void AddToHash(ULong64_t &hash, const void *data, size_t n)
+  {
+    const unsigned char *bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < n; i++) {
+      hash ^= bytes[i];
+      hash *= 1099511628211ULL;
+    }
+  }
+}
+
 AliEmcalContainer::AliEmcalContainer():
   TObject(),
   fName(),
@@ -56,10 +78,13 @@ AliEmcalContainer::AliEmcalContainer():
   fMaxMCLabel(-1),
   fMassHypothesis(-1),
   fIsEmbedding(kFALSE),
+  fUseAcceptanceCache(kFALSE),
   fClArray(0),
   fCurrentID(0),
   fLabelMap(0),
   fLoadedClass(0),
+  fEventSerial(-1),
+  fAcceptanceCache(0),
   fClassName()
 {
   fVertex[0] = 0;
@@ -86,10 +111,13 @@ AliEmcalContainer::AliEmcalContainer(const char *name):
   fMaxMCLabel(-1),
   fMassHypothesis(-1),
   fIsEmbedding(kFALSE),
+  fUseAcceptanceCache(kFALSE),
   fClArray(0),
   fCurrentID(0),
   fLabelMap(0),
   fLoadedClass(0),
+  fEventSerial(-1),
+  fAcceptanceCache(0),
   fClassName()
 {
   fVertex[0] = 0;
@@ -169,6 +197,11 @@ void AliEmcalContainer::NextEvent(const AliVEvent * event)
 
 Int_t AliEmcalContainer::GetNAcceptEntries() const{
   Int_t result = 0;
+  const AcceptanceCache *cache = GetAcceptanceCache();
+  if (cache) {
+    for (auto word : cache->fMask) result += __builtin_popcountll(word);
+    return result;
+  }
   for(int index = 0; index < GetNEntries(); index++){
     UInt_t rejectionReason = 0;
     if(AcceptObject(index, rejectionReason)) result++;
@@ -176,6 +209,80 @@ Int_t AliEmcalContainer::GetNAcceptEntries() const{
   return result;
 }
 
+Bool_t AliEmcalContainer::IsAccepted(Int_t i, UInt_t &rejectionReason) const
+{
+  const AcceptanceCache *cache = GetAcceptanceCache();
+  if (!cache || i < 0 || i >= cache->fNEntries) return AcceptObject(i, rejectionReason);
+
+  rejectionReason |= cache->fRejectionReason[i];
+  return cache->IsAccepted(i);
+}
+
+const AliEmcalContainer::AcceptanceCache *AliEmcalContainer::GetAcceptanceCache() const
+{
+  if (!fUseAcceptanceCache || fEventSerial < 0 || !fClArray) return 0;
+
+  const Int_t n = GetNEntries();
+  if (fAcceptanceCache && fAcceptanceCache->fEventSerial == fEventSerial && fAcceptanceCache->fNEntries == n) return fAcceptanceCache;
+
+  AcceptanceCache &cache = gAcceptanceCaches[std::make_pair(static_cast<const TClonesArray*>(fClArray), GetSelectionHash())];
+  if (cache.fEventSerial != fEventSerial || cache.fNEntries != n) {
+    // First container with this selection in this event
+    cache.fMask.assign((n + 63) / 64, 0);
+    cache.fRejectionReason.assign(n, 0);
+    for (Int_t i = 0; i < n; i++) {
+      UInt_t rejectionReason = 0;
+      if (AcceptObject(i, rejectionReason)) cache.fMask[i >> 6] |= 1ULL << (i & 63);
+      cache.fRejectionReason[i] = rejectionReason;
+    }
+    cache.fEventSerial = fEventSerial;
+    cache.fNEntries = n;
+    AliDebugStream(2) << GetName() << ": Built acceptance cache for event " << fEventSerial << " (" << n << " objects)" << std::endl;
+  }
+  fAcceptanceCache = &cache;
+  return fAcceptanceCache;
+}
+
+ULong64_t AliEmcalContainer::GetSelectionHash() const
+{
+  ULong64_t hash = 14695981039346656037ULL;
+
+  TClass *cls = IsA();
+  AddToHash(hash, cls->GetName(), strlen(cls->GetName()));
+
+  cls->BuildRealData(const_cast<AliEmcalContainer*>(this));
+  TIter next(cls->GetListOfRealData());
+  TRealData *rd = 0;
+  while ((rd = static_cast<TRealData*>(next()))) {
+    TDataMember *dm = rd->GetDataMember();
+    if (!dm || !dm->IsPersistent()) continue;
+    if (strchr(rd->GetName(), '.')) continue;          // members of embedded objects, handled with the object
+    if (dm->GetClass() == TObject::Class()) continue;  // unique ID and status bits
+    if (!strcmp(dm->GetName(), "fName")) continue;     // the name does not select anything
+
+    AddToHash(hash, dm->GetName(), strlen(dm->GetName()));
+    const char *address = reinterpret_cast<const char*>(this) + rd->GetThisOffset();
+    if (!dm->IsaPointer() && (dm->IsBasic() || dm->IsEnum())) {
+      Long_t size = dm->GetUnitSize();
+      for (Int_t idim = 0; idim < dm->GetArrayDim(); idim++) size *= dm->GetMaxIndex(idim);
+      AddToHash(hash, address, size);
+    }
+    else if (!dm->IsaPointer() && !strcmp(dm->GetTypeName(), "TString")) {
+      const TString &str = *reinterpret_cast<const TString*>(address);
+      AddToHash(hash, str.Data(), str.Length());
+    }
+    else if (dm->IsaPointer() && dm->GetArrayDim() == 0 && !*reinterpret_cast<void* const*>(address)) {
+      AddToHash(hash, "null", 4);
+    }
+    else {
+      // Cannot be compared by value: the selection is not shared with other containers
+      const AliEmcalContainer *self = this;
+      AddToHash(hash, &self, sizeof(self));
+    }
+  }
+  return hash;
+}
+
 Int_t AliEmcalContainer::GetIndexFromLabel(Int_t lab) const
 { 
   if (fLabelMap) {
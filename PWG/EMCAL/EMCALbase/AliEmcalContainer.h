@@ -37,6 +37,9 @@ class AliVEvent;
 class AliNamedArrayI;
 class AliVParticle;
 
+namespace PWG { namespace EMCAL { class TestAliClusterContainer; } }
+
+#include <vector>
 #include <TNamed.h>
 #include <TClonesArray.h>
 
@@ -96,6 +99,10 @@ typedef EMCALIterableContainer::AliEmcalIterableContainerT<TObject, EMCALIterabl
  * }
  * ~~~
  *
+ * When many tasks in the same train use containers with identical selections on the
+ * same input array, the selection can be evaluated once per event and shared between them
+ * (see SetUseAcceptanceCache). The accepted iterators then only visit the accepted entries.
+ *
  * The usage of EMCAL containers is described under \subpage EMCALcontainers
  */
 class AliEmcalContainer : public TObject {
@@ -144,6 +151,28 @@ class AliEmcalContainer : public TObject {
     kOverlapTpcHole = 1<<29             ///<Cut  on the regions of acceptance with bad sectors 
   };
 
+  /**
+   * @struct AcceptanceCache
+   * @brief Result of the selection of all objects in the input array for one event
+   *
+   * Shared by all containers connected to the same array with the same selection.
+   */
+  struct AcceptanceCache {
+    AcceptanceCache(): fEventSerial(-1), fNEntries(0), fMask(), fRejectionReason() {}
+
+    /**
+     * @brief Check whether the object at a given index is accepted
+     * @param[in] i Index of the object (must be in range)
+     * @return True if the object is accepted
+     */
+    Bool_t IsAccepted(Int_t i) const { return (fMask[i >> 6] >> (i & 63)) & 1; }
+
+    Long64_t                  fEventSerial;         ///< Serial number of the event the cache was built for
+    Int_t                     fNEntries;            ///< Number of objects in the array
+    std::vector<ULong64_t>    fMask;                ///< Acceptance bits, packed by 64
+    std::vector<UInt_t>       fRejectionReason;     ///< Rejection reason bitmap of each object
+  };
+
   /**
    * @brief Default constructor. 
    * 
@@ -229,6 +258,26 @@ class AliEmcalContainer : public TObject {
    */
   Int_t                       GetNAcceptEntries() const;
 
+  /**
+   * @brief Selection of the object at a given index
+   *
+   * Same as AcceptObject, but taken from the acceptance cache of the current
+   * event if the cache is enabled.
+   * @param[in] i Index of the object
+   * @param[out] rejectionReason Bitmap for reason why object is rejected
+   * @return True if the object is accepted, false otherwise
+   */
+  Bool_t                      IsAccepted(Int_t i, UInt_t &rejectionReason) const;
+
+  /**
+   * @brief Get the acceptance cache of the current event
+   *
+   * The cache is built with AcceptObject by the first container with this selection
+   * asking for it in the event.
+   * @return Acceptance cache (NULL if the cache is disabled or the event serial number is unknown)
+   */
+  const AcceptanceCache      *GetAcceptanceCache() const;
+
   /**
    * @brief Reset the iterator to a given index
    * 
@@ -250,6 +299,27 @@ class AliEmcalContainer : public TObject {
   void                        SetVertex(Double_t *vtx)              { memcpy(fVertex, vtx, sizeof(Double_t) * 3); }
   void                        SetBitMap(UInt_t m)                   { fBitMap = m                       ; }
   void                        SetIsParticleLevel(Bool_t b)          { fIsParticleLevel = b              ; }
+
+  /**
+   * @brief Share the selection results with other containers
+   *
+   * If enabled, the selection of all objects is evaluated once per event for all
+   * containers with the same selection connected to the same array (see GetSelectionHash),
+   * and reused by all of them. Only to be used if the objects are not modified by other
+   * tasks after the first container with this selection has been used in the event.
+   * @param[in] b If true the acceptance cache is used
+   */
+  void                        SetUseAcceptanceCache(Bool_t b = kTRUE) { fUseAcceptanceCache = b         ; }
+  Bool_t                      GetUseAcceptanceCache()         const { return fUseAcceptanceCache        ; }
+
+  /**
+   * @brief Set the serial number of the current event, identifying the event for the acceptance cache
+   *
+   * Has to be different for every event processed by the train, e.g. AliAnalysisManager::GetNcalls().
+   * The entry in the input tree is not enough: it starts again from 0 in every file of the chain.
+   * @param[in] serial Serial number of the current event (-1 if unknown: no acceptance cache)
+   */
+  void                        SetEventSerial(Long64_t serial)       { fEventSerial = serial             ; }
   void                        SortArray()                           { fClArray->Sort()                  ; }
 
   TClass*                     GetLoadedClass()                      { return fLoadedClass               ; }
@@ -372,6 +442,16 @@ class AliEmcalContainer : public TObject {
    */
   void                        GetVertexFromEvent(const AliVEvent * event);
 
+  /**
+   * @brief Hash of the selection applied by the container
+   *
+   * Built from the class name and the values of all persistent data members
+   * except the name. Members which cannot be compared by value (non-null pointers,
+   * STL containers) make the hash unique to this container.
+   * @return Hash of the selection
+   */
+  ULong64_t                   GetSelectionHash() const;
+
   TString                     fName;                    ///< object name
   TString                     fClArrayName;             ///< name of branch
   TString                     fBaseClassName;           ///< name of the base class that this container can handle
@@ -389,11 +469,14 @@ class AliEmcalContainer : public TObject {
   Int_t                       fMaxMCLabel;              ///< maximum MC label
   Double_t                    fMassHypothesis;          ///< if < 0 it will use a PID mass when available
   Bool_t                      fIsEmbedding;             ///< if true, this container will connect to an external event
+  Bool_t                      fUseAcceptanceCache;      ///< if true, the selection results are shared per event with containers with the same selection
   TClonesArray               *fClArray;                 //!<! Pointer to array in input event
   Int_t                       fCurrentID;               //!<! current ID for automatic loops
   AliNamedArrayI             *fLabelMap;                //!<! Label-Index map
   Double_t                    fVertex[3];               //!<! event vertex array
   TClass                     *fLoadedClass;             //!<! Class of the objects contained in the TClonesArray
+  Long64_t                    fEventSerial;             //!<! Serial number of the current event in the train (-1 if unknown)
+  mutable const AcceptanceCache *fAcceptanceCache;      //!<! Acceptance cache of the current event
 
  private:
   TString                     fClassName;               ///< name of the class in the TClonesArray
@@ -401,6 +484,8 @@ class AliEmcalContainer : public TObject {
   AliEmcalContainer(const AliEmcalContainer& obj); // copy constructor
   AliEmcalContainer& operator=(const AliEmcalContainer& other); // assignment
 
-  ClassDef(AliEmcalContainer,9);
+  friend class PWG::EMCAL::TestAliClusterContainer;
+
+  ClassDef(AliEmcalContainer,10);
 };
 #endif
@@ -329,12 +329,25 @@ T *AliEmcalIterableContainerT<T, STAR>::operator[](int index) const {
 /**
  * Build list of accepted indices inside the container.
  * For this all objects inside the container are checked
- * for being accepted or not.
+ * for being accepted or not. If the container uses the
+ * acceptance cache, only the set bits of the cached
+ * acceptance mask are visited.
  */
 template <typename T, typename STAR>
 void AliEmcalIterableContainerT<T, STAR>::BuildAcceptIndices(){
   fAcceptIndices.Set(fkContainer->GetNAcceptEntries());
   int acceptCounter = 0;
+  const AliEmcalContainer::AcceptanceCache *cache = fkContainer->GetAcceptanceCache();
+  if (cache) {
+    for(int iword = 0; iword < (int)cache->fMask.size(); iword++){
+      ULong64_t word = cache->fMask[iword];
+      while (word) {
+        fAcceptIndices[acceptCounter++] = iword * 64 + __builtin_ctzll(word);
+        word &= word - 1;
+      }
+    }
+    return;
+  }
   for(int index = 0; index < fkContainer->GetNEntries(); index++){
     UInt_t rejectionReason = 0;
     if(fkContainer->AcceptObject(index, rejectionReason)) fAcceptIndices[acceptCounter++] = index;
@@ -270,7 +270,7 @@ AliVTrack* AliTrackContainer::GetAcceptTrack(Int_t i) const
 {
   UInt_t rejectionReason;
   if (i == -1) i = fCurrentID;
-  if (AcceptTrack(i, rejectionReason)) {
+  if (IsAccepted(i, rejectionReason)) {
       return GetTrack(i);
   }
   else {
@@ -52,5 +52,6 @@
 #pragma link C++ class PWG::EMCAL::TestAliEmcalTrackSelResultPtr+;
 #pragma link C++ class PWG::EMCAL::TestAliEmcalAODHybridTrackCuts+;
 #pragma link C++ class PWG::EMCAL::TestAliEmcalTrackSelectionAOD+;
+#pragma link C++ class PWG::EMCAL::TestAliClusterContainer+;
 #pragma link C++ class std::vector<PWG::EMCAL::AliEmcalTrackSelResultPtr>+;
 #endif
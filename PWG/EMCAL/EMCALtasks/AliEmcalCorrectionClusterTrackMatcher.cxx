@@ -38,8 +38,11 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
   fUseOuterParamInESDs(kFALSE),
   fUpdateTracks(kTRUE),
   fUpdateClusters(kTRUE),
+  fUseClusterIndex(kFALSE),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap(),
+  fClusterIndex(),
+  fClusterCandidates(),
   fEmcalTracks(0),
   fEmcalClusters(0),
   fNEmcalTracks(0),
@@ -82,6 +85,7 @@ Bool_t AliEmcalCorrectionClusterTrackMatcher::Initialize()
   GetProperty("maxDist", fMaxDistance);
   GetProperty("updateClusters", fUpdateClusters);
   GetProperty("updateTracks", fUpdateTracks);
+  GetProperty("useClusterIndex", fUseClusterIndex);
   fDoPropagation = fEsdMode;
   
   Bool_t enableFracEMCRecalc = kFALSE;
@@ -370,11 +374,28 @@ void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
 {
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
 
+  // Index the clusters once, it is used for all the tracks
+  if (fUseClusterIndex) {
+    fClusterIndex.Reset();
+    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+      AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
+      fClusterIndex.AddCluster(icluster, emcalCluster->GetCluster());
+    }
+    fClusterIndex.Build();
+  }
+
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
     AliVTrack* track = emcalTrack->GetTrack();
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    // Only the clusters in the eta-phi window around the track, in increasing index order
+    if (fUseClusterIndex) {
+      fClusterIndex.FindClustersInEtaPhi(track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), fMaxDistance, fMaxDistance, fClusterCandidates);
+    }
+    const Int_t nClusters = fUseClusterIndex ? (Int_t) fClusterCandidates.size() : fNEmcalClusters;
+
+    for (Int_t icandidate = 0; icandidate < nClusters; icandidate++) {
+      Int_t icluster = fUseClusterIndex ? fClusterCandidates[icandidate] : icandidate;
       AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
       AliVCluster* cluster = emcalCluster->GetCluster();
       
@@ -4,7 +4,9 @@
 #include "AliEmcalCorrectionComponent.h"
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
+#include <vector>
 #include "AliEmcalContainerIndexMap.h"
+#include "AliEMCALClusterIndex.h"
 #endif
 
 class TH1;
@@ -88,11 +90,14 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   Bool_t        fUseOuterParamInESDs;   ///< Use TPC outer parameters instead of inner parameters for track propagation, ESDs only
   Bool_t        fUpdateTracks;          ///< update tracks with matching info
   Bool_t        fUpdateClusters;        ///< update clusters with matching info
+  Bool_t        fUseClusterIndex;       ///< compare each track only with the clusters in the eta-phi cells around it
   
 #if !(defined(__CINT__) || defined(__MAKECINT__))
   // Handle mapping between index and containers
   AliEmcalContainerIndexMap <AliClusterContainer, AliVCluster> fClusterContainerIndexMap;    //!<! Mapping between index and cluster containers
   AliEmcalContainerIndexMap <AliParticleContainer, AliVParticle> fParticleContainerIndexMap; //!<! Mapping between index and particle containers
+  AliEMCALClusterIndex fClusterIndex;                                                        //!<! Eta-phi index of the emcal clusters of the event
+  std::vector<Int_t>   fClusterCandidates;                                                   //!<! Clusters selected in the index for the current track
 #endif
 
   TClonesArray *fEmcalTracks;           //!<!emcal tracks
@@ -116,7 +121,7 @@ private:
   static RegisterCorrectionComponent<AliEmcalCorrectionClusterTrackMatcher> reg;
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 5); // EMCal cluster track matcher correction component
+  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 6); // EMCal cluster track matcher correction component
   /// \endcond
 };
 
@@ -355,20 +355,11 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
  this->CheckPointersUsedInMake();
  
  // b) Define local variables:
- Double_t dPhi = 0.; // azimuthal angle in the laboratory frame
- Double_t dPt  = 0.; // transverse momentum
- Double_t dEta = 0.; // pseudorapidity
- Double_t wPhi = 1.; // phi weight
- Double_t wPt  = 1.; // pt weight
- Double_t wEta = 1.; // eta weight
- Double_t wTrack = 1.; // track weight
- Int_t nCounterNoRPs = 0; // needed only for shuffling
  fNumberOfRPsEBE = anEvent->GetNumberOfRPs(); // number of RPs (i.e. number of reference particles)
  if(fExactNoRPs > 0 && fNumberOfRPsEBE<fExactNoRPs){return;}
  fNumberOfPOIsEBE = anEvent->GetNumberOfPOIs(); // number of POIs (i.e. number of particles of interest)
  fReferenceMultiplicityEBE = anEvent->GetReferenceMultiplicity(); // reference multiplicity for current event
  //Printf("Reference multiplicity (QC): %.1f",fReferenceMultiplicityEBE);
- Double_t ptEta[2] = {0.,0.}; // 0 = dPt, 1 = dEta
   
  // c) Fill the common control histograms and call the method to fill fAvMultiplicity:
  this->FillCommonControlHistograms(anEvent);                                                               
@@ -376,177 +367,8 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
  if(fStoreControlHistograms){this->FillControlHistograms(anEvent);}                                                              
                                                                                                                                                                                                                                                                                         
  // d) Loop over data and calculate e-b-e quantities Q_{n,k}, S_{p,k} and s_{p,k}:
- Int_t nPrim = anEvent->NumberOfTracks();  // nPrim = total number of primary tracks
- AliFlowTrackSimple *aftsTrack = NULL;
- Int_t n = fHarmonic; // shortcut for the harmonic 
- for(Int_t i=0;i<nPrim;i++) 
- { 
-  if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){continue;}
-  aftsTrack=anEvent->GetTrack(i);
-  if(aftsTrack)
-  {
-   if(!(aftsTrack->InRPSelection() || aftsTrack->InPOISelection())){continue;} // safety measure: consider only tracks which are RPs or POIs
-   if(aftsTrack->InRPSelection()) // RP condition:
-   {    
-    nCounterNoRPs++;
-    dPhi = aftsTrack->Phi();
-    dPt  = aftsTrack->Pt();
-    dEta = aftsTrack->Eta();
-    if(fUsePhiWeights && fPhiWeights && fnBinsPhi) // determine phi weight for this particle:
-    {
-     wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
-    }
-    if(fUsePtWeights && fPtWeights && fnBinsPt) // determine pt weight for this particle:
-    {
-     wPt = fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-fPtMin)/fPtBinWidth))); 
-    }              
-    if(fUseEtaWeights && fEtaWeights && fEtaBinWidth) // determine eta weight for this particle: 
-    {
-     wEta = fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-fEtaMin)/fEtaBinWidth))); 
-    }      
-    // Access track weight:
-    if(fUseTrackWeights)
-    {
-     wTrack = aftsTrack->Weight(); 
-    }
-    // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
-    for(Int_t m=0;m<12;m++) // to be improved - hardwired 6 
-    {
-     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-     {
-      (*fReQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1)*n*dPhi); 
-      (*fImQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1)*n*dPhi); 
-     } 
-    }
-    // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
-    for(Int_t p=0;p<8;p++)
-    {
-     for(Int_t k=0;k<9;k++)
-     {     
-      (*fSpk)(p,k)+=pow(wPhi*wPt*wEta*wTrack,k);
-     }
-    } 
-    // Differential flow:
-    if(fCalculateDiffFlow || fCalculate2DDiffFlow)
-    {
-     ptEta[0] = dPt; 
-     ptEta[1] = dEta; 
-     // Calculate r_{m*n,k} and s_{p,k} (r_{m,k} is 'p-vector' for RPs): 
-     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-     {
-      for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-      {
-       if(fCalculateDiffFlow)
-       {
-        for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-        {
-         fReRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-         fImRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
-         if(m==0) // s_{p,k} does not depend on index m
-         {
-          fs1dEBE[0][pe][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k),1.);
-         } // end of if(m==0) // s_{p,k} does not depend on index m
-        } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-       } // end of if(fCalculateDiffFlow) 
-       if(fCalculate2DDiffFlow)
-       {
-        fReRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-        fImRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
-        if(m==0) // s_{p,k} does not depend on index m
-        {
-         fs2dEBE[0][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k),1.);
-        } // end of if(m==0) // s_{p,k} does not depend on index m
-       } // end of if(fCalculate2DDiffFlow)
-      } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-     } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-     // Checking if RP particle is also POI particle:      
-     if(aftsTrack->InPOISelection())
-     {
-      // Calculate q_{m*n,k} and s_{p,k} ('q-vector' and 's' for RPs && POIs): 
-      for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-      {
-       for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-       {
-        if(fCalculateDiffFlow)
-        {
-         for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-         {
-          fReRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-          fImRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
-          if(m==0) // s_{p,k} does not depend on index m
-          {
-           fs1dEBE[2][pe][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k),1.);
-          } // end of if(m==0) // s_{p,k} does not depend on index m
-         } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-        } // end of if(fCalculateDiffFlow) 
-        if(fCalculate2DDiffFlow)
-        {
-         fReRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-         fImRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
-         if(m==0) // s_{p,k} does not depend on index m
-         {
-          fs2dEBE[2][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k),1.);
-         } // end of if(m==0) // s_{p,k} does not depend on index m
-        } // end of if(fCalculate2DDiffFlow)
-       } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-      } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9    
-     } // end of if(aftsTrack->InPOISelection())  
-    } // end of if(fCalculateDiffFlow || fCalculate2DDiffFlow)         
-   } // end of if(pTrack->InRPSelection())
-   if(aftsTrack->InPOISelection())
-   {
-    dPhi = aftsTrack->Phi();
-    dPt  = aftsTrack->Pt();
-    dEta = aftsTrack->Eta();
-    wPhi = 1.;
-    wPt  = 1.;
-    wEta = 1.;
-    wTrack = 1.;
-    if(fUsePhiWeights && fPhiWeights && fnBinsPhi && aftsTrack->InRPSelection()) // determine phi weight for POI && RP particle:
-    {
-     wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
-    }
-    if(fUsePtWeights && fPtWeights && fnBinsPt && aftsTrack->InRPSelection()) // determine pt weight for POI && RP particle:
-    {
-     wPt = fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-fPtMin)/fPtBinWidth))); 
-    }              
-    if(fUseEtaWeights && fEtaWeights && fEtaBinWidth && aftsTrack->InRPSelection()) // determine eta weight for POI && RP particle: 
-    {
-     wEta = fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-fEtaMin)/fEtaBinWidth))); 
-    }      
-    // Access track weight for POI && RP particle:
-    if(aftsTrack->InRPSelection() && fUseTrackWeights)
-    {
-     wTrack = aftsTrack->Weight(); 
-    }
-    ptEta[0] = dPt;
-    ptEta[1] = dEta;
-    // Calculate p_{m*n,k} ('p-vector' for POIs): 
-    for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-    {
-     for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-     {
-      if(fCalculateDiffFlow)
-      {
-       for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-       {
-        fReRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-        fImRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
-       } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-      } // end of if(fCalculateDiffFlow) 
-      if(fCalculate2DDiffFlow)
-      {
-       fReRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-       fImRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
-      } // end of if(fCalculate2DDiffFlow)
-     } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-    } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9    
-   } // end of if(pTrack->InPOISelection())    
-  } else // to if(aftsTrack)
-    {
-     printf("\n WARNING (QC): No particle (i.e. aftsTrack is a NULL pointer in AFAWQC::Make())!!!!\n\n");
-    }
- } // end of for(Int_t i=0;i<nPrim;i++) 
+ this->ExtractTracksEBE(anEvent);
+ this->FillQVectorsEBE();
 
  // e) Calculate the final expressions for S_{p,k} and s_{p,k} (important !!!!):
  for(Int_t p=0;p<8;p++)
@@ -20986,6 +20808,189 @@ void AliFlowAnalysisWithQCumulants::FillControlHistograms(AliFlowEventSimple *an
 
 //=======================================================================================================================
 
+void AliFlowAnalysisWithQCumulants::ExtractTracksEBE(AliFlowEventSimple *anEvent)
+{
+ // Extract phi, pt, eta, particle weight and RP/POI flags of the tracks used in this event into contiguous arrays.
+ 
+ // Remark: the particle weight w = wPhi*wPt*wEta*wTrack is used only for RPs, it is set to 1 for POIs which are not RPs.
+ 
+ fPhiEBE.clear();
+ fPtEBE.clear();
+ fEtaEBE.clear();
+ fWeightEBE.clear();
+ fTypeEBE.clear();
+ 
+ Int_t nPrim = anEvent->NumberOfTracks(); // nPrim = total number of primary tracks
+ Int_t nCounterNoRPs = 0; // needed only for shuffling
+ AliFlowTrackSimple *aftsTrack = NULL;
+ for(Int_t i=0;i<nPrim;i++) 
+ { 
+  if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){continue;}
+  aftsTrack=anEvent->GetTrack(i);
+  if(!aftsTrack)
+  {
+   printf("\n WARNING (QC): No particle (i.e. aftsTrack is a NULL pointer in AFAWQC::Make())!!!!\n\n");
+   continue;
+  }
+  Bool_t bRP = aftsTrack->InRPSelection();
+  Bool_t bPOI = aftsTrack->InPOISelection();
+  if(!(bRP || bPOI)){continue;} // safety measure: consider only tracks which are RPs or POIs
+  Double_t dPhi = aftsTrack->Phi(); // azimuthal angle in the laboratory frame
+  Double_t dPt  = aftsTrack->Pt(); // transverse momentum
+  Double_t dEta = aftsTrack->Eta(); // pseudorapidity
+  Double_t wPhi = 1.; // phi weight
+  Double_t wPt  = 1.; // pt weight
+  Double_t wEta = 1.; // eta weight
+  Double_t wTrack = 1.; // track weight
+  if(bRP) // RP condition:
+  {    
+   nCounterNoRPs++;
+   if(fUsePhiWeights && fPhiWeights && fnBinsPhi) // determine phi weight for this particle:
+   {
+    wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
+   }
+   if(fUsePtWeights && fPtWeights && fnBinsPt) // determine pt weight for this particle:
+   {
+    wPt = fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-fPtMin)/fPtBinWidth))); 
+   }              
+   if(fUseEtaWeights && fEtaWeights && fEtaBinWidth) // determine eta weight for this particle: 
+   {
+    wEta = fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-fEtaMin)/fEtaBinWidth))); 
+   }      
+   if(fUseTrackWeights) // access track weight:
+   {
+    wTrack = aftsTrack->Weight(); 
+   }
+  } // end of if(bRP)
+  fPhiEBE.push_back(dPhi);
+  fPtEBE.push_back(dPt);
+  fEtaEBE.push_back(dEta);
+  fWeightEBE.push_back(wPhi*wPt*wEta*wTrack);
+  fTypeEBE.push_back((bRP ? 1 : 0) | (bPOI ? 2 : 0));
+ } // end of for(Int_t i=0;i<nPrim;i++) 
+
+} // end of void AliFlowAnalysisWithQCumulants::ExtractTracksEBE(AliFlowEventSimple *anEvent)
+
+//=======================================================================================================================
+
+void AliFlowAnalysisWithQCumulants::FillQVectorsEBE()
+{
+ // Calculate Q_{m*n,k}, S_{p,k} and the differential r-, p- and q-vectors from the arrays filled in ExtractTracksEBE().
+ 
+ // a) Per track: w^k (k = 0,1,...,8) by successive products, cos and sin of (m+1)*n*phi (m = 0,1,...,11) by recurrence;
+ // b) Accumulate Re[Q_{m*n,k}], Im[Q_{m*n,k}] and S_{1,k} in plain arrays, copy them to fReQ, fImQ and fSpk at the end;
+ // c) Fill the differential vectors in the same pass.
+ 
+ Int_t n = fHarmonic; // shortcut for the harmonic 
+ Double_t reQ[12][9] = {{0.}}; // Re[Q_{m*n,k}]
+ Double_t imQ[12][9] = {{0.}}; // Im[Q_{m*n,k}]
+ Double_t sk[9] = {0.}; // S_{1,k}
+ Double_t wPow[9] = {0.}; // w^k
+ Double_t cosH[12] = {0.}; // cos((m+1)*n*phi)
+ Double_t sinH[12] = {0.}; // sin((m+1)*n*phi)
+ Double_t ptEta[2] = {0.,0.}; // 0 = dPt, 1 = dEta
+ Bool_t bDiffFlow = fCalculateDiffFlow || fCalculate2DDiffFlow;
+ 
+ Int_t nTracks = (Int_t)fPhiEBE.size();
+ for(Int_t i=0;i<nTracks;i++)
+ {
+  // a) Powers of weight and harmonics:
+  wPow[0] = 1.;
+  for(Int_t k=1;k<9;k++)
+  {
+   wPow[k] = wPow[k-1]*fWeightEBE[i];
+  }
+  cosH[0] = TMath::Cos(n*fPhiEBE[i]);
+  sinH[0] = TMath::Sin(n*fPhiEBE[i]);
+  for(Int_t m=1;m<12;m++)
+  {
+   cosH[m] = cosH[m-1]*cosH[0]-sinH[m-1]*sinH[0];
+   sinH[m] = sinH[m-1]*cosH[0]+cosH[m-1]*sinH[0];
+  }
+  Bool_t bRP = fTypeEBE[i] & 1;
+  Bool_t bPOI = fTypeEBE[i] & 2;
+  // b) Reference flow:
+  if(bRP)
+  {
+   for(Int_t m=0;m<12;m++)
+   {
+    for(Int_t k=0;k<9;k++)
+    {
+     reQ[m][k] += wPow[k]*cosH[m];
+     imQ[m][k] += wPow[k]*sinH[m];
+    }
+   }
+   for(Int_t k=0;k<9;k++)
+   {
+    sk[k] += wPow[k];
+   }
+  } // end of if(bRP)
+  // c) Differential flow:
+  if(!bDiffFlow){continue;}
+  ptEta[0] = fPtEBE[i];
+  ptEta[1] = fEtaEBE[i];
+  if(bRP){this->FillDiffFlowVectorsEBE(0,ptEta,wPow,cosH,sinH);} // r_{m*n,k} and s_{p,k} ('p-vector' for RPs)
+  if(bRP && bPOI){this->FillDiffFlowVectorsEBE(2,ptEta,wPow,cosH,sinH);} // q_{m*n,k} and s_{p,k} (RPs && POIs)
+  if(bPOI){this->FillDiffFlowVectorsEBE(1,ptEta,wPow,cosH,sinH);} // p_{m*n,k} ('p-vector' for POIs)
+ } // end of for(Int_t i=0;i<nTracks;i++)
+ 
+ // Copy to the event-by-event matrices (Remark: final calculation of S_{p,k} follows in Make()):
+ for(Int_t m=0;m<12;m++)
+ {
+  for(Int_t k=0;k<9;k++)
+  {
+   (*fReQ)(m,k) += reQ[m][k];
+   (*fImQ)(m,k) += imQ[m][k];
+  }
+ }
+ for(Int_t p=0;p<8;p++)
+ {
+  for(Int_t k=0;k<9;k++)
+  {
+   (*fSpk)(p,k) += sk[k];
+  }
+ }
+
+} // end of void AliFlowAnalysisWithQCumulants::FillQVectorsEBE()
+
+//=======================================================================================================================
+
+void AliFlowAnalysisWithQCumulants::FillDiffFlowVectorsEBE(Int_t t, const Double_t *ptEta, const Double_t *wPow, const Double_t *cosH, const Double_t *sinH)
+{
+ // Fill the differential vectors of type t (0 = RP, 1 = POI, 2 = RP&&POI) for one track, s_{p,k} is not needed for t = 1.
+ 
+ for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+ {
+  for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+  {
+   if(fCalculateDiffFlow)
+   {
+    for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
+    {
+     fReRPQ1dEBE[t][pe][m][k]->Fill(ptEta[pe],wPow[k]*cosH[m],1.);
+     fImRPQ1dEBE[t][pe][m][k]->Fill(ptEta[pe],wPow[k]*sinH[m],1.);
+     if(m==0 && t!=1) // s_{p,k} does not depend on index m
+     {
+      fs1dEBE[t][pe][k]->Fill(ptEta[pe],wPow[k],1.);
+     }
+    } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
+   } // end of if(fCalculateDiffFlow) 
+   if(fCalculate2DDiffFlow)
+   {
+    fReRPQ2dEBE[t][m][k]->Fill(ptEta[0],ptEta[1],wPow[k]*cosH[m],1.);
+    fImRPQ2dEBE[t][m][k]->Fill(ptEta[0],ptEta[1],wPow[k]*sinH[m],1.);
+    if(m==0 && t!=1) // s_{p,k} does not depend on index m
+    {
+     fs2dEBE[t][k]->Fill(ptEta[0],ptEta[1],wPow[k],1.);
+    }
+   } // end of if(fCalculate2DDiffFlow)
+  } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+ } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+
+} // end of void AliFlowAnalysisWithQCumulants::FillDiffFlowVectorsEBE(...)
+
+//=======================================================================================================================
+
 void AliFlowAnalysisWithQCumulants::ResetEventByEventQuantities()
 {
  // Reset all event by event quantities.
@@ -14,6 +14,7 @@
 #ifndef ALIFLOWANALYSISWITHQCUMULANTS_H
 #define ALIFLOWANALYSISWITHQCUMULANTS_H
 
+#include <vector>
 #include "TMatrixD.h"
 #include "TH2D.h"
 #include "TRandom3.h"
@@ -81,6 +82,9 @@ class AliFlowAnalysisWithQCumulants{
     virtual void FillAverageMultiplicities(Int_t nRP);
     virtual void FillCommonControlHistograms(AliFlowEventSimple *anEvent);
     virtual void FillControlHistograms(AliFlowEventSimple *anEvent);
+    virtual void ExtractTracksEBE(AliFlowEventSimple *anEvent);
+    virtual void FillQVectorsEBE();
+    virtual void FillDiffFlowVectorsEBE(Int_t t, const Double_t *ptEta, const Double_t *wPow, const Double_t *cosH, const Double_t *sinH);
     virtual void ResetEventByEventQuantities();
     // 2b.) Reference flow:
     virtual void CalculateIntFlowCorrelations(); 
@@ -632,6 +636,11 @@ class AliFlowAnalysisWithQCumulants{
   TMatrixD *fReQ; //! fReQ[m][k] = sum_{i=1}^{M} w_{i}^{k} cos(m*phi_{i})
   TMatrixD *fImQ; //! fImQ[m][k] = sum_{i=1}^{M} w_{i}^{k} sin(m*phi_{i})
   TMatrixD *fSpk; //! fSM[p][k] = (sum_{i=1}^{M} w_{i}^{k})^{p+1}
+  std::vector<Double_t> fPhiEBE; //! phi of RPs and POIs in this event
+  std::vector<Double_t> fPtEBE; //! pt of RPs and POIs in this event
+  std::vector<Double_t> fEtaEBE; //! eta of RPs and POIs in this event
+  std::vector<Double_t> fWeightEBE; //! particle weight wPhi*wPt*wEta*wTrack (1 for POIs which are not RPs)
+  std::vector<UChar_t> fTypeEBE; //! bit 0: RP, bit 1: POI
   TH1D *fIntFlowCorrelationsEBE; // 1st bin: <2>, 2nd bin: <4>, 3rd bin: <6>, 4th bin: <8>
   TH1D *fIntFlowEventWeightsForCorrelationsEBE; // 1st bin: eW_<2>, 2nd bin: eW_<4>, 3rd bin: eW_<6>, 4th bin: eW_<8>
   TH1D *fIntFlowCorrelationsAllEBE; // to be improved (add comment)
@@ -38,6 +38,7 @@
 #include "TProfile.h"
 #include "TParameter.h"
 #include "TBrowser.h"
+#include "TClass.h"
 #include "AliFlowVector.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowTrackSimpleCuts.h"
@@ -88,6 +89,10 @@ AliFlowEventSimple::AliFlowEventSimple():
   fZPCM(0.),
   fZPAM(0.),
   fAbsOrbit(0),
+  fTrackPoolClass(NULL),
+  fTrackPoolBlocks(),
+  fTrackPoolBlockSizes(),
+  fTrackPoolSize(0),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(NULL)
 {
@@ -147,6 +152,10 @@ AliFlowEventSimple::AliFlowEventSimple( Int_t n,
   fZPCM(0.),
   fZPAM(0.),
   fAbsOrbit(0),
+  fTrackPoolClass(NULL),
+  fTrackPoolBlocks(),
+  fTrackPoolBlockSizes(),
+  fTrackPoolSize(0),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -210,6 +219,10 @@ AliFlowEventSimple::AliFlowEventSimple(const AliFlowEventSimple& anEvent):
   fZPCM(anEvent.fZPCM),
   fZPAM(anEvent.fZPAM),
   fAbsOrbit(anEvent.fAbsOrbit),
+  fTrackPoolClass(NULL),
+  fTrackPoolBlocks(),
+  fTrackPoolBlockSizes(),
+  fTrackPoolSize(0),
   fNumberOfPOItypes(anEvent.fNumberOfPOItypes),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -257,7 +270,7 @@ AliFlowEventSimple& AliFlowEventSimple::operator=(const AliFlowEventSimple& anEv
 {
   //assignment operator
   if (&anEvent==this) return *this; //check self-assignment
-  if (fTrackCollection) fTrackCollection->Delete();
+  DeleteTracks();
   delete fTrackCollection;
   fTrackCollection = (TObjArray*)(anEvent.fTrackCollection)->Clone(); //deep copy
   fReferenceMultiplicity = anEvent.fReferenceMultiplicity;
@@ -314,7 +327,7 @@ AliFlowEventSimple& AliFlowEventSimple::operator=(const AliFlowEventSimple& anEv
 AliFlowEventSimple::~AliFlowEventSimple()
 {
   //destructor
-  if (fTrackCollection) fTrackCollection->Delete();
+  DeleteTracks();
   delete fTrackCollection;
   delete fNumberOfTracksWrap;
   delete fNumberOfRPsWrap;
@@ -454,7 +467,12 @@ void AliFlowEventSimple::AddTrack( AliFlowTrackSimple* track )
   if (fNumberOfTracks < fTrackCollection->GetEntriesFast())
   {
     TObject* o = fTrackCollection->At(fNumberOfTracks);
-    delete o;
+    if (o!=track)
+    {
+      //a pooled track is moved to the end of the collection to be reused later
+      if (IsPooledTrack(o)) fTrackCollection->AddAtAndExpand(o,fTrackCollection->GetEntriesFast());
+      else delete o;
+    }
   }
   fTrackCollection->AddAtAndExpand(track,fNumberOfTracks);
   if (track->GetNDaughters()>0)
@@ -480,6 +498,17 @@ void AliFlowEventSimple::TrackAdded()
 //-----------------------------------------------------------------------
 AliFlowTrackSimple* AliFlowEventSimple::MakeNewTrack()
 {
+   //with the track pool the track stays owned by the event: it is cleared
+   //and left in its slot, AddTrack() then only does the book keeping
+   if (fTrackPoolClass)
+   {
+      ReserveTracks(fNumberOfTracks+1);
+      AliFlowTrackSimple *t=static_cast<AliFlowTrackSimple *>(fTrackCollection->At(fNumberOfTracks));
+      if (t) {
+         t->Clear();
+         return t;
+      }
+   }
    AliFlowTrackSimple *t=dynamic_cast<AliFlowTrackSimple *>(fTrackCollection->RemoveAt(fNumberOfTracks));
    if( !t ) {  // If there was no track at the end of the list then create a new track
       t=new AliFlowTrackSimple();
@@ -896,6 +925,10 @@ AliFlowEventSimple::AliFlowEventSimple( TTree* inputTree,
   fZPCM(0.),
   fZPAM(0.),
   fAbsOrbit(0),
+  fTrackPoolClass(NULL),
+  fTrackPoolBlocks(),
+  fTrackPoolBlockSizes(),
+  fTrackPoolSize(0),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -1238,6 +1271,32 @@ Int_t AliFlowEventSimple::CleanUpDeadTracks()
   //remove tracks that have no flow tags set and cleanup the container
   //returns number of cleaned tracks
   Int_t ncleaned=0;
+  if (fTrackPoolClass)
+  {
+    //keep the dead tracks behind the live ones so that they can be reused,
+    //followed by the unused tracks of the collection, without empty slots
+    Int_t nentries=fTrackCollection->GetEntriesFast();
+    Int_t nlive=0;
+    std::vector<TObject*> dead;
+    for (Int_t i=0; i<fNumberOfTracks; i++)
+    {
+      AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
+      if (!track) continue;
+      if (track->IsDead()) {dead.push_back(track);ncleaned++;}
+      else fTrackCollection->AddAt(track,nlive++);
+    }
+    Int_t next=nlive;
+    for (Int_t j=0; j<ncleaned; j++) fTrackCollection->AddAt(dead[j],next++);
+    for (Int_t i=fNumberOfTracks; i<nentries; i++)
+    {
+      TObject* o = fTrackCollection->At(i);
+      if (o) fTrackCollection->AddAt(o,next++);
+    }
+    for (Int_t i=next; i<nentries; i++) fTrackCollection->RemoveAt(i);
+    fNumberOfTracks=nlive; //update number of tracks
+    delete [] fShuffledIndexes; fShuffledIndexes=NULL;
+    return ncleaned;
+  }
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1271,6 +1330,97 @@ TF1* AliFlowEventSimple::SimplePtSpectrum()
   return new TF1("StandardPtSpectrum","x*TMath::Exp(-pow(0.13957*0.13957+x*x,0.5)/0.4)",0.1,10.);
 }
 
+//_____________________________________________________________________________
+void AliFlowEventSimple::SetUseTrackPool(Bool_t b)
+{
+  //take the tracks from a pool of contiguous blocks, kept across events.
+  //the pooled tracks stay in the slots of the collection, so ClearFast()
+  //leaves them in place and the next event reuses them.
+  //the pool cannot be switched off once tracks were allocated from it
+  if (b)
+  {
+    if (!fTrackPoolClass) fTrackPoolClass = TrackPoolClass();
+    return;
+  }
+  if (fTrackPoolSize>0)
+  {
+    Printf("AliFlowEventSimple::SetUseTrackPool: pooled tracks in use, pool stays on");
+    return;
+  }
+  fTrackPoolClass = NULL;
+}
+
+//_____________________________________________________________________________
+TClass* AliFlowEventSimple::TrackPoolClass() const
+{
+  //class of the pooled tracks
+  return AliFlowTrackSimple::Class();
+}
+
+//_____________________________________________________________________________
+void AliFlowEventSimple::ReserveTracks(Int_t n)
+{
+  //with the track pool, make sure that the first n slots of the collection
+  //hold a track: new pooled tracks are appended in one contiguous block,
+  //at least doubling the pool
+  if (!fTrackPoolClass) return;
+  Int_t first = fTrackCollection->GetEntriesFast();
+  if (n<=first) return;
+  Int_t size = TMath::Max(n-first,TMath::Max(fTrackPoolSize,64));
+  char* block = static_cast<char*>(fTrackPoolClass->NewArray(size));
+  if (!block) return;
+  fTrackPoolBlocks.push_back(block);
+  fTrackPoolBlockSizes.push_back(size);
+  fTrackPoolSize+=size;
+  if (fTrackCollection->GetSize()<first+size) fTrackCollection->Expand(first+size);
+  Int_t objectSize = fTrackPoolClass->Size();
+  for (Int_t i=0; i<size; i++)
+  {
+    fTrackCollection->AddAt(reinterpret_cast<TObject*>(block+i*objectSize),first+i);
+  }
+}
+
+//_____________________________________________________________________________
+Bool_t AliFlowEventSimple::IsPooledTrack(const TObject* track) const
+{
+  //is the track allocated in the track pool?
+  if (!track || !fTrackPoolSize) return kFALSE;
+  const char* p = reinterpret_cast<const char*>(track);
+  Int_t objectSize = fTrackPoolClass->Size();
+  for (UInt_t i=0; i<fTrackPoolBlocks.size(); i++)
+  {
+    const char* block = static_cast<const char*>(fTrackPoolBlocks[i]);
+    if (p>=block && p<block+fTrackPoolBlockSizes[i]*objectSize) return kTRUE;
+  }
+  return kFALSE;
+}
+
+//_____________________________________________________________________________
+void AliFlowEventSimple::DeleteTracks()
+{
+  //delete the tracks owned by the collection and release the track pool
+  if (fTrackCollection)
+  {
+    if (fTrackPoolSize>0)
+    {
+      for (Int_t i=0; i<fTrackCollection->GetEntriesFast(); i++)
+      {
+        TObject* o = fTrackCollection->At(i);
+        if (!IsPooledTrack(o)) delete o;
+      }
+      fTrackCollection->Clear();
+    }
+    else fTrackCollection->Delete();
+  }
+  for (UInt_t i=0; i<fTrackPoolBlocks.size(); i++)
+  {
+    fTrackPoolClass->DeleteArray(fTrackPoolBlocks[i]);
+  }
+  fTrackPoolBlocks.clear();
+  fTrackPoolBlockSizes.clear();
+  fTrackPoolSize=0;
+}
+
 //_____________________________________________________________________________
 void AliFlowEventSimple::ClearFast()
 {
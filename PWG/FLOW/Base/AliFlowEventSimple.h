@@ -16,11 +16,13 @@
 #ifndef ALIFLOWEVENTSIMPLE_H
 #define ALIFLOWEVENTSIMPLE_H
 
+#include <vector>
 #include "TObject.h"
 #include "TParameter.h"
 #include "TMath.h"
 #include "AliFlowVector.h"
 class TTree;
+class TClass;
 class TF1;
 class TF2;
 class AliFlowTrackSimple;
@@ -116,6 +118,9 @@ class AliFlowEventSimple: public TObject {
   void AddTrack( AliFlowTrackSimple* track );
   void TrackAdded();
   AliFlowTrackSimple* MakeNewTrack();
+  void SetUseTrackPool(Bool_t b=kTRUE);
+  Bool_t GetUseTrackPool() const {return (fTrackPoolClass!=NULL);}
+  void ReserveTracks(Int_t n);
 
   virtual AliFlowVector GetQ(Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void Get2Qsub(AliFlowVector* Qarray, Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
@@ -160,6 +165,9 @@ class AliFlowEventSimple: public TObject {
                          Double_t phiMax=TMath::TwoPi(),
                          Double_t etaMin=-1.0,
                          Double_t etaMax= 1.0 );
+  virtual TClass* TrackPoolClass() const;
+  Bool_t IsPooledTrack(const TObject* track) const;
+  void DeleteTracks();
 
   //data members
   TObjArray*              fTrackCollection;           //-> collection of tracks
@@ -204,6 +212,10 @@ class AliFlowEventSimple: public TObject {
   Double_t                fZPAM;                      // total energy from ZPC-A
   Double_t                fVtxPos[3];                 // Primary vertex position (x,y,z)
   UInt_t                  fAbsOrbit;                  // Absolute orbit number
+  TClass*                 fTrackPoolClass;            //! class of the pooled tracks, NULL if the pool is off
+  std::vector<void*>      fTrackPoolBlocks;           //! contiguous blocks of pooled tracks
+  std::vector<Int_t>      fTrackPoolBlockSizes;       //! number of tracks in each block
+  Int_t                   fTrackPoolSize;             //! number of pooled tracks
 
  private:
   Int_t                   fNumberOfPOItypes;    // how many different flow particle types do we have? (RP,POI,POI_2,...)
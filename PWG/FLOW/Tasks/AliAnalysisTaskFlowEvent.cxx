@@ -138,6 +138,7 @@ AliAnalysisTaskFlowEvent::AliAnalysisTaskFlowEvent() :
   fDifferentialV2(0),
   fFlowEvent(NULL),
   fShuffleTracks(kFALSE),
+  fUseTrackPool(kFALSE),
   fMyTRandom3(NULL)
 {
   // Constructor
@@ -200,6 +201,7 @@ AliAnalysisTaskFlowEvent::AliAnalysisTaskFlowEvent(const char *name, TString RPt
   fDifferentialV2(0),
   fFlowEvent(NULL),
   fShuffleTracks(kFALSE),
+  fUseTrackPool(kFALSE),
   fMyTRandom3(NULL)
 {
   // Constructor
@@ -291,6 +293,7 @@ void AliAnalysisTaskFlowEvent::UserCreateOutputObjects()
   cc->SetHistWeightvsPhiMin(fHistWeightvsPhiMin);
 
   fFlowEvent = new AliFlowEvent(10000);
+  fFlowEvent->SetUseTrackPool(fUseTrackPool);
 
   if (fQAon)
   {
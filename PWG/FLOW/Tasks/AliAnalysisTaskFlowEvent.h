@@ -74,6 +74,7 @@ class AliAnalysisTaskFlowEvent : public AliAnalysisTaskSE {
   Bool_t        GetQAOn()   const         {return fQAon; }
 
   void          SetShuffleTracks(Bool_t b)  {fShuffleTracks=b;}
+  void          SetUseTrackPool(Bool_t b=kTRUE)  {fUseTrackPool=b;}
 
   void   SetPassMCeventToCutsObject(Bool_t passMC){this->fPassMCeventToCutsObject = passMC;}
 
@@ -184,11 +185,12 @@ class AliAnalysisTaskFlowEvent : public AliAnalysisTaskSE {
 
   AliFlowEvent* fFlowEvent; //flowevent
   Bool_t fShuffleTracks;    //serve the tracks shuffled
+  Bool_t fUseTrackPool;     //reuse pooled flow tracks across events
     
   TRandom3* fMyTRandom3;     // TRandom3 generator
   // end afterburner
   
-  ClassDef(AliAnalysisTaskFlowEvent, 1); // example of analysis
+  ClassDef(AliAnalysisTaskFlowEvent, 2); // example of analysis
 };
 
 #endif
@@ -963,6 +963,7 @@ void AliFlowEvent::Fill( AliFlowTrackCuts* rpCuts,
       //make new AliFlowTrack
       if (rp)
       {
+        ReserveTracks(fNumberOfTracks+1);
         pTrack = rpCuts->FillFlowTrack(fTrackCollection,fNumberOfTracks);
         if (!pTrack) continue;
         pTrack->Tag(0); IncrementNumberOfPOIs(0);
@@ -971,6 +972,7 @@ void AliFlowEvent::Fill( AliFlowTrackCuts* rpCuts,
       }
       else if (poi)
       {
+        ReserveTracks(fNumberOfTracks+1);
         pTrack = poiCuts->FillFlowTrack(fTrackCollection,fNumberOfTracks);
         if (!pTrack) continue;
         pTrack->Tag(1); IncrementNumberOfPOIs(1);
@@ -989,6 +991,7 @@ void AliFlowEvent::Fill( AliFlowTrackCuts* rpCuts,
       TObject* particle = poiCuts->GetInputObject(i);
       Bool_t poi = poiCuts->IsSelected(particle,i);
       if (!poi) continue;
+      ReserveTracks(fNumberOfTracks+1);
       pTrack = poiCuts->FillFlowTrack(fTrackCollection,fNumberOfTracks);
       if (!pTrack) continue;
       pTrack->Tag(1);
@@ -1003,6 +1006,7 @@ void AliFlowEvent::Fill( AliFlowTrackCuts* rpCuts,
       TObject* particle = rpCuts->GetInputObject(i);
       Bool_t rp = rpCuts->IsSelected(particle,i);
       if (!rp) continue;
+      ReserveTracks(fNumberOfTracks+1);
       pTrack = rpCuts->FillFlowTrack(fTrackCollection,fNumberOfTracks);
       if (!pTrack) continue;
       pTrack->Tag(0);
@@ -1029,6 +1033,7 @@ void AliFlowEvent::InsertTrack(AliFlowTrack *track) {
 AliFlowTrack* AliFlowEvent::ReuseTrack(Int_t i)
 {
   //try to reuse an existing track, if empty, make new one
+  ReserveTracks(i+1);
   AliFlowTrack* pTrack = static_cast<AliFlowTrack*>(fTrackCollection->At(i));
   if (pTrack)
   {
@@ -2379,6 +2384,13 @@ void AliFlowEvent::SetHotfixVZEROCalibrationForTrackCuts(AliFlowTrackCuts* cuts)
  fApplyRecentering = 20152;
 }
 
+//-----------------------------------------------------------------------
+TClass* AliFlowEvent::TrackPoolClass() const
+{
+  //the flow tracks are filled as AliFlowTrack
+  return AliFlowTrack::Class();
+}
+
 //-----------------------------------------------------------------------------
 
 void AliFlowEvent::ClearFast()
@@ -99,6 +99,7 @@ public:
 
 protected:
   AliFlowTrack* ReuseTrack( Int_t i);
+  virtual TClass* TrackPoolClass() const;
 
 private:
   Int_t         fApplyRecentering;      // apply recentering of q-vectors? 2010 is 10h style, 2011 is 11h style
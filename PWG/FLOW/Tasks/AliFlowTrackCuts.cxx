@@ -2307,8 +2307,9 @@ AliFlowTrack* AliFlowTrackCuts::FillFlowTrackGeneric(TObjArray* trackCollection,
   if (FillFlowTrackGeneric(flowtrack)) return flowtrack;
   else 
   {
-    trackCollection->RemoveAt(trackIndex);
-    delete flowtrack;
+    //leave the cleared track in its slot to be reused: it can be a pooled
+    //track of the event (see AliFlowEventSimple::SetUseTrackPool), which must not be deleted
+    flowtrack->Clear();
     return NULL;
   }
 }
@@ -2384,8 +2385,9 @@ AliFlowTrack* AliFlowTrackCuts::FillFlowTrackVParticle(TObjArray* trackCollectio
   if (FillFlowTrackVParticle(flowtrack)) return flowtrack;
   else
   {
-    trackCollection->RemoveAt(trackIndex);
-    delete flowtrack;
+    //leave the cleared track in its slot to be reused: it can be a pooled
+    //track of the event (see AliFlowEventSimple::SetUseTrackPool), which must not be deleted
+    flowtrack->Clear();
     return NULL;
   }
 }
@@ -53,7 +53,10 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT() :
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fNShards(0),
+  fShardValues(0),
+  fShardSumw2(0)
 {
   // Constructor
 }
@@ -69,7 +72,10 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const Char_t* name, const Char_t*
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fNShards(0),
+  fShardValues(0),
+  fShardSumw2(0)
 {
   // Constructor
 
@@ -106,7 +112,10 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const AliTHnT &c) :
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fNShards(0),
+  fShardValues(0),
+  fShardSumw2(0)
 {
   //
   // AliTHnT copy constructor
@@ -128,6 +137,7 @@ AliTHnT<TemplateArray, TemplateType>::~AliTHnT()
   // Destructor
   
   DeleteContainers();
+  DeleteShards();
   
   delete[] fValues;
   delete[] fSumw2;
@@ -166,6 +176,8 @@ AliTHnT<TemplateArray, TemplateType> &AliTHnT<TemplateArray, TemplateType>::oper
 
   if (this != &c) {
     AliCFContainer::operator=(c);
+    // the shards are laid out per step, remove them before fNSteps changes (their content is overwritten anyway)
+    DeleteShards();
     fNBins=c.fNBins;
     fNVars=c.fNVars;
     if(fNSteps) {
@@ -194,6 +206,15 @@ AliTHnT<TemplateArray, TemplateType> &AliTHnT<TemplateArray, TemplateType>::oper
     delete [] axisCache;
     axisCache = new TAxis*[fNVars];
     memcpy(axisCache, c.axisCache, fNVars*sizeof(TAxis*));
+
+    // same number of shards as c, including its entries not merged yet
+    if (c.fNShards > 0) {
+      SetNShards(c.fNShards);
+      for (Int_t i=0; i<fNShards*fNSteps; i++) {
+	if (c.fShardValues[i]) fShardValues[i] = new TemplateArray(*(c.fShardValues[i]));
+	if (c.fShardSumw2[i])  fShardSumw2[i]  = new TemplateArray(*(c.fShardSumw2[i]));
+      }
+    }
   }
   return *this;
 }
@@ -208,6 +229,7 @@ void AliTHnT<TemplateArray, TemplateType>::Copy(TObject& c) const
   
   AliCFContainer::Copy(target);
   
+  target.DeleteShards();
   target.fNSteps = fNSteps;
   target.fNBins = fNBins;
   target.fNVars = fNVars;
@@ -239,6 +261,8 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
   if (!list)
     return 0;
   
+  MergeShards();
+
   if (list->IsEmpty())
     return 1;
   
@@ -254,6 +278,8 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
     if (entry == 0) 
       continue;
 
+    entry->MergeShards();
+
     for (Int_t i=0; i<fNSteps; i++)
     {
       if (entry->fValues[i])
@@ -287,15 +313,9 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
   // fills an entry
 
   // fill axis cache
-  if (!axisCache)
+  if (!fLastVars)
   {
-    axisCache = new TAxis*[fNVars];
-    fNbinsCache = new Int_t[fNVars];
-    for (Int_t i=0; i<fNVars; i++)
-    {
-      axisCache[i] = GetAxis(i, 0);
-      fNbinsCache[i] = axisCache[i]->GetNbins();
-    }
+    InitAxisCache();
     
     fLastVars = new Double_t[fNVars];
     fLastBins = new Int_t[fNVars];
@@ -360,6 +380,301 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
 //   AliCFContainer::Fill(var, istep, weight);
 }
 
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::InitAxisCache()
+{
+  // fills axis pointer and number of bins caches
+
+  if (fNbinsCache)
+    return;
+
+  delete[] axisCache;
+  axisCache = new TAxis*[fNVars];
+  fNbinsCache = new Int_t[fNVars];
+  for (Int_t i=0; i<fNVars; i++)
+  {
+    axisCache[i] = GetAxis(i, 0);
+    fNbinsCache[i] = axisCache[i]->GetNbins();
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillN(Int_t nPoints, const Double_t *varsSoA, Int_t istep, const Double_t *weights)
+{
+  // fills <nPoints> entries at once
+  // varsSoA is stored variable by variable: value of variable i for entry p is varsSoA[i*nPoints + p]
+  // weights can be 0 in which case all entries are filled with weight 1
+  // the result is identical to calling Fill for each entry
+
+  InitAxisCache();
+  FillBlock(fValues, fSumw2, nPoints, varsSoA, istep, weights);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillBin(const Int_t *binIdx, Int_t istep, Double_t sumw, Double_t sumw2)
+{
+  // adds several entries falling into the same bin at once
+  // binIdx contains TAxis bin indexes, sumw and sumw2 are the sum of the weights and of the squared weights of the entries
+  // the result is identical to calling Fill for each entry (up to the rounding of the sums)
+  // fills the main containers like Fill; use FillBinShard when filling from several threads
+
+  InitAxisCache();
+  FillBinTo(fValues, fSumw2, binIdx, istep, sumw, sumw2);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillBinTo(TemplateArray** values, TemplateArray** sumw2, const Int_t *binIdx, Int_t istep, Double_t binSumw, Double_t binSumw2)
+{
+  // adds the sums of one bin to <values> and <sumw2>, see FillBin
+  // only reads the axis cache, so it can be called concurrently on different containers
+
+  Long64_t bin = 0;
+  for (Int_t i=0; i<fNVars; i++)
+  {
+    // under/overflow not supported
+    if (binIdx[i] < 1 || binIdx[i] > fNbinsCache[i])
+      return;
+
+    bin *= fNbinsCache[i];
+    bin += binIdx[i] - 1;
+  }
+
+  if (!values[istep])
+    values[istep] = new TemplateArray(fNBins);
+
+  // as in Fill: without sumw2 container all entries so far had weight 1, i.e. sumw2 == sumw
+  if (binSumw2 != binSumw && !sumw2[istep])
+    sumw2[istep] = new TemplateArray(*values[istep]);
+
+  values[istep]->GetArray()[bin] += binSumw;
+  if (sumw2[istep])
+    sumw2[istep]->GetArray()[bin] += binSumw2;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillBlock(TemplateArray** values, TemplateArray** sumw2, Int_t nPoints, const Double_t *varsSoA, Int_t istep, const Double_t *weights)
+{
+  // computes the global bin index for a block of entries axis by axis and fills them into <values> and <sumw2>
+  // does not use the last-bin caches and only reads the axes, so it can be called concurrently on different containers
+
+  const Int_t kBlockSize = 256;
+  Long64_t bins[kBlockSize];
+  Bool_t outside[kBlockSize];
+
+  for (Int_t offset=0; offset<nPoints; offset+=kBlockSize)
+  {
+    const Int_t n = TMath::Min(kBlockSize, nPoints - offset);
+
+    for (Int_t p=0; p<n; p++)
+    {
+      bins[p] = 0;
+      outside[p] = kFALSE;
+    }
+
+    for (Int_t i=0; i<fNVars; i++)
+    {
+      const Double_t* x = varsSoA + (Long64_t) i * nPoints + offset;
+      const Int_t nBins = fNbinsCache[i];
+      const TAxis* axis = axisCache[i];
+      const Double_t xMin = axis->GetXmin();
+      const Double_t xMax = axis->GetXmax();
+
+      if (axis->GetXbins()->fN == 0)
+      {
+        // fixed bins: same arithmetic as TAxis::FindFixBin, without branches on the bin search
+        for (Int_t p=0; p<n; p++)
+        {
+          Int_t tmpBin = (x[p] < xMin) ? 0 : ((!(x[p] < xMax)) ? nBins + 1 : 1 + Int_t(nBins*(x[p]-xMin)/(xMax-xMin)));
+          outside[p] |= (tmpBin < 1 || tmpBin > nBins);
+          bins[p] = bins[p] * nBins + tmpBin - 1;
+        }
+      }
+      else
+      {
+        const Double_t* edges = axis->GetXbins()->GetArray();
+        for (Int_t p=0; p<n; p++)
+        {
+          Int_t tmpBin = (x[p] < xMin) ? 0 : ((!(x[p] < xMax)) ? nBins + 1 : 1 + TMath::BinarySearch(nBins + 1, edges, x[p]));
+          outside[p] |= (tmpBin < 1 || tmpBin > nBins);
+          bins[p] = bins[p] * nBins + tmpBin - 1;
+        }
+      }
+    }
+
+    // under/overflow not supported
+    Int_t nInside = 0;
+    for (Int_t p=0; p<n; p++)
+      nInside += (outside[p]) ? 0 : 1;
+
+    if (nInside == 0)
+      continue;
+
+    if (!values[istep])
+      values[istep] = new TemplateArray(fNBins);
+
+    const Double_t* w = (weights) ? weights + offset : 0;
+
+    if (w && !sumw2[istep])
+    {
+      // same logic as in Fill: the entries filled so far all had weight 1, so sumw2 starts as a copy of the values
+      for (Int_t p=0; p<n; p++)
+      {
+        if (!outside[p] && w[p] != 1)
+        {
+          sumw2[istep] = new TemplateArray(*values[istep]);
+          break;
+        }
+      }
+    }
+
+    TemplateType* valueArray = values[istep]->GetArray();
+    TemplateType* sumw2Array = (sumw2[istep]) ? sumw2[istep]->GetArray() : 0;
+
+    for (Int_t p=0; p<n; p++)
+    {
+      if (outside[p])
+        continue;
+
+      const Double_t weight = (w) ? w[p] : 1.;
+      valueArray[bins[p]] += weight;
+      if (sumw2Array)
+        sumw2Array[bins[p]] += weight * weight;
+    }
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::SetNShards(Int_t nShards)
+{
+  // creates <nShards> independent fill buffers to be used with FillShard / FillNShard from different threads
+  // has to be called before the threads start filling; content of existing shards is merged first
+
+  MergeShards();
+  DeleteShards();
+
+  // initialize the axis cache here as the shards only read it
+  InitAxisCache();
+
+  if (nShards <= 0)
+    return;
+
+  fNShards = nShards;
+  fShardValues = new TemplateArray*[fNShards*fNSteps];
+  fShardSumw2 = new TemplateArray*[fNShards*fNSteps];
+  memset(fShardValues,0,fNShards*fNSteps*sizeof(TemplateArray*));
+  memset(fShardSumw2,0,fNShards*fNSteps*sizeof(TemplateArray*));
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillNShard(Int_t shard, Int_t nPoints, const Double_t *varsSoA, Int_t istep, const Double_t *weights)
+{
+  // fills <nPoints> entries into shard <shard>, see FillN for the layout of varsSoA
+  // different shards can be filled concurrently without locking
+
+  if (shard < 0 || shard >= fNShards)
+  {
+    AliFatal(Form("Shard %d requested but only %d shards exist. Call SetNShards first.", shard, fNShards));
+    return;
+  }
+
+  FillBlock(fShardValues + shard*fNSteps, fShardSumw2 + shard*fNSteps, nPoints, varsSoA, istep, weights);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillBinShard(Int_t shard, const Int_t *binIdx, Int_t istep, Double_t sumw, Double_t sumw2)
+{
+  // adds the sums of one bin into shard <shard>, see FillBin
+  // different shards can be filled concurrently without locking
+
+  if (shard < 0 || shard >= fNShards)
+  {
+    AliFatal(Form("Shard %d requested but only %d shards exist. Call SetNShards first.", shard, fNShards));
+    return;
+  }
+
+  FillBinTo(fShardValues + shard*fNSteps, fShardSumw2 + shard*fNSteps, binIdx, istep, sumw, sumw2);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::MergeShards()
+{
+  // adds the content of all shards to the main containers and resets the shards
+  
+  if (fNShards == 0)
+    return;
+
+  for (Int_t i=0; i<fNSteps; i++)
+  {
+    Bool_t anyValues = kFALSE;
+    Bool_t needSumw2 = (fSumw2[i] != 0);
+    for (Int_t s=0; s<fNShards; s++)
+    {
+      anyValues |= (fShardValues[s*fNSteps+i] != 0);
+      needSumw2 |= (fShardSumw2[s*fNSteps+i] != 0);
+    }
+
+    if (!anyValues)
+      continue;
+
+    if (!fValues[i])
+    {
+      fValues[i] = new TemplateArray(fNBins);
+      AliInfo(Form("Created values container for step %d", i));
+    }
+
+    if (needSumw2 && !fSumw2[i])
+    {
+      fSumw2[i] = new TemplateArray(*fValues[i]);
+      AliInfo(Form("Created sumw2 container for step %d", i));
+    }
+
+    TemplateType* target = fValues[i]->GetArray();
+    TemplateType* targetSumw2 = (fSumw2[i]) ? fSumw2[i]->GetArray() : 0;
+
+    for (Int_t s=0; s<fNShards; s++)
+    {
+      TemplateArray* values = fShardValues[s*fNSteps+i];
+      if (!values)
+        continue;
+
+      const TemplateType* source = values->GetArray();
+      for (Long64_t l = 0; l<fNBins; l++)
+        target[l] += source[l];
+
+      if (targetSumw2)
+      {
+        // shards without sumw2 have been filled with weight 1 only
+        const TemplateType* sourceSumw2 = (fShardSumw2[s*fNSteps+i]) ? fShardSumw2[s*fNSteps+i]->GetArray() : source;
+        for (Long64_t l = 0; l<fNBins; l++)
+          targetSumw2[l] += sourceSumw2[l];
+      }
+
+      delete values;
+      fShardValues[s*fNSteps+i] = 0;
+      delete fShardSumw2[s*fNSteps+i];
+      fShardSumw2[s*fNSteps+i] = 0;
+    }
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::DeleteShards()
+{
+  // deletes the shards without merging them
+
+  for (Int_t i=0; i<fNShards*fNSteps; i++)
+  {
+    delete fShardValues[i];
+    delete fShardSumw2[i];
+  }
+
+  delete[] fShardValues;
+  delete[] fShardSumw2;
+  fShardValues = 0;
+  fShardSumw2 = 0;
+  fNShards = 0;
+}
+
 template <class TemplateArray, typename TemplateType>
 Long64_t AliTHnT<TemplateArray, TemplateType>::GetGlobalBinIndex(const Int_t* binIdx)
 {
@@ -448,6 +763,7 @@ void AliTHnT<TemplateArray, TemplateType>::FillParent()
 {
   // fills the information stored in the buffer in this class into the baseclass containers
   
+  MergeShards();
   FillContainer(this);
 }
 
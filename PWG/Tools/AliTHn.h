@@ -48,7 +48,17 @@ class AliTHnT : public AliTHnBase
   virtual ~AliTHnT();
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) ;
+  void FillN(Int_t nPoints, const Double_t *varsSoA, Int_t istep, const Double_t *weights=0);
+  void FillBin(const Int_t *binIdx, Int_t istep, Double_t sumw, Double_t sumw2);
   virtual void FillParent();
+
+  // per-thread shards: each thread fills only its own shard, MergeShards() adds them up (call it in Terminate/FinishTaskOutput)
+  void SetNShards(Int_t nShards);
+  Int_t GetNShards() const { return fNShards; }
+  void FillShard(Int_t shard, const Double_t *var, Int_t istep, Double_t weight=1.) { FillNShard(shard, 1, var, istep, (weight != 1) ? &weight : 0); }
+  void FillNShard(Int_t shard, Int_t nPoints, const Double_t *varsSoA, Int_t istep, const Double_t *weights=0);
+  void FillBinShard(Int_t shard, const Int_t *binIdx, Int_t istep, Double_t sumw, Double_t sumw2);
+  void MergeShards();
   virtual void FillContainer(AliCFContainer* cont);
   
   virtual TArray* GetValues(Int_t step) { return fValues[step]; }
@@ -65,6 +75,10 @@ class AliTHnT : public AliTHnBase
   
 protected:
   void Init();
+  void InitAxisCache();
+  void FillBlock(TemplateArray** values, TemplateArray** sumw2, Int_t nPoints, const Double_t *varsSoA, Int_t istep, const Double_t *weights);
+  void FillBinTo(TemplateArray** values, TemplateArray** sumw2, const Int_t *binIdx, Int_t istep, Double_t binSumw, Double_t binSumw2);
+  void DeleteShards();
   Long64_t GetGlobalBinIndex(const Int_t* binIdx);
   
   Long64_t fNBins;   // number of total bins
@@ -77,6 +91,10 @@ protected:
   Int_t* fNbinsCache; //! cache Nbins per axis
   Double_t* fLastVars; //! caching of last used bins (in many loops some vars are the same for a while)
   Int_t* fLastBins; //! caching of last used bins (in many loops some vars are the same for a while)
+
+  Int_t fNShards;               //! number of per-thread shards
+  TemplateArray **fShardValues; //! [fNShards*fNSteps] shard data containers, merged by MergeShards()
+  TemplateArray **fShardSumw2;  //! [fNShards*fNSteps] shard sumw2 containers
   
   ClassDef(AliTHnT, 5) // THn like container
 };
@@ -625,6 +625,145 @@ void THistManager::FillProfile(const char* name, double x, double y, double weig
   hist->Fill(x, y, weight);
 }
 
+THistManager::Handle THistManager::GetHandle(const char *name, Option_t *opt) const {
+	TString dirname(basename(name)), hname(histname(name));
+	THashList *parent(FindGroup(dirname));
+	if(!parent){
+		Fatal("THistManager::GetHandle", "Parent group %s does not exist", dirname.Data());
+		return Handle();
+	}
+	TObject *obj = parent->FindObject(hname);
+	if(!obj){
+		Fatal("THistManager::GetHandle", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		return Handle();
+	}
+	Handle handle;
+	handle.fObject = obj;
+	if(obj->InheritsFrom(THnSparse::Class())) handle.fType = Handle::kTHnSparse;
+	else if(obj->InheritsFrom(TProfile::Class())) handle.fType = Handle::kTProfile;
+	else if(obj->InheritsFrom(TH3::Class())) handle.fType = Handle::kTH3;
+	else if(obj->InheritsFrom(TH2::Class())) handle.fType = Handle::kTH2;
+	else if(obj->InheritsFrom(TH1::Class())) handle.fType = Handle::kTH1;
+	else {
+		Fatal("THistManager::GetHandle", "Object %s is not of a histogram type", obj->GetName());
+		return Handle();
+	}
+
+	// decode the bin width correction once
+	TString optstring(opt);
+	handle.fBinWidthCorrection = optstring.Contains("w");
+	if(handle.fBinWidthCorrection){
+		if(handle.fType == Handle::kTH1 || handle.fType == Handle::kTProfile) handle.fWidthAxes = 1;
+		else if(handle.fType == Handle::kTHnSparse){
+			THnSparse *hist = static_cast<THnSparse *>(obj);
+			for(Int_t iaxis = 0; iaxis < hist->GetNdimensions() && iaxis < 32; iaxis++){
+				if(optstring.Contains(Form("w%d", iaxis))) handle.fWidthAxes |= (1 << iaxis);
+			}
+		} else {
+			if(optstring.Contains("wx")) handle.fWidthAxes |= 1;
+			if(optstring.Contains("wy")) handle.fWidthAxes |= 2;
+			if(optstring.Contains("wz") && handle.fType == Handle::kTH3) handle.fWidthAxes |= 4;
+		}
+	}
+	return handle;
+}
+
+void THistManager::CheckHandle(const Handle &handle, const char *method, Handle::HistType_t type) const {
+	if(!handle.fObject)
+		Fatal(method, "Invalid histogram handle");
+	// TH1 fills are accepted for all histograms derived from TH1, as in the name-based fill
+	bool typematch = (type == Handle::kTH1) ? handle.fType != Handle::kTHnSparse : handle.fType == type;
+	if(!typematch)
+		Fatal(method, "Histogram %s has the wrong type for this fill method", handle.fObject->GetName());
+}
+
+double THistManager::GetBinWidthWeight(const Handle &handle, const double *point, double weight) const {
+	if(!handle.fBinWidthCorrection) return weight;
+	double myweight = 1.;
+	for(int iaxis = 0; iaxis < 32; iaxis++){
+		if(!(handle.fWidthAxes & (1u << iaxis))) continue;
+		const TAxis *axis(nullptr);
+		if(handle.fType == Handle::kTHnSparse) axis = static_cast<THnSparse *>(handle.fObject)->GetAxis(iaxis);
+		else {
+			TH1 *hist = static_cast<TH1 *>(handle.fObject);
+			axis = (iaxis == 0) ? hist->GetXaxis() : ((iaxis == 1) ? hist->GetYaxis() : hist->GetZaxis());
+		}
+		// check if not overflow or underflow bin
+		Int_t bin = axis->FindFixBin(point[iaxis]);
+		if(bin > 0 && bin <= axis->GetNbins()) myweight *= 1./axis->GetBinWidth(bin);
+	}
+	return myweight;
+}
+
+void THistManager::FillTH1(const Handle &handle, double x, double weight) {
+	CheckHandle(handle, "THistManager::FillTH1", Handle::kTH1);
+	static_cast<TH1 *>(handle.fObject)->Fill(x, GetBinWidthWeight(handle, &x, weight));
+}
+
+void THistManager::FillTH2(const Handle &handle, double x, double y, double weight) {
+	CheckHandle(handle, "THistManager::FillTH2", Handle::kTH2);
+	double point[2] = {x, y};
+	static_cast<TH2 *>(handle.fObject)->Fill(x, y, GetBinWidthWeight(handle, point, weight));
+}
+
+void THistManager::FillTH3(const Handle &handle, double x, double y, double z, double weight) {
+	CheckHandle(handle, "THistManager::FillTH3", Handle::kTH3);
+	double point[3] = {x, y, z};
+	static_cast<TH3 *>(handle.fObject)->Fill(x, y, z, GetBinWidthWeight(handle, point, weight));
+}
+
+void THistManager::FillTHnSparse(const Handle &handle, const double *x, double weight) {
+	CheckHandle(handle, "THistManager::FillTHnSparse", Handle::kTHnSparse);
+	static_cast<THnSparse *>(handle.fObject)->Fill(x, GetBinWidthWeight(handle, x, weight));
+}
+
+void THistManager::FillProfile(const Handle &handle, double x, double y, double weight) {
+	CheckHandle(handle, "THistManager::FillProfile", Handle::kTProfile);
+	static_cast<TProfile *>(handle.fObject)->Fill(x, y, weight);
+}
+
+void THistManager::FillTH1N(const Handle &handle, int n, const double *x, const double *weights) {
+	CheckHandle(handle, "THistManager::FillTH1N", Handle::kTH1);
+	TH1 *hist = static_cast<TH1 *>(handle.fObject);
+	if(!handle.fBinWidthCorrection){
+		hist->FillN(n, x, weights);
+		return;
+	}
+	for(int ien = 0; ien < n; ien++) hist->Fill(x[ien], GetBinWidthWeight(handle, x + ien, 1.));
+}
+
+void THistManager::FillTH2N(const Handle &handle, int n, const double *x, const double *y, const double *weights) {
+	CheckHandle(handle, "THistManager::FillTH2N", Handle::kTH2);
+	TH2 *hist = static_cast<TH2 *>(handle.fObject);
+	if(!handle.fBinWidthCorrection){
+		hist->FillN(n, x, y, weights);
+		return;
+	}
+	double point[2];
+	for(int ien = 0; ien < n; ien++){
+		point[0] = x[ien];
+		point[1] = y[ien];
+		hist->Fill(x[ien], y[ien], GetBinWidthWeight(handle, point, 1.));
+	}
+}
+
+void THistManager::FillTH3N(const Handle &handle, int n, const double *x, const double *y, const double *z, const double *weights) {
+	CheckHandle(handle, "THistManager::FillTH3N", Handle::kTH3);
+	TH3 *hist = static_cast<TH3 *>(handle.fObject);
+	double point[3];
+	for(int ien = 0; ien < n; ien++){
+		point[0] = x[ien];
+		point[1] = y[ien];
+		point[2] = z[ien];
+		hist->Fill(x[ien], y[ien], z[ien], GetBinWidthWeight(handle, point, weights ? weights[ien] : 1.));
+	}
+}
+
+void THistManager::FillProfileN(const Handle &handle, int n, const double *x, const double *y, const double *weights) {
+	CheckHandle(handle, "THistManager::FillProfileN", Handle::kTProfile);
+	static_cast<TProfile *>(handle.fObject)->FillN(n, x, y, weights);
+}
+
 TObject *THistManager::FindObject(const char *name) const {
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
@@ -1030,6 +1169,69 @@ namespace TestTHistManager {
     return success ? 0 : 1;
   }
 
+  int THistManagerTestSuite::TestFillHandles(){
+    THistManager testmgr("testmgr");
+
+    testmgr.CreateTH1("Test1", "Test 1D", 1, 0., 1.);
+    testmgr.CreateTH2("Group1/Test2", "Test 2D", 1, 0., 1., 1, 0., 1.);
+    testmgr.CreateTH3("Group1/Test3", "Test 3D", 1, 0., 1., 1, 0., 1., 1, 0., 1.);
+    int nbins[4] = {1,1,1,1}; double min[4] = {0.,0.,0.,0.}, max[4] = {1.,1.,1.,1};
+    testmgr.CreateTHnSparse("Group2/Subgroup1/TestN", "Test ND", 4, nbins, min, max);
+    testmgr.CreateTProfile("TestProfile", "Test TProfile", 1, 0., 1.);
+
+    THistManager::Handle h1 = testmgr.GetHandle("Test1"),
+                         h2 = testmgr.GetHandle("Group1/Test2"),
+                         h3 = testmgr.GetHandle("Group1/Test3"),
+                         hN = testmgr.GetHandle("Group2/Subgroup1/TestN"),
+                         hProfile = testmgr.GetHandle("TestProfile");
+    if(!(h1.IsValid() && h2.IsValid() && h3.IsValid() && hN.IsValid() && hProfile.IsValid())){
+      std::cout << "Invalid handle" << std::endl;
+      return 1;
+    }
+
+    std::vector<double> values(50, 0.5);
+    double point[4] = {0.5, 0.5, 0.5, 0.5};
+    for(int i = 0; i < 2; i++){
+      testmgr.FillTH1N(h1, values.size(), values.data());
+      testmgr.FillTH2N(h2, values.size(), values.data(), values.data());
+    }
+    for(int i = 0; i < 100; i++){
+      testmgr.FillTH3(h3, 0.5, 0.5, 0.5);
+      testmgr.FillTHnSparse(hN, point);
+      testmgr.FillProfile(hProfile, 0.5, 1);
+    }
+
+    // Evaluate test
+    bool success(true);
+    TH1 *test1 = dynamic_cast<TH1 *>(testmgr.FindObject("Test1"));
+    if(!test1 || TMath::Abs(test1->GetBinContent(1) - 100) > DBL_EPSILON){
+      std::cout << "Test1: Mismatch in values, expected 100" << std::endl;
+      success = false;
+    }
+    TH2 *test2 = dynamic_cast<TH2 *>(testmgr.FindObject("Group1/Test2"));
+    if(!test2 || TMath::Abs(test2->GetBinContent(1, 1) - 100) > DBL_EPSILON){
+      std::cout << "Group1/Test2: Mismatch in values, expected 100" << std::endl;
+      success = false;
+    }
+    TH3 *test3 = dynamic_cast<TH3 *>(testmgr.FindObject("Group1/Test3"));
+    if(!test3 || TMath::Abs(test3->GetBinContent(1, 1, 1) - 100) > DBL_EPSILON){
+      std::cout << "Group1/Test3: Mismatch in values, expected 100" << std::endl;
+      success = false;
+    }
+    THnSparse *testN = dynamic_cast<THnSparse *>(testmgr.FindObject("Group2/Subgroup1/TestN"));
+    int index[4] = {1,1,1,1};
+    if(!testN || TMath::Abs(testN->GetBinContent(index) - 100) > DBL_EPSILON){
+      std::cout << "Group2/Subgroup1/TestN: Mismatch in values, expected 100" << std::endl;
+      success = false;
+    }
+    TProfile *testProfile = dynamic_cast<TProfile *>(testmgr.FindObject("TestProfile"));
+    if(!testProfile || TMath::Abs(testProfile->GetBinContent(1) - 1) > DBL_EPSILON){
+      std::cout << "TestProfile: Mismatch in values, expected 1" << std::endl;
+      success = false;
+    }
+    return success ? 0 : 1;
+  }
+
   int TestRunAll(){
     int testresult(0);
     THistManagerTestSuite testsuite;
@@ -1050,6 +1252,10 @@ namespace TestTHistManager {
     testresult += testsuite.TestFillGroupedHistograms();
     std::cout << "Result after test: " << testresult << std::endl;
 
+    std::cout << "Running test: Fill Handles" << std::endl;
+    testresult += testsuite.TestFillHandles();
+    std::cout << "Result after test: " << testresult << std::endl;
+
     return testresult;
   }
 
@@ -1072,4 +1278,9 @@ namespace TestTHistManager {
     THistManagerTestSuite testsuite;
     return testsuite.TestFillGroupedHistograms();
   }
+
+  int TestRunFillHandles(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestFillHandles();
+  }
 }
@@ -95,6 +95,19 @@ class TProfile;
  * an argument for options. Automatic correction for the bin width is done when
  * specifying the argument *W*, followed by the direction. Adding multiple directions
  * the weight is calculated for all directions at the same time.
+ * # Filling histograms via handles
+ * In loops over tracks or clusters the lookup of the histogram by name can
+ * dominate the time spent in the Fill methods. A @ref Handle can be requested
+ * once, i.e. in UserCreateOutputObjects, and be used in the Fill methods
+ * instead of the histogram name. Options are parsed when the handle is created.
+ * Arrays of values can be filled at once using the FillTH1N, FillTH2N, FillTH3N
+ * and FillProfileN methods.
+ * ~~~{.cxx}
+ * THistManager::Handle hpt = mgr.GetHandle("hPt");
+ * for(auto en : ROOT::TSeqI(0, 10000) {
+ *   mgr.FillTH1(hpt, gRandom->Exp(-1));
+ * }
+ * ~~~
  */
 class THistManager : public TNamed {
 public:
@@ -229,6 +242,64 @@ public:
     iterator();
   };
 
+  /**
+   * @class Handle
+   * @brief Direct reference to a histogram inside the histogram manager
+   * @ingroup Histmanager
+   *
+   * Handles are obtained via THistManager::GetHandle. They keep the pointer
+   * to the histogram and the decoded fill options, so filling via a handle
+   * neither needs to search the histogram in the groups nor to parse the
+   * option string. A handle stays valid as long as the histogram manager
+   * owning the histogram exists.
+   */
+  class Handle {
+  public:
+    /**
+     * @enum HistType_t
+     * @brief Type of the histogram the handle points to
+     */
+    enum HistType_t {
+      kUndefined = 0,     //!< Invalid handle
+      kTH1 = 1,           //!< 1D histogram
+      kTH2 = 2,           //!< 2D histogram
+      kTH3 = 3,           //!< 3D histogram
+      kTHnSparse = 4,     //!< Sparse n-dimensional histogram
+      kTProfile = 5       //!< Profile histogram
+    };
+
+    /**
+     * @brief Default constructor, creating an invalid handle
+     */
+    Handle(): fObject(nullptr), fType(kUndefined), fBinWidthCorrection(false), fWidthAxes(0) { }
+
+    /**
+     * @brief Check whether the handle points to a histogram
+     * @return True if the handle is valid
+     */
+    bool IsValid() const { return fObject != nullptr; }
+
+    /**
+     * @brief Get the histogram the handle points to
+     * @return Histogram (NULL for invalid handles)
+     */
+    TObject *GetObject() const { return fObject; }
+
+    /**
+     * @brief Get the type of the histogram the handle points to
+     * @return Histogram type
+     */
+    HistType_t GetType() const { return fType; }
+
+  private:
+    friend class THistManager;
+
+    TObject                     *fObject;             ///< Histogram the handle points to
+    HistType_t                  fType;                ///< Type of the histogram
+    bool                        fBinWidthCorrection;  ///< Option w: the weight is replaced by the bin width correction
+    unsigned int                fWidthAxes;           ///< Bit mask of axes included in the bin width correction
+  };
+
   /**
    * @brief Default constructor.
    *
@@ -634,6 +705,103 @@ public:
 	 */
   void FillProfile(const char *name, double x, double y, double weight = 1.);
 
+  /**
+   * @brief Create a handle for a histogram within the container.
+   *
+   * The histogram name also contains the parent group(s)
+   * according to the common group notation. Fill options
+   * (bin width correction) are given when creating the handle
+   * and apply to all fills done via the handle.
+   * @param[in] name Name of the histogram
+   * @param[in] opt Optional filling arguments
+   * @return Handle to the histogram
+   */
+  Handle GetHandle(const char *name, Option_t *opt = "") const;
+
+  /**
+   * @brief Fill a 1D histogram via its handle.
+   * @param[in] handle Handle of the histogram
+   * @param[in] x x-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void FillTH1(const Handle &handle, double x, double weight = 1.);
+
+  /**
+   * @brief Fill a 2D histogram via its handle.
+   * @param[in] handle Handle of the histogram
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void FillTH2(const Handle &handle, double x, double y, double weight = 1.);
+
+  /**
+   * @brief Fill a 3D histogram via its handle.
+   * @param[in] handle Handle of the histogram
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] z z-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void FillTH3(const Handle &handle, double x, double y, double z, double weight = 1.);
+
+  /**
+   * @brief Fill a nD histogram via its handle.
+   * @param[in] handle Handle of the histogram
+   * @param[in] x coordinates of the data
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void FillTHnSparse(const Handle &handle, const double *x, double weight = 1.);
+
+  /**
+   * @brief Fill a profile histogram via its handle.
+   * @param[in] handle Handle of the profile histogram
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void FillProfile(const Handle &handle, double x, double y, double weight = 1.);
+
+  /**
+   * @brief Fill a 1D histogram with an array of values.
+   * @param[in] handle Handle of the histogram
+   * @param[in] n Number of entries
+   * @param[in] x x-coordinates
+   * @param[in] weights optional weights of the entries (NULL: weight 1)
+   */
+  void FillTH1N(const Handle &handle, int n, const double *x, const double *weights = nullptr);
+
+  /**
+   * @brief Fill a 2D histogram with arrays of values.
+   * @param[in] handle Handle of the histogram
+   * @param[in] n Number of entries
+   * @param[in] x x-coordinates
+   * @param[in] y y-coordinates
+   * @param[in] weights optional weights of the entries (NULL: weight 1)
+   */
+  void FillTH2N(const Handle &handle, int n, const double *x, const double *y, const double *weights = nullptr);
+
+  /**
+   * @brief Fill a 3D histogram with arrays of values.
+   * @param[in] handle Handle of the histogram
+   * @param[in] n Number of entries
+   * @param[in] x x-coordinates
+   * @param[in] y y-coordinates
+   * @param[in] z z-coordinates
+   * @param[in] weights optional weights of the entries (NULL: weight 1)
+   */
+  void FillTH3N(const Handle &handle, int n, const double *x, const double *y, const double *z, const double *weights = nullptr);
+
+  /**
+   * @brief Fill a profile histogram with arrays of values.
+   * @param[in] handle Handle of the profile histogram
+   * @param[in] n Number of entries
+   * @param[in] x x-coordinates
+   * @param[in] y y-coordinates
+   * @param[in] weights optional weights of the entries (NULL: weight 1)
+   */
+  void FillProfileN(const Handle &handle, int n, const double *x, const double *y, const double *weights = nullptr);
+
   /**
    * @brief Create forward iterator starting at the beginning of the
    * container
@@ -719,6 +887,25 @@ private:
 	 */
 	TString histname(const TString &path) const;
 
+	/**
+	 * @brief Check whether the handle points to a histogram of the expected type
+	 *
+	 * Fatal in case of mismatch
+	 * @param[in] handle Handle to check
+	 * @param[in] method Name of the calling method
+	 * @param[in] type Expected histogram type
+	 */
+	void CheckHandle(const Handle &handle, const char *method, Handle::HistType_t type) const;
+
+	/**
+	 * @brief Calculate the weight for the bin width correction of the handle
+	 * @param[in] handle Handle of the histogram
+	 * @param[in] point Coordinates of the entry
+	 * @param[in] weight User weight of the entry
+	 * @return Weight to be used for the entry
+	 */
+	double GetBinWidthWeight(const Handle &handle, const double *point, double weight) const;
+
 	THashList *fHistos;                   ///< List of histograms
 	bool fIsOwner;                        ///< Set the ownership
 
@@ -845,6 +1032,21 @@ public:
    * @return 0 if test is passed, 1 if it failed
    */
   int TestFillGroupedHistograms();
+
+  /**
+   * Purpose of the test: Check whether filling via handles and bulk filling is correctly propagated
+   * Relies on: TestBuildSimpleHistograms, TestBuildGroupedHistograms
+   *
+   * Creating histograms of all types, partly in groups, with 1 bin per dimension.
+   * Fill each of them 100 times via handles, where TH1 and TH2 are filled with
+   * arrays of 50 values twice.
+   *
+   * Test passed:
+   * - All handles are valid
+   * - All histograms need to have in its 1 bin the bin content 100 (1 for the profile)
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestFillHandles();
 };
 
 /**
@@ -882,5 +1084,12 @@ int TestRunFillSimple();
  */
 int TestRunFillGrouped();
 
+/**
+ * Run the test for filling histograms via handles. See @ref THistManagerTestSuite
+ * for details.
+ * @return 0 if test is passed, 1 if failed
+ */
+int TestRunFillHandles();
+
 }
 #endif
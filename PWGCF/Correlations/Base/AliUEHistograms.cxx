@@ -37,8 +37,23 @@
 #include "TMath.h"
 #include "TLorentzVector.h"
 
+#include <vector>
+
 ClassImp(AliUEHistograms)
 
+namespace {
+  // per-particle quantities of the two-track efficiency cut in FillCorrelations
+  struct TwoTrackParticle {
+    Float_t phi;
+    Float_t pt;
+    Float_t charge;
+    Double_t termMin;     // curvature term at fTwoTrackCutMinRadius
+    Double_t termMax;     // curvature term at 2.5 m
+    Double_t deflection;  // largest |curvature term| between these radii, -1 if not defined (asin argument above 1)
+    Int_t scanOffset;     // first term of the radius scan in the term pool, -1 if not computed yet
+  };
+}
+
 const Int_t AliUEHistograms::fgkUEHists = 3;
 
 AliUEHistograms::AliUEHistograms(const char* name, const char* histograms, const char* binning) : 
@@ -597,6 +612,39 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
   for (Int_t i=0; i<input->GetEntriesFast(); i++)
     eta[i] = ((AliVParticle*) input->UncheckedAt(i))->Eta();
   
+  // the curvature terms of dphistar (two-track efficiency cut) only depend on the single particle, therefore compute them once per particle
+  // the terms of the radius scan are only needed for close pairs and are computed on first use
+  std::vector<TwoTrackParticle> twoTrack[2]; // trigger particles, associated particles from the mixed event
+  std::vector<Float_t> twoTrackRadii;
+  std::vector<Double_t> twoTrackScanTerms;
+  if (particles && twoTrackEfficiencyCut)
+  {
+    for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01) 
+      twoTrackRadii.push_back(rad);
+    
+    const Float_t maxRadius = TMath::Max(fTwoTrackCutMinRadius, (Float_t) 2.5);
+    for (Int_t set=0; set<((mixed) ? 2 : 1); set++)
+    {
+      TObjArray* array = (set == 0) ? particles : mixed;
+      twoTrack[set].resize(array->GetEntriesFast());
+      for (Int_t i=0; i<array->GetEntriesFast(); i++)
+      {
+        AliVParticle* particle = (AliVParticle*) array->UncheckedAt(i);
+        TwoTrackParticle& track = twoTrack[set][i];
+        
+        track.phi = particle->Phi();
+        track.pt = particle->Pt();
+        track.charge = particle->Charge();
+        track.termMin = GetDPhiStarTerm(track.pt, track.charge, fTwoTrackCutMinRadius, bSign);
+        track.termMax = GetDPhiStarTerm(track.pt, track.charge, 2.5, bSign);
+        track.deflection = -1;
+        if (track.pt > 0 && fTwoTrackCutMinRadius >= 0 && 0.075 * maxRadius / track.pt <= 1)
+          track.deflection = TMath::Abs(track.charge * bSign) * TMath::ASin(0.075 * maxRadius / track.pt);
+        track.scanOffset = -1;
+      }
+    }
+  }
+  
   // if particles is not set, just fill event statistics
   if (particles)
   {
@@ -920,32 +968,56 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  // the variables & cuthave been developed by the HBT group 
 	  // see e.g. https://indico.cern.ch/materialDisplay.py?contribId=36&sessionId=6&materialId=slides&confId=142700
 
-	  Float_t phi1 = triggerParticle->Phi();
-	  Float_t pt1 = triggerParticle->Pt();
-	  Float_t charge1 = triggerParticle->Charge();
+	  TwoTrackParticle& track1 = twoTrack[0][i];
+	  TwoTrackParticle& track2 = twoTrack[(mixed) ? 1 : 0][j];
+	  
+	  Float_t phi1 = track1.phi;
+	  Float_t pt1 = track1.pt;
 	    
-	  Float_t phi2 = particle->Phi();
-	  Float_t pt2 = particle->Pt();
-	  Float_t charge2 = particle->Charge();
+	  Float_t phi2 = track2.phi;
+	  Float_t pt2 = track2.pt;
 	      
 	  Float_t deta = triggerEta - eta[j];
 	      
+	  const Float_t kLimit = twoTrackEfficiencyCutValue * 3;
+	  
+	  // analytic bound: between the two radii dphistar moves away from phi1 - phi2 by at most the sum of the deflections. 
+	  // If this keeps the pair outside of kLimit (with some margin for rounding), neither boundary can be inside and dphistar cannot change sign in between
+	  Bool_t farApart = kFALSE;
+	  if (track1.deflection >= 0 && track2.deflection >= 0 && TMath::Abs(phi1 - phi2) < 2 * TMath::Pi())
+	  {
+	    Double_t dphi = TMath::Abs(phi1 - phi2);
+	    if (dphi > TMath::Pi())
+	      dphi = 2 * TMath::Pi() - dphi;
+	    farApart = (dphi - track1.deflection - track2.deflection > kLimit + 1e-4);
+	  }
+	  
 	  // optimization
-	  if (TMath::Abs(deta) < twoTrackEfficiencyCutValue * 2.5 * 3)
+	  if (!farApart && TMath::Abs(deta) < twoTrackEfficiencyCutValue * 2.5 * 3)
 	  {
 	    // check first boundaries to see if is worth to loop and find the minimum
-	    Float_t dphistar1 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, fTwoTrackCutMinRadius, bSign);
-	    Float_t dphistar2 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, 2.5, bSign);
+	    Float_t dphistar1 = GetDPhiStar(phi1, track1.termMin, phi2, track2.termMin);
+	    Float_t dphistar2 = GetDPhiStar(phi1, track1.termMax, phi2, track2.termMax);
 	    
-	    const Float_t kLimit = twoTrackEfficiencyCutValue * 3;
-
 	    Float_t dphistarminabs = 1e5;
 	    Float_t dphistarmin = 1e5;
 	    if (TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0)
 	    {
-	      for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01) 
+	      TwoTrackParticle* tracks[2] = { &track1, &track2 };
+	      for (Int_t k=0; k<2; k++)
+	      {
+		if (tracks[k]->scanOffset >= 0)
+		  continue;
+		tracks[k]->scanOffset = twoTrackScanTerms.size();
+		for (UInt_t r=0; r<twoTrackRadii.size(); r++)
+		  twoTrackScanTerms.push_back(GetDPhiStarTerm(tracks[k]->pt, tracks[k]->charge, twoTrackRadii[r], bSign));
+	      }
+	      const Double_t* terms1 = twoTrackScanTerms.data() + track1.scanOffset;
+	      const Double_t* terms2 = twoTrackScanTerms.data() + track2.scanOffset;
+	      
+	      for (UInt_t r=0; r<twoTrackRadii.size(); r++) 
 	      {
-		Float_t dphistar = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, rad, bSign);
+		Float_t dphistar = GetDPhiStar(phi1, terms1[r], phi2, terms2[r]);
 
 		Float_t dphistarabs = TMath::Abs(dphistar);
 		
@@ -123,6 +123,8 @@ protected:
   inline Float_t GetInvMassSquared(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
   inline Float_t GetInvMassSquaredCheap(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
   inline Float_t GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign);
+  inline Float_t GetDPhiStar(Float_t phi1, Double_t term1, Float_t phi2, Double_t term2);
+  inline Double_t GetDPhiStarTerm(Float_t pt, Float_t charge, Float_t radius, Float_t bSign);
   
   static const Int_t fgkUEHists; // number of histograms
 
@@ -191,7 +193,25 @@ Float_t AliUEHistograms::GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1,
   // calculates dphistar
   //
   
-  Float_t dphistar = phi1 - phi2 - charge1 * bSign * TMath::ASin(0.075 * radius / pt1) + charge2 * bSign * TMath::ASin(0.075 * radius / pt2);
+  return GetDPhiStar(phi1, GetDPhiStarTerm(pt1, charge1, radius, bSign), phi2, GetDPhiStarTerm(pt2, charge2, radius, bSign));
+}
+
+Double_t AliUEHistograms::GetDPhiStarTerm(Float_t pt, Float_t charge, Float_t radius, Float_t bSign)
+{ 
+  //
+  // curvature term of dphistar for a single particle at the given radius
+  //
+  
+  return charge * bSign * TMath::ASin(0.075 * radius / pt);
+}
+
+Float_t AliUEHistograms::GetDPhiStar(Float_t phi1, Double_t term1, Float_t phi2, Double_t term2)
+{ 
+  //
+  // calculates dphistar from the curvature terms of the two particles (see GetDPhiStarTerm)
+  //
+  
+  Float_t dphistar = phi1 - phi2 - term1 + term2;
   
   static const Double_t kPi = TMath::Pi();
   
@@ -21,6 +21,8 @@
 
 
 //ROOT
+#include <algorithm>
+#include <cmath>
 #include <Riostream.h>
 #include <TCanvas.h>
 #include <TMath.h>
@@ -95,9 +97,15 @@ AliBalancePsi::AliBalancePsi() :
   fQCut(kFALSE),
   fDeltaPtMin(0.0),
   fVertexBinning(kFALSE),
+  fBinnedPairs(kFALSE),
+  fBinnedPairsGranularity(1),
   fCustomBinning(""),
   fBinningString(""),
-  fEventClass("EventPlane"){
+  fEventClass("EventPlane"),
+  fPairSumw(),
+  fPairSumw2(),
+  fPairFilled(),
+  fPairBins(){
   // Default constructor
 }
 
@@ -148,9 +156,15 @@ AliBalancePsi::AliBalancePsi(const AliBalancePsi& balance):
   fQCut(balance.fQCut),
   fDeltaPtMin(balance.fDeltaPtMin),
   fVertexBinning(balance.fVertexBinning),
+  fBinnedPairs(balance.fBinnedPairs),
+  fBinnedPairsGranularity(balance.fBinnedPairsGranularity),
   fCustomBinning(balance.fCustomBinning),
   fBinningString(balance.fBinningString),
-  fEventClass("EventPlane"){
+  fEventClass("EventPlane"),
+  fPairSumw(),
+  fPairSumw2(),
+  fPairFilled(),
+  fPairBins(){
   //copy constructor
 }
 
@@ -462,6 +476,12 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
   if (particlesMixed)
     jMax = particlesMixed->GetEntriesFast();
 
+  // pairs summed per bin (only if no cut needs more than the pair kinematics)
+  if (fBinnedPairs && !fResonancesCut && !fResonancePhiCut && !fResonancesLabelCut && !fSameLabelMCCut && !fQCut){
+    if (CalculateBalanceBinned(gReactionPlane, particles, particlesMixed, bSign, kMultorCent, vertexZ))
+      return;
+  }
+
   // Eta() is extremely time consuming, therefore cache it for the inner loop here:
   TObjArray* particlesSecond = (particlesMixed) ? particlesMixed : particles;
 
@@ -526,26 +546,8 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
     continue;
 
     // Event plane (determine psi bin)
-    Double_t gPsiMinusPhi    =   0.;
-    Double_t gPsiMinusPhiBin = -10.;
-    gPsiMinusPhi   = TMath::Abs(firstPhi - gReactionPlane);
-    //in-plane
-    if((gPsiMinusPhi <= 7.5*TMath::DegToRad())||
-       ((172.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 187.5*TMath::DegToRad())))
-      gPsiMinusPhiBin = 0.0;
-    //intermediate
-    else if(((37.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 52.5*TMath::DegToRad()))||
-	    ((127.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 142.5*TMath::DegToRad()))||
-	    ((217.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 232.5*TMath::DegToRad()))||
-	    ((307.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 322.5*TMath::DegToRad())))
-      gPsiMinusPhiBin = 1.0;
-    //out of plane
-    else if(((82.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 97.5*TMath::DegToRad()))||
-	    ((262.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 277.5*TMath::DegToRad())))
-      gPsiMinusPhiBin = 2.0;
-    //everything else
-    else 
-      gPsiMinusPhiBin = 3.0;
+    Double_t gPsiMinusPhi    =   TMath::Abs(firstPhi - gReactionPlane);
+    Double_t gPsiMinusPhiBin = GetPsiMinusPhiBin(gPsiMinusPhi);
     
     fHistPsiMinusPhi->Fill(gPsiMinusPhiBin,gPsiMinusPhi);
 
@@ -672,61 +674,8 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
 	//if( dphi < 3 || deta < 0.01 ){   // VERSION 1
 	//  continue;
 	
-	Double_t deta = firstEta - secondEta[j];
-	Double_t dphi = firstPhi - secondPhi[j];
-	if(dphi > TMath::Pi())
-	  dphi = secondPhi[j] - firstPhi;
-
-	// for QA: get dphistar in the middle of the TPC R = 1.65
-	Float_t  dphistarMiddle = GetDPhiStar(firstPhi, firstPt, charge1, secondPhi[j], secondPt[j], charge2, 1.65, bSign);
-
-	// VERSION 2 (Taken from DPhiCorrelations)
-	// the variables & cuthave been developed by the HBT group 
-	// see e.g. https://indico.cern.ch/materialDisplay.py?contribId=36&sessionId=6&materialId=slides&confId=142700
-	fHistHBTbefore->Fill(deta,dphi);
-	fHistPhiStarHBTbefore->Fill(deta,dphistarMiddle);
-	
-	// optimization
-	if (TMath::Abs(deta) < fHBTCutValue * 2.5 * 3) //fHBTCutValue = 0.02 [default for dphicorrelations]
-	  {
-	    // phi in rad
-	    //Float_t phi1rad = firstPhi*TMath::DegToRad();
-	    //Float_t phi2rad = secondPhi[j]*TMath::DegToRad();
-	    Float_t phi1rad = firstPhi;
-	    Float_t phi2rad = secondPhi[j];
-	    
-	    // check first boundaries to see if is worth to loop and find the minimum
-	    Float_t dphistar1 = GetDPhiStar(phi1rad, firstPt, charge1, phi2rad, secondPt[j], charge2, 0.8, bSign);
-	    Float_t dphistar2 = GetDPhiStar(phi1rad, firstPt, charge1, phi2rad, secondPt[j], charge2, 2.5, bSign);
-	    
-	    const Float_t kLimit = fHBTCutValue * 3;
-
-	    // Printf("typical values: deta =%f dphistar1 0.8= %f,  dphistar2 2.5 =%f, kLimit =%f ", deta, dphistar1,  dphistar2, kLimit ); 
-	    
-	    Float_t dphistarminabs = 1e5;
-	    //Float_t dphistarmin = 1e5;
-	    
-	    if (TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0 ) {
-	      for (Double_t rad=0.8; rad<2.51; rad+=0.01) {
-		Float_t dphistar = GetDPhiStar(phi1rad, firstPt, charge1, phi2rad, secondPt[j], charge2, rad, bSign);
-		//Printf("inside loop r = %f, dphistar = %f", rad,  dphistar); 
-			    
-		Float_t dphistarabs = TMath::Abs(dphistar);
-		
-		if (dphistarabs < dphistarminabs) {
-		  //dphistarmin = dphistar;
-		  dphistarminabs = dphistarabs;
-		}
-	      }
-	      
-	      if (dphistarminabs < fHBTCutValue && TMath::Abs(deta) < fHBTCutValue) {
-		//AliInfo(Form("HBT: Removed track pair %d %d with [[%f %f]] %f %f %f | %f %f %d %f %f %d %f", i, j, deta, dphi, dphistarminabs, dphistar1, dphistar2, phi1rad, pt1, charge1, phi2rad, pt2, charge2, bSign));
-		continue;
-	      }
-	    }
-	  }
-	fHistHBTafter->Fill(deta,dphi);
-	fHistPhiStarHBTafter->Fill(deta,dphistarMiddle);
+	if(IsHBTPair(firstEta, firstPhi, firstPt, charge1, secondEta[j], secondPhi[j], secondPt[j], charge2, bSign))
+	  continue;
       }//HBT cut
 
       if (!particlesMixed && fSameLabelMCCut){
@@ -748,37 +697,8 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
       // conversions
       if(fConversionCut) {
 	if (charge1 * charge2 < 0) {
-	  Double_t deta = firstEta - secondEta[j];
-	  Double_t dphi = firstPhi - secondPhi[j];
-	  
-	  Float_t m0 = 0.510e-3;
-	  Float_t tantheta1 = 1e10;
-	  
-	  // phi in rad
-	  //Float_t phi1rad = firstPhi*TMath::DegToRad();
-	  //Float_t phi2rad = secondPhi[j]*TMath::DegToRad();
-	  Float_t phi1rad = firstPhi;
-	  Float_t phi2rad = secondPhi[j];
-	  
-	  if (firstEta < -1e-10 || firstEta > 1e-10)
-	    tantheta1 = 2 * TMath::Exp(-firstEta) / ( 1 - TMath::Exp(-2*firstEta));
-	  
-	  Float_t tantheta2 = 1e10;
-	  if (secondEta[j] < -1e-10 || secondEta[j] > 1e-10)
-	    tantheta2 = 2 * TMath::Exp(-secondEta[j]) / ( 1 - TMath::Exp(-2*secondEta[j]));
-	  
-	  Float_t e1squ = m0 * m0 + firstPt * firstPt * (1.0 + 1.0 / tantheta1 / tantheta1);
-	  Float_t e2squ = m0 * m0 + secondPt[j] * secondPt[j] * (1.0 + 1.0 / tantheta2 / tantheta2);
-	  
-	  Float_t masssqu = 2 * m0 * m0 + 2 * ( TMath::Sqrt(e1squ * e2squ) - ( firstPt * secondPt[j] * ( TMath::Cos(phi1rad - phi2rad) + 1.0 / tantheta1 / tantheta2 ) ) );
-
-	  fHistConversionbefore->Fill(deta,dphi,masssqu);
-	  
-	  if (masssqu < fInvMassCutConversion*fInvMassCutConversion){
-	    //AliInfo(Form("Conversion: Removed track pair %d %d with [[%f %f] %f %f] %d %d <- %f %f  %f %f   %f %f ", i, j, deta, dphi, masssqu, charge1, charge2,eta1,eta2,phi1,phi2,pt1,pt2));
+	  if(IsConversionPair(firstEta, firstPhi, firstPt, secondEta[j], secondPhi[j], secondPt[j]))
 	    continue;
-	  }
-	  fHistConversionafter->Fill(deta,dphi,masssqu);
 	}
       }//conversion cut
 
@@ -806,6 +726,562 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
   }//end of 1st particle loop
 }  
 
+//____________________________________________________________________//
+static Double_t TriangleFraction(Double_t center, Double_t halfWidth, Double_t low, Double_t high) {
+  // Fraction of a triangular distribution (peak at center, zero at center -+ halfWidth) in [low, high):
+  // distribution of the difference of two values uniformly distributed in cells of width halfWidth
+  Double_t cdf[2];
+  const Double_t edge[2] = {low, high};
+  for (Int_t k=0; k<2; k++){
+    const Double_t u = (edge[k] - center)/halfWidth;
+    if (u <= -1.)     cdf[k] = 0.;
+    else if (u >= 1.) cdf[k] = 1.;
+    else if (u <= 0.) cdf[k] = 0.5*(1.+u)*(1.+u);
+    else              cdf[k] = 1. - 0.5*(1.-u)*(1.-u);
+  }
+  return cdf[1] - cdf[0];
+}
+
+//____________________________________________________________________//
+Bool_t AliBalancePsi::CalculateBalanceBinned(Double_t gReactionPlane,
+					     TObjArray *particles,
+					     TObjArray *particlesMixed,
+					     Float_t bSign,
+					     Double_t kMultorCent,
+					     Double_t vertexZ) {
+  // Pair histograms from the correlation of eta-phi grids of the particles instead of the pair loop of
+  // CalculateBalance (without resonance, MC label and momentum difference cuts):
+  // - the charged triggers are grouped by their (event class, pT trigger, charge) bin, the charged associated
+  //   particles by their (charge, pT associated) class, and both are summed in eta-phi cells of width
+  //   (smallest delta eta or delta phi bin width)/fBinnedPairsGranularity
+  // - a pair of cells contributes W1*W2 to the sum of weights and Q1*Q2 to the sum of squared weights
+  //   (W, Q: sums of the corrections and of their squares in the cell). Its delta eta and delta phi follow
+  //   a triangular distribution over +-1 cell width, split among the delta eta and delta phi bins it
+  //   overlaps: the contents are smeared by up to one cell width, not filled at the exact pair values
+  // - with momentum ordering the particles are split in pT slices (the pT trigger bin edges, more in dense
+  //   events): a pair with the associated particle in a lower slice always passes the ordering, the pairs
+  //   within a slice are done pair by pair
+  // - (group, slice, class) combinations with fewer pairs than occupied cell pairs are done pair by pair
+  // - the pairs of a trigger that the HBT or conversion cuts can remove lie in an eta-phi window around it:
+  //   they are checked one by one and the removed ones subtracted again from the cell correlation.
+  //   The QA histograms of these cuts are only filled for the pairs in this window and the ones done
+  //   pair by pair, not for every pair as in CalculateBalance
+  // The time of the cell correlation depends on the number of occupied cells, not on the number of pairs.
+  // Returns kFALSE with nothing filled if the event cannot be binned (non finite eta or phi, too many cells):
+  // the caller has to use the pair loop then.
+
+  Double_t trackVariablesSingle[kTrackVariablesSingle];
+
+  Int_t iMax = particles->GetEntriesFast();
+  Int_t jMax = iMax;
+  if (particlesMixed)
+    jMax = particlesMixed->GetEntriesFast();
+  TObjArray* particlesSecond = (particlesMixed) ? particlesMixed : particles;
+
+  // binning of the pair histograms (the same for all charge combinations)
+  TAxis *axisEventClass = fHistPN->GetAxis(0,0);
+  TAxis *axisDeltaEta   = fHistPN->GetAxis(1,0);
+  TAxis *axisDeltaPhi   = fHistPN->GetAxis(2,0);
+  TAxis *axisPtTrig     = fHistPN->GetAxis(3,0);
+  TAxis *axisPtAssoc    = fHistPN->GetAxis(4,0);
+  const Int_t nEventClass = axisEventClass->GetNbins();
+  const Int_t nDeltaEta   = axisDeltaEta->GetNbins();
+  const Int_t nDeltaPhi   = axisDeltaPhi->GetNbins();
+  const Int_t nPtTrig     = axisPtTrig->GetNbins();
+  const Int_t nPtAssoc    = axisPtAssoc->GetNbins();
+  const Int_t nClasses    = 2*nPtAssoc;
+  const Int_t vertexBin   = fHistPN->GetAxis(5,0)->FindBin(vertexZ);
+  const Bool_t vertexInRange = (vertexBin >= 1 && vertexBin <= fHistPN->GetAxis(5,0)->GetNbins());
+
+  // associated particles in the pair histograms: class = (charge, pT associated bin)
+  TArrayF secondEta(jMax);
+  TArrayF secondPhi(jMax);
+  TArrayF secondPt(jMax);
+  TArrayS secondCharge(jMax);
+  TArrayD secondCorrection(jMax);
+  vector<Int_t> assocClass(jMax, -1);
+  vector<Int_t> associated;
+  associated.reserve(jMax);
+
+  Double_t etaLow = 0., etaHigh = 0., maxAbsEta = 0.;
+  Float_t ptMin = 0.;
+  Bool_t first = kTRUE;
+
+  for (Int_t j=0; j<jMax; j++){
+    AliBFBasicParticle* secondParticle = (AliBFBasicParticle*) particlesSecond->At(j);
+    if ((Int_t)secondParticle->GetTrigOrAssoc() == 0)
+      continue;
+    secondCharge[j] = (Short_t)secondParticle->Charge();
+    if (secondCharge[j] == 0)
+      continue;
+    secondPt[j] = secondParticle->Pt();
+    const Int_t ptBin = axisPtAssoc->FindBin(secondPt[j]);
+    if (ptBin < 1 || ptBin > nPtAssoc)
+      continue;
+    secondEta[j] = secondParticle->Eta();
+    secondPhi[j] = secondParticle->Phi();
+    secondCorrection[j] = (Double_t)secondParticle->Correction();
+    if (!TMath::Finite(secondEta[j]) || !TMath::Finite(secondPhi[j]))
+      return kFALSE;
+    assocClass[j] = (secondCharge[j] > 0 ? 0 : 1)*nPtAssoc + ptBin-1;
+    associated.push_back(j);
+
+    if (first || secondEta[j] < etaLow)  etaLow  = secondEta[j];
+    if (first || secondEta[j] > etaHigh) etaHigh = secondEta[j];
+    if (first || secondPt[j] < ptMin)    ptMin   = secondPt[j];
+    first = kFALSE;
+  }
+
+  // trigger particles, group of each trigger (-1: no pairs in the pair histograms)
+  TArrayF firstEta(iMax);
+  TArrayF firstPhi(iMax);
+  TArrayF firstPt(iMax);
+  TArrayS firstCharge(iMax);
+  TArrayF firstCorrection(iMax);
+  TArrayD firstPsiMinusPhi(iMax);
+  vector<Int_t> triggerGroup(iMax, -1);
+  vector<Int_t> triggers;
+  triggers.reserve(iMax);
+
+  for (Int_t i=0; i<iMax; i++){
+    AliBFBasicParticle* firstParticle = (AliBFBasicParticle*) particles->At(i);
+    if (firstParticle->GetTrigOrAssoc() == 1)
+      continue;
+
+    firstEta[i] = firstParticle->Eta();
+    firstPhi[i] = firstParticle->Phi();
+    firstPt[i]  = firstParticle->Pt();
+    firstCorrection[i] = firstParticle->Correction();
+    firstCharge[i] = (Short_t) firstParticle->Charge();
+    firstPsiMinusPhi[i] = TMath::Abs(firstPhi[i] - gReactionPlane);
+    triggers.push_back(i);
+
+    if (firstCharge[i] == 0 || !vertexInRange || associated.empty())
+      continue;
+
+    Double_t eventClass = GetPsiMinusPhiBin(firstPsiMinusPhi[i]);
+    if(fEventClass=="Multiplicity" || fEventClass == "Centrality" ) eventClass = kMultorCent;
+    const Int_t eventClassBin = axisEventClass->FindBin(eventClass);
+    const Int_t ptTrigBin     = axisPtTrig->FindBin(firstPt[i]);
+    if (eventClassBin < 1 || eventClassBin > nEventClass || ptTrigBin < 1 || ptTrigBin > nPtTrig)
+      continue;
+    if (!TMath::Finite(firstEta[i]) || !TMath::Finite(firstPhi[i]))
+      return kFALSE;
+    triggerGroup[i] = (((eventClassBin-1)*nPtTrig + ptTrigBin-1)*2 + (firstCharge[i] > 0 ? 0 : 1));
+
+    etaLow  = TMath::Min(etaLow, (Double_t)firstEta[i]);
+    etaHigh = TMath::Max(etaHigh, (Double_t)firstEta[i]);
+    ptMin   = TMath::Min(ptMin, firstPt[i]);
+  }
+  maxAbsEta = TMath::Max(TMath::Abs(etaLow), TMath::Abs(etaHigh));
+
+  // grid cells, phi in [0, 2pi)
+  const Double_t twoPi = 2.*TMath::Pi();
+  const Int_t granularity = TMath::Max(1, fBinnedPairsGranularity);
+  Double_t minWidthEta = axisDeltaEta->GetBinWidth(1);
+  Double_t minWidthPhi = axisDeltaPhi->GetBinWidth(1);
+  for (Int_t b=2; b<=nDeltaEta; b++) minWidthEta = TMath::Min(minWidthEta, axisDeltaEta->GetBinWidth(b));
+  for (Int_t b=2; b<=nDeltaPhi; b++) minWidthPhi = TMath::Min(minWidthPhi, axisDeltaPhi->GetBinWidth(b));
+  if (!(minWidthEta > 0.) || !(minWidthPhi > 0.))
+    return kFALSE;
+  const Double_t cellEta = minWidthEta/granularity;
+  const Double_t nPhiCellsD = granularity*TMath::Ceil(twoPi/minWidthPhi);
+  const Double_t nEtaCellsD = TMath::Floor((etaHigh - etaLow)/cellEta) + 1.;
+  if (nEtaCellsD*nPhiCellsD*nClasses > (Double_t)(1<<20))
+    return kFALSE;
+  const Int_t nPhiCells = (Int_t)nPhiCellsD;
+  const Int_t nEtaCells = (Int_t)nEtaCellsD;
+  const Int_t nCells    = nEtaCells*nPhiCells;
+  const Double_t cellPhi = twoPi/nPhiCells;
+
+  // from here on the event is binned: single particle histograms as in CalculateBalance
+  for (size_t it=0; it<triggers.size(); it++){
+    const Int_t i = triggers[it];
+    Double_t gPsiMinusPhiBin = GetPsiMinusPhiBin(firstPsiMinusPhi[i]);
+    fHistPsiMinusPhi->Fill(gPsiMinusPhiBin,firstPsiMinusPhi[i]);
+
+    trackVariablesSingle[0]    =  gPsiMinusPhiBin;
+    trackVariablesSingle[1]    =  firstPt[i];
+    if(fEventClass=="Multiplicity" || fEventClass == "Centrality" ) trackVariablesSingle[0] = kMultorCent;
+    trackVariablesSingle[2]    =  vertexZ;
+
+    //fill single particle histograms
+    if(firstCharge[i] > 0)      fHistP->Fill(trackVariablesSingle,0,firstCorrection[i]);
+    else if(firstCharge[i] < 0) fHistN->Fill(trackVariablesSingle,0,firstCorrection[i]);
+  }
+
+  // triggers of the pair histograms, associated particles of the grid
+  vector<Int_t> triggerCell(iMax, -1), assocCell(jMax, -1);
+  size_t nTriggers = 0;
+  for (size_t it=0; it<triggers.size(); it++){
+    const Int_t i = triggers[it];
+    if (triggerGroup[i] < 0)
+      continue;
+    triggers[nTriggers++] = i;
+  }
+  triggers.resize(nTriggers);
+  if (triggers.empty())
+    return kTRUE;
+
+  for (size_t it=0; it<triggers.size(); it++){
+    const Int_t i = triggers[it];
+    Double_t phi = std::fmod((Double_t)firstPhi[i], twoPi);
+    if (phi < 0.) phi += twoPi;
+    triggerCell[i] = TMath::Min(nEtaCells-1, (Int_t)((firstEta[i] - etaLow)/cellEta))*nPhiCells + TMath::Min(nPhiCells-1, (Int_t)(phi/cellPhi));
+  }
+  for (size_t ja=0; ja<associated.size(); ja++){
+    const Int_t j = associated[ja];
+    Double_t phi = std::fmod((Double_t)secondPhi[j], twoPi);
+    if (phi < 0.) phi += twoPi;
+    assocCell[j] = TMath::Min(nEtaCells-1, (Int_t)((secondEta[j] - etaLow)/cellEta))*nPhiCells + TMath::Min(nPhiCells-1, (Int_t)(phi/cellPhi));
+  }
+
+  // pT slices: a pair with the associated particle in a lower slice has pT,Assoc < pT,Trig
+  vector<Double_t> sliceEdges;
+  if (fMomentumOrdering){
+    for (Int_t b=1; b<=nPtTrig+1; b++)
+      sliceEdges.push_back(axisPtTrig->GetBinLowEdge(b));
+    // more slices with more triggers than cells: the pairs within a slice are done pair by pair
+    const Int_t nQuantiles = (Int_t)triggers.size()/nCells;
+    if (nQuantiles > 1){
+      vector<Float_t> pts;
+      pts.reserve(triggers.size());
+      for (size_t it=0; it<triggers.size(); it++)
+	pts.push_back(firstPt[triggers[it]]);
+      std::sort(pts.begin(), pts.end());
+      for (Int_t q=1; q<nQuantiles; q++)
+	sliceEdges.push_back(pts[q*pts.size()/nQuantiles]);
+    }
+    std::sort(sliceEdges.begin(), sliceEdges.end());
+    sliceEdges.erase(std::unique(sliceEdges.begin(), sliceEdges.end()), sliceEdges.end());
+  }
+  vector<Int_t> triggerSlice(iMax, 0), assocSlice(jMax, 0);
+  if (fMomentumOrdering){
+    for (size_t it=0; it<triggers.size(); it++)
+      triggerSlice[triggers[it]] = std::upper_bound(sliceEdges.begin(), sliceEdges.end(), (Double_t)firstPt[triggers[it]]) - sliceEdges.begin();
+    for (size_t ja=0; ja<associated.size(); ja++)
+      assocSlice[associated[ja]] = std::upper_bound(sliceEdges.begin(), sliceEdges.end(), (Double_t)secondPt[associated[ja]]) - sliceEdges.begin();
+  }
+
+  // triggers by (group, slice, cell), associated particles by (class, slice, cell)
+  std::sort(triggers.begin(), triggers.end(),
+	    [&](Int_t a, Int_t b) {
+	      if (triggerGroup[a] != triggerGroup[b]) return triggerGroup[a] < triggerGroup[b];
+	      if (triggerSlice[a] != triggerSlice[b]) return triggerSlice[a] < triggerSlice[b];
+	      if (triggerCell[a] != triggerCell[b])   return triggerCell[a] < triggerCell[b];
+	      return a < b;
+	    });
+  std::sort(associated.begin(), associated.end(),
+	    [&](Int_t a, Int_t b) {
+	      if (assocClass[a] != assocClass[b]) return assocClass[a] < assocClass[b];
+	      if (assocSlice[a] != assocSlice[b]) return assocSlice[a] < assocSlice[b];
+	      if (assocCell[a] != assocCell[b])   return assocCell[a] < assocCell[b];
+	      return a < b;
+	    });
+  vector<Int_t> classStart(nClasses+1, 0);
+  for (size_t ja=0; ja<associated.size(); ja++)
+    classStart[assocClass[associated[ja]]+1]++;
+  for (Int_t cls=0; cls<nClasses; cls++)
+    classStart[cls+1] += classStart[cls];
+
+  // fractions of the pairs of two cells in each delta eta bin, by eta cell difference
+  vector<Int_t> etaFracStart(2*nEtaCells), etaFracBin;
+  vector<Double_t> etaFrac;
+  for (Int_t d=-(nEtaCells-1); d<nEtaCells; d++){
+    etaFracStart[d+nEtaCells-1] = etaFrac.size();
+    const Double_t center = d*cellEta;
+    const Int_t firstBin = TMath::Max(1, axisDeltaEta->FindBin(center-cellEta));
+    const Int_t lastBin  = TMath::Min(nDeltaEta, axisDeltaEta->FindBin(center+cellEta));
+    for (Int_t b=firstBin; b<=lastBin; b++){
+      const Double_t f = TriangleFraction(center, cellEta, axisDeltaEta->GetBinLowEdge(b), axisDeltaEta->GetBinUpEdge(b));
+      if (f <= 0.) continue;
+      etaFracBin.push_back(b-1);
+      etaFrac.push_back(f);
+    }
+  }
+  etaFracStart[2*nEtaCells-1] = etaFrac.size();
+
+  // same in delta phi, by phi cell difference modulo 2pi, delta phi in [-pi/2, 3pi/2] as in CalculateBalance
+  const Double_t deltaPhiLow  = -TMath::Pi()/2.;
+  const Double_t deltaPhiHigh = 3.*TMath::Pi()/2.;
+  vector<Int_t> phiFracStart(nPhiCells+1), phiFracBin;
+  vector<Double_t> phiFrac;
+  for (Int_t d=0; d<nPhiCells; d++){
+    phiFracStart[d] = phiFrac.size();
+    for (Int_t shift=-1; shift<=1; shift++){
+      const Double_t center = d*cellPhi + shift*twoPi;
+      const Double_t low  = TMath::Max(center-cellPhi, deltaPhiLow);
+      const Double_t high = TMath::Min(center+cellPhi, deltaPhiHigh);
+      if (low >= high) continue;
+      const Int_t firstBin = TMath::Max(1, axisDeltaPhi->FindBin(low));
+      const Int_t lastBin  = TMath::Min(nDeltaPhi, axisDeltaPhi->FindBin(high));
+      for (Int_t b=firstBin; b<=lastBin; b++){
+	const Double_t f = TriangleFraction(center, cellPhi, TMath::Max(axisDeltaPhi->GetBinLowEdge(b), low), TMath::Min(axisDeltaPhi->GetBinUpEdge(b), high));
+	if (f <= 0.) continue;
+	phiFracBin.push_back(b-1);
+	phiFrac.push_back(f);
+      }
+    }
+  }
+  phiFracStart[nPhiCells] = phiFrac.size();
+
+  // windows of the pairs the HBT and conversion cuts can remove
+  Double_t windowEta = -1.;
+  Double_t windowPhiConversion = -1.;
+  if (fHBTCut)
+    windowEta = fHBTCutValue*(1.+1e-6); // IsHBTPair only removes pairs with |delta eta| < fHBTCutValue
+  if (fConversionCut){
+    // m^2 >= 2 pT1 pT2 (1-cos(theta12)): largest opening angle for the smallest pT (with margin for the float
+    // arithmetic of IsConversionPair), |delta eta| < theta12 cosh(eta) and sin(|delta phi|/2) < sin(theta12/2) cosh(eta)
+    const Double_t x = (ptMin > 0.) ? 1.5*fInvMassCutConversion*fInvMassCutConversion/(2.*ptMin*ptMin) : 2.;
+    const Double_t thetaMax = (x < 2.) ? TMath::ACos(1.-x) : TMath::Pi();
+    const Double_t coshEta = TMath::CosH(maxAbsEta);
+    windowEta = TMath::Max(windowEta, 1.05*thetaMax*coshEta + 1e-6);
+    const Double_t sinHalf = TMath::Sin(thetaMax/2.)*coshEta;
+    windowPhiConversion = (sinHalf < 1.) ? 1.05*2.*TMath::ASin(sinHalf) + 1e-6 : twoPi;
+  }
+  vector<Int_t> etaOrder;
+  if (fHBTCut || fConversionCut){
+    etaOrder = associated;
+    std::sort(etaOrder.begin(), etaOrder.end(), [&](Int_t a, Int_t b) { return secondEta[a] < secondEta[b]; });
+  }
+
+  const Int_t nPairBins = nClasses*nDeltaEta*nDeltaPhi;
+  if ((Int_t)fPairSumw.size() != nPairBins){
+    fPairSumw.assign(nPairBins, 0.);
+    fPairSumw2.assign(nPairBins, 0.);
+    fPairFilled.assign(nPairBins, 0);
+    fPairBins.clear();
+  }
+
+  // one pair, with the cuts and the arithmetic of CalculateBalance
+  auto addPair = [&](Int_t i, Int_t j) {
+    if(!particlesMixed && j == i) return; // no auto correlations (only for non mixing)
+
+    // pT,Assoc < pT,Trig (if momentum ordering is switched ON)
+    if(fMomentumOrdering && firstPt[i] < secondPt[j])
+      return;
+
+    const Short_t charge1 = firstCharge[i];
+    const Short_t charge2 = secondCharge[j];
+    if(fHBTCut && charge1 * charge2 > 0){
+      if(IsHBTPair(firstEta[i], firstPhi[i], firstPt[i], charge1, secondEta[j], secondPhi[j], secondPt[j], charge2, bSign))
+	return;
+    }
+    if(fConversionCut && charge1 * charge2 < 0){
+      if(IsConversionPair(firstEta[i], firstPhi[i], firstPt[i], secondEta[j], secondPhi[j], secondPt[j]))
+	return;
+    }
+
+    Double_t deltaEta = firstEta[i] - secondEta[j];
+    Double_t deltaPhi = firstPhi[i] - secondPhi[j];
+    if (deltaPhi > TMath::Pi()) // delta phi between -pi and pi
+      deltaPhi -= 2.*TMath::Pi();
+    if (deltaPhi <  - TMath::Pi())
+      deltaPhi += 2.*TMath::Pi();
+    if (deltaPhi <  - TMath::Pi()/2.)
+      deltaPhi += 2.*TMath::Pi();
+
+    const Int_t deltaEtaBin = axisDeltaEta->FindBin(deltaEta);
+    if (deltaEtaBin < 1 || deltaEtaBin > nDeltaEta)
+      return;
+    const Int_t deltaPhiBin = axisDeltaPhi->FindBin(deltaPhi);
+    if (deltaPhiBin < 1 || deltaPhiBin > nDeltaPhi)
+      return;
+
+    const Int_t bin = (assocClass[j]*nDeltaEta + deltaEtaBin-1)*nDeltaPhi + deltaPhiBin-1;
+    const Double_t weight = firstCorrection[i]*secondCorrection[j];
+    if (!fPairFilled[bin]){
+      fPairFilled[bin] = 1;
+      fPairBins.push_back(bin);
+    }
+    fPairSumw[bin]  += weight;
+    fPairSumw2[bin] += weight*weight;
+  };
+
+  // the pairs of two cells, split among the bins
+  auto addCells = [&](Int_t cls, Int_t cell1, Int_t cell2, Double_t sumw, Double_t sumw2) {
+    const Int_t dEta = cell1/nPhiCells - cell2/nPhiCells + nEtaCells-1;
+    const Int_t dPhi = (cell1%nPhiCells - cell2%nPhiCells + nPhiCells)%nPhiCells;
+    for (Int_t ke=etaFracStart[dEta]; ke<etaFracStart[dEta+1]; ke++){
+      for (Int_t kp=phiFracStart[dPhi]; kp<phiFracStart[dPhi+1]; kp++){
+	const Int_t bin = (cls*nDeltaEta + etaFracBin[ke])*nDeltaPhi + phiFracBin[kp];
+	const Double_t f = etaFrac[ke]*phiFrac[kp];
+	if (!fPairFilled[bin]){
+	  fPairFilled[bin] = 1;
+	  fPairBins.push_back(bin);
+	}
+	fPairSumw[bin]  += f*sumw;
+	fPairSumw2[bin] += f*sumw2;
+      }
+    }
+  };
+
+  // associated particles of the lower slices (all without momentum ordering), summed per class and cell
+  vector<Double_t> gridW(nClasses*nCells, 0.), gridQ(nClasses*nCells, 0.);
+  vector<UChar_t> gridUsed(nClasses*nCells, 0);
+  vector<vector<Int_t> > gridCells(nClasses);
+  vector<Int_t> gridNext(nClasses), gridCount(nClasses);
+  vector<UChar_t> classByCells(nClasses);
+
+  // triggers of one (group, slice) summed per cell
+  vector<Int_t> trigCells;
+  vector<Double_t> trigW, trigQ;
+
+  AliTHn *histPair[2][2] = {{fHistPP, fHistPN}, {fHistNP, fHistNN}};
+  Int_t binIdx[kTrackVariablesPair];
+  binIdx[5] = vertexBin;
+
+  size_t it = 0;
+  while (it < triggers.size()){
+    const Int_t group = triggerGroup[triggers[it]];
+    size_t groupEnd = it;
+    while (groupEnd < triggers.size() && triggerGroup[triggers[groupEnd]] == group)
+      groupEnd++;
+
+    for (Int_t cls=0; cls<nClasses; cls++){
+      for (size_t k=0; k<gridCells[cls].size(); k++){
+	const Int_t idx = cls*nCells + gridCells[cls][k];
+	gridW[idx] = 0.;
+	gridQ[idx] = 0.;
+	gridUsed[idx] = 0;
+      }
+      gridCells[cls].clear();
+      gridNext[cls]  = classStart[cls];
+      gridCount[cls] = 0;
+    }
+
+    while (it < groupEnd){
+      const Int_t slice = triggerSlice[triggers[it]];
+      size_t sliceEnd = it;
+      while (sliceEnd < groupEnd && triggerSlice[triggers[sliceEnd]] == slice)
+	sliceEnd++;
+      const Double_t nSliceTriggers = sliceEnd - it;
+
+      trigCells.clear();
+      trigW.clear();
+      trigQ.clear();
+      for (size_t k=it; k<sliceEnd; k++){
+	const Int_t i = triggers[k];
+	if (trigCells.empty() || trigCells.back() != triggerCell[i]){
+	  trigCells.push_back(triggerCell[i]);
+	  trigW.push_back(0.);
+	  trigQ.push_back(0.);
+	}
+	trigW.back() += firstCorrection[i];
+	trigQ.back() += firstCorrection[i]*firstCorrection[i];
+      }
+
+      for (Int_t cls=0; cls<nClasses; cls++){
+	while (gridNext[cls] < classStart[cls+1] && (!fMomentumOrdering || assocSlice[associated[gridNext[cls]]] < slice)){
+	  const Int_t j = associated[gridNext[cls]++];
+	  const Int_t idx = cls*nCells + assocCell[j];
+	  if (!gridUsed[idx]){
+	    gridUsed[idx] = 1;
+	    gridCells[cls].push_back(assocCell[j]);
+	  }
+	  gridW[idx] += secondCorrection[j];
+	  gridQ[idx] += secondCorrection[j]*secondCorrection[j];
+	  gridCount[cls]++;
+	}
+
+	// cell correlation if it has fewer terms than the pair loop
+	classByCells[cls] = (gridCount[cls] > 0 && 4.*trigCells.size()*gridCells[cls].size() < nSliceTriggers*gridCount[cls]);
+	if (classByCells[cls]){
+	  for (size_t kt=0; kt<trigCells.size(); kt++){
+	    for (size_t ka=0; ka<gridCells[cls].size(); ka++){
+	      const Int_t idx = cls*nCells + gridCells[cls][ka];
+	      addCells(cls, trigCells[kt], gridCells[cls][ka], trigW[kt]*gridW[idx], trigQ[kt]*gridQ[idx]);
+	    }
+	  }
+	}
+	else {
+	  for (size_t k=it; k<sliceEnd; k++)
+	    for (Int_t ka=classStart[cls]; ka<gridNext[cls]; ka++)
+	      addPair(triggers[k], associated[ka]);
+	}
+
+	// pairs within the slice
+	if (fMomentumOrdering){
+	  for (Int_t ka=gridNext[cls]; ka<classStart[cls+1] && assocSlice[associated[ka]] == slice; ka++)
+	    for (size_t k=it; k<sliceEnd; k++)
+	      addPair(triggers[k], associated[ka]);
+	}
+      }
+
+      // pairs of the cell correlation that the pair loop does not have
+      for (size_t k=it; k<sliceEnd; k++){
+	const Int_t i = triggers[k];
+
+	// the trigger with itself
+	if (!particlesMixed && !fMomentumOrdering && assocClass[i] >= 0 && classByCells[assocClass[i]])
+	  addCells(assocClass[i], triggerCell[i], assocCell[i], -firstCorrection[i]*secondCorrection[i],
+		   -firstCorrection[i]*firstCorrection[i]*secondCorrection[i]*secondCorrection[i]);
+
+	// pairs removed by the HBT or conversion cut
+	if (windowEta < 0.)
+	  continue;
+	const Short_t charge1 = firstCharge[i];
+	vector<Int_t>::const_iterator ja = std::lower_bound(etaOrder.begin(), etaOrder.end(), firstEta[i] - windowEta,
+							     [&](Int_t a, Double_t eta) { return secondEta[a] < eta; });
+	for (; ja != etaOrder.end() && secondEta[*ja] <= firstEta[i] + windowEta; ++ja){
+	  const Int_t j = *ja;
+	  const Int_t cls = assocClass[j];
+	  if (!classByCells[cls] || (!particlesMixed && j == i))
+	    continue;
+	  if (fMomentumOrdering && assocSlice[j] >= slice)
+	    continue;
+
+	  const Short_t charge2 = secondCharge[j];
+	  Bool_t removed = kFALSE;
+	  if (charge1 * charge2 > 0){
+	    if (!fHBTCut || TMath::Abs(firstEta[i] - secondEta[j]) > fHBTCutValue*(1.+1e-6))
+	      continue;
+	    removed = IsHBTPair(firstEta[i], firstPhi[i], firstPt[i], charge1, secondEta[j], secondPhi[j], secondPt[j], charge2, bSign);
+	  }
+	  else {
+	    if (!fConversionCut)
+	      continue;
+	    Double_t dPhi = std::fmod(TMath::Abs((Double_t)firstPhi[i] - secondPhi[j]), twoPi);
+	    dPhi = TMath::Min(dPhi, twoPi - dPhi);
+	    if (dPhi > windowPhiConversion)
+	      continue;
+	    removed = IsConversionPair(firstEta[i], firstPhi[i], firstPt[i], secondEta[j], secondPhi[j], secondPt[j]);
+	  }
+	  if (removed){
+	    const Double_t weight = firstCorrection[i]*secondCorrection[j];
+	    addCells(cls, triggerCell[i], assocCell[j], -weight, -weight*weight);
+	  }
+	}
+      }
+
+      it = sliceEnd;
+    }
+
+    // end of the group: fill its bins
+    binIdx[0] = group/2/nPtTrig + 1;
+    binIdx[3] = (group/2)%nPtTrig + 1;
+    for (size_t ib=0; ib<fPairBins.size(); ib++){
+      Int_t bin = fPairBins[ib];
+      binIdx[2] = bin%nDeltaPhi + 1;
+      bin /= nDeltaPhi;
+      binIdx[1] = bin%nDeltaEta + 1;
+      bin /= nDeltaEta;
+      binIdx[4] = bin%nPtAssoc + 1;
+      const Int_t sign2 = bin/nPtAssoc;
+
+      bin = fPairBins[ib];
+      histPair[group%2][sign2]->FillBin(binIdx, 0, fPairSumw[bin], fPairSumw2[bin]);
+      fPairSumw[bin]   = 0.;
+      fPairSumw2[bin]  = 0.;
+      fPairFilled[bin] = 0;
+    }
+    fPairBins.clear();
+  }
+
+  return kTRUE;
+}
+
 //____________________________________________________________________//
 TH1D *AliBalancePsi::GetBalanceFunctionHistogram(Int_t iVariableSingle,
 						 Int_t iVariablePair,
@@ -2867,6 +3343,135 @@ Float_t AliBalancePsi::GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, F
   return dphistar;
 }
 
+//____________________________________________________________________//
+Double_t AliBalancePsi::GetPsiMinusPhiBin(Double_t gPsiMinusPhi) const {
+  // Event plane bin of a particle with gPsiMinusPhi = |phi - Psi|:
+  // 0 (in-plane), 1 (intermediate), 2 (out of plane), 3 (everything else)
+  Double_t gPsiMinusPhiBin = -10.;
+  //in-plane
+  if((gPsiMinusPhi <= 7.5*TMath::DegToRad())||
+     ((172.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 187.5*TMath::DegToRad())))
+    gPsiMinusPhiBin = 0.0;
+  //intermediate
+  else if(((37.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 52.5*TMath::DegToRad()))||
+          ((127.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 142.5*TMath::DegToRad()))||
+          ((217.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 232.5*TMath::DegToRad()))||
+          ((307.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 322.5*TMath::DegToRad())))
+    gPsiMinusPhiBin = 1.0;
+  //out of plane
+  else if(((82.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 97.5*TMath::DegToRad()))||
+          ((262.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 277.5*TMath::DegToRad())))
+    gPsiMinusPhiBin = 2.0;
+  //everything else
+  else
+    gPsiMinusPhiBin = 3.0;
+
+  return gPsiMinusPhiBin;
+}
+
+//____________________________________________________________________//
+Bool_t AliBalancePsi::IsHBTPair(Float_t firstEta, Float_t firstPhi, Float_t firstPt, Short_t charge1,
+                                Float_t secondEta, Float_t secondPhi, Float_t secondPt, Short_t charge2,
+                                Float_t bSign) {
+  // HBT like cut (two-track efficiency) for a like-sign pair, fills the QA histograms
+  // returns kTRUE if the pair has to be removed
+  Double_t deta = firstEta - secondEta;
+  Double_t dphi = firstPhi - secondPhi;
+  if(dphi > TMath::Pi())
+    dphi = secondPhi - firstPhi;
+
+  // for QA: get dphistar in the middle of the TPC R = 1.65
+  Float_t  dphistarMiddle = GetDPhiStar(firstPhi, firstPt, charge1, secondPhi, secondPt, charge2, 1.65, bSign);
+
+  // VERSION 2 (Taken from DPhiCorrelations)
+  // the variables & cuthave been developed by the HBT group
+  // see e.g. https://indico.cern.ch/materialDisplay.py?contribId=36&sessionId=6&materialId=slides&confId=142700
+  fHistHBTbefore->Fill(deta,dphi);
+  fHistPhiStarHBTbefore->Fill(deta,dphistarMiddle);
+
+  // optimization
+  if (TMath::Abs(deta) < fHBTCutValue * 2.5 * 3) //fHBTCutValue = 0.02 [default for dphicorrelations]
+    {
+      // phi in rad
+      //Float_t phi1rad = firstPhi*TMath::DegToRad();
+      //Float_t phi2rad = secondPhi*TMath::DegToRad();
+      Float_t phi1rad = firstPhi;
+      Float_t phi2rad = secondPhi;
+
+      // check first boundaries to see if is worth to loop and find the minimum
+      Float_t dphistar1 = GetDPhiStar(phi1rad, firstPt, charge1, phi2rad, secondPt, charge2, 0.8, bSign);
+      Float_t dphistar2 = GetDPhiStar(phi1rad, firstPt, charge1, phi2rad, secondPt, charge2, 2.5, bSign);
+
+      const Float_t kLimit = fHBTCutValue * 3;
+
+      // Printf("typical values: deta =%f dphistar1 0.8= %f,  dphistar2 2.5 =%f, kLimit =%f ", deta, dphistar1,  dphistar2, kLimit );
+
+      Float_t dphistarminabs = 1e5;
+      //Float_t dphistarmin = 1e5;
+
+      if (TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0 ) {
+        for (Double_t rad=0.8; rad<2.51; rad+=0.01) {
+          Float_t dphistar = GetDPhiStar(phi1rad, firstPt, charge1, phi2rad, secondPt, charge2, rad, bSign);
+          //Printf("inside loop r = %f, dphistar = %f", rad,  dphistar);
+
+          Float_t dphistarabs = TMath::Abs(dphistar);
+
+          if (dphistarabs < dphistarminabs) {
+            //dphistarmin = dphistar;
+            dphistarminabs = dphistarabs;
+          }
+        }
+
+        if (dphistarminabs < fHBTCutValue && TMath::Abs(deta) < fHBTCutValue) {
+          //AliInfo(Form("HBT: Removed track pair %d %d with [[%f %f]] %f %f %f | %f %f %d %f %f %d %f", i, j, deta, dphi, dphistarminabs, dphistar1, dphistar2, phi1rad, pt1, charge1, phi2rad, pt2, charge2, bSign));
+          return kTRUE;
+        }
+      }
+    }
+  fHistHBTafter->Fill(deta,dphi);
+  fHistPhiStarHBTafter->Fill(deta,dphistarMiddle);
+  return kFALSE;
+}
+
+//____________________________________________________________________//
+Bool_t AliBalancePsi::IsConversionPair(Float_t firstEta, Float_t firstPhi, Float_t firstPt,
+                                       Float_t secondEta, Float_t secondPhi, Float_t secondPt) {
+  // conversion cut on the invariant mass (as e+e-) of an unlike-sign pair, fills the QA histograms
+  // returns kTRUE if the pair has to be removed
+  Double_t deta = firstEta - secondEta;
+  Double_t dphi = firstPhi - secondPhi;
+
+  Float_t m0 = 0.510e-3;
+  Float_t tantheta1 = 1e10;
+
+  // phi in rad
+  //Float_t phi1rad = firstPhi*TMath::DegToRad();
+  //Float_t phi2rad = secondPhi*TMath::DegToRad();
+  Float_t phi1rad = firstPhi;
+  Float_t phi2rad = secondPhi;
+
+  if (firstEta < -1e-10 || firstEta > 1e-10)
+    tantheta1 = 2 * TMath::Exp(-firstEta) / ( 1 - TMath::Exp(-2*firstEta));
+
+  Float_t tantheta2 = 1e10;
+  if (secondEta < -1e-10 || secondEta > 1e-10)
+    tantheta2 = 2 * TMath::Exp(-secondEta) / ( 1 - TMath::Exp(-2*secondEta));
+
+  Float_t e1squ = m0 * m0 + firstPt * firstPt * (1.0 + 1.0 / tantheta1 / tantheta1);
+  Float_t e2squ = m0 * m0 + secondPt * secondPt * (1.0 + 1.0 / tantheta2 / tantheta2);
+
+  Float_t masssqu = 2 * m0 * m0 + 2 * ( TMath::Sqrt(e1squ * e2squ) - ( firstPt * secondPt * ( TMath::Cos(phi1rad - phi2rad) + 1.0 / tantheta1 / tantheta2 ) ) );
+
+  fHistConversionbefore->Fill(deta,dphi,masssqu);
+
+  if (masssqu < fInvMassCutConversion*fInvMassCutConversion){
+    //AliInfo(Form("Conversion: Removed track pair %d %d with [[%f %f] %f %f] %d %d <- %f %f  %f %f   %f %f ", i, j, deta, dphi, masssqu, charge1, charge2,eta1,eta2,phi1,phi2,pt1,pt2));
+    return kTRUE;
+  }
+  fHistConversionafter->Fill(deta,dphi,masssqu);
+  return kFALSE;
+}
+
 //____________________________________________________________________//
 Double_t* AliBalancePsi::GetBinning(const char* configuration, const char* tag, Int_t& nBins)
 {
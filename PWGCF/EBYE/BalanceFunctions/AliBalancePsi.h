@@ -240,6 +240,8 @@ class AliBalancePsi : public TObject {
     fConversionCut = kTRUE; fInvMassCutConversion = setInvMassCutConversion; }
   void UseMomentumDifferenceCut(Double_t gDeltaPtCutMin) {
     fQCut = kTRUE; fDeltaPtMin = gDeltaPtCutMin;}
+  void UseBinnedPairs(Bool_t binnedPairs = kTRUE, Int_t granularity = 1) {
+    fBinnedPairs = binnedPairs; fBinnedPairsGranularity = granularity; }
 
   // related to customized binning of output AliTHn
   Bool_t    IsUseVertexBinning() { return fVertexBinning; }
@@ -248,6 +250,18 @@ class AliBalancePsi : public TObject {
 
  private:
   Float_t   GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign); 
+  Double_t  GetPsiMinusPhiBin(Double_t gPsiMinusPhi) const;
+  Bool_t    IsHBTPair(Float_t firstEta, Float_t firstPhi, Float_t firstPt, Short_t charge1,
+		      Float_t secondEta, Float_t secondPhi, Float_t secondPt, Short_t charge2,
+		      Float_t bSign);
+  Bool_t    IsConversionPair(Float_t firstEta, Float_t firstPhi, Float_t firstPt,
+			     Float_t secondEta, Float_t secondPhi, Float_t secondPt);
+  Bool_t    CalculateBalanceBinned(Double_t gReactionPlane,
+				   TObjArray* particles,
+				   TObjArray* particlesMixed,
+				   Float_t bSign,
+				   Double_t kMultorCent,
+				   Double_t vertexZ);
 
   Bool_t fShuffle; //shuffled balance function object
   TString fAnalysisLevel; //ESD, AOD or MC
@@ -302,14 +316,21 @@ class AliBalancePsi : public TObject {
   Bool_t fQCut;//cut on momentum difference to suppress femtoscopic effect correlations
   Double_t fDeltaPtMin;//delta pt cut: minimum value
   Bool_t fVertexBinning;//use vertex z binning in AliTHn
+  Bool_t fBinnedPairs;//pair AliTHn from the correlation of eta-phi cells of the particles, see CalculateBalanceBinned
+  Int_t fBinnedPairsGranularity;//cells per smallest delta eta and delta phi bin width for fBinnedPairs
   TString fCustomBinning;//for setting customized binning
   TString fBinningString;//final binning string
 
   TString fEventClass;
 
+  vector<Double_t> fPairSumw;   //! pair sums of the current trigger group per (charge, pT assoc, delta eta, delta phi) bin, see CalculateBalanceBinned
+  vector<Double_t> fPairSumw2;  //! sums of the squared pair weights
+  vector<UChar_t>  fPairFilled; //! bin has been used in the current group
+  vector<Int_t>    fPairBins;   //! list of the used bins
+
   AliBalancePsi & operator=(const AliBalancePsi & ) {return *this;}
 
-  ClassDef(AliBalancePsi, 5)
+  ClassDef(AliBalancePsi, 6)
 };
 
 #endif
@@ -34,6 +34,15 @@ void AliFemtoCorrFctn::AddMixedPair(AliFemtoPair*)
   cout << "AliFemtoCorrFctn::AddMixedPair -- Not implemented\n";
 }
 
+void AliFemtoCorrFctn::AddRealPairBlock(const AliFemtoPairBlock&)
+{
+  cout << "AliFemtoCorrFctn::AddRealPairBlock -- Not implemented\n";
+}
+void AliFemtoCorrFctn::AddMixedPairBlock(const AliFemtoPairBlock&)
+{
+  cout << "AliFemtoCorrFctn::AddMixedPairBlock -- Not implemented\n";
+}
+
 void AliFemtoCorrFctn::AddFirstParticle(AliFemtoParticle*, bool)
 {
   cout << "AliFemtoCorrFctn::AddFirstParticle -- Not implemented\n";
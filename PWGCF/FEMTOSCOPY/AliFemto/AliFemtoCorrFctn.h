@@ -11,6 +11,7 @@
 #include "AliFemtoEvent.h"
 #include "AliFemtoPair.h"
 #include "AliFemtoPairCut.h"
+#include "AliFemtoPairBlock.h"
 
 #include <TCollection.h>
 
@@ -44,6 +45,16 @@ public:
   /// Not Implemented - Add background pair
   virtual void AddMixedPair(AliFemtoPair* aPir);
 
+  /// Whether the batched pairing may pass blocks of pairs to this
+  /// correlation function instead of single AliFemtoPair objects.
+  /// Default is false; implementations returning true must implement
+  /// AddRealPairBlock and AddMixedPairBlock.
+  virtual bool AcceptsPairBlocks() const { return false; }
+  /// Add the pairs of the block with fPass set as signal pairs
+  virtual void AddRealPairBlock(const AliFemtoPairBlock &block);
+  /// Add the pairs of the block with fPass set as background pairs
+  virtual void AddMixedPairBlock(const AliFemtoPairBlock &block);
+
   /// Not Implemented - Add pair with optional
   virtual void AddFirstParticle(AliFemtoParticle *particle, bool mixing);
   virtual void AddSecondParticle(AliFemtoParticle *particle);
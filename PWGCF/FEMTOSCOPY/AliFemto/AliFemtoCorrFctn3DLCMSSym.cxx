@@ -7,6 +7,7 @@
 #include "AliFemtoPairCut.h"
 
 #include <TH3F.h>
+#include <typeinfo>
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -198,6 +199,53 @@ void AliFemtoCorrFctn3DLCMSSym::AddMixedPair(AliFemtoPair* pair)
   }
 }
 
+//____________________________
+bool AliFemtoCorrFctn3DLCMSSym::AcceptsPairBlocks() const
+{
+  // the pair blocks provide the LCMS components only
+  return typeid(*this) == typeid(AliFemtoCorrFctn3DLCMSSym) && !fPairCut && fUseLCMS;
+}
+//____________________________
+void AliFemtoCorrFctn3DLCMSSym::AddRealPairBlock(const AliFemtoPairBlock &block)
+{
+  for (int k = 0; k < block.fN; k++) {
+    if (!block.fPass[k]) {
+      continue;
+    }
+    const Double_t qout = block.fQOut[k],
+                   qside = block.fQSide[k],
+                   qlong = block.fQLong[k];
+
+    Int_t bin = fNumerator->FindBin(qout, qside, qlong);
+
+    // avoid overflow bins; Fill (not AddBinContent) to keep the errors and statistics as in the per-pair path
+    if (!(fNumerator->IsBinOverflow(bin) or fNumerator->IsBinUnderflow(bin))) {
+      fNumerator->Fill(qout, qside, qlong, 1.0);
+      fNumeratorW->Fill(qout, qside, qlong, block.fQInv[k]);
+    }
+  }
+}
+//____________________________
+void AliFemtoCorrFctn3DLCMSSym::AddMixedPairBlock(const AliFemtoPairBlock &block)
+{
+  for (int k = 0; k < block.fN; k++) {
+    if (!block.fPass[k]) {
+      continue;
+    }
+    const Double_t qout = block.fQOut[k],
+                   qside = block.fQSide[k],
+                   qlong = block.fQLong[k];
+
+    Int_t bin = fDenominator->FindBin(qout, qside, qlong);
+
+    // avoid overflow bins; Fill (not AddBinContent) to keep the errors and statistics as in the per-pair path
+    if (!(fDenominator->IsBinOverflow(bin) or fDenominator->IsBinUnderflow(bin))) {
+      fDenominator->Fill(qout, qside, qlong, 1.0);
+      fDenominatorW->Fill(qout, qside, qlong, block.fQInv[k]);
+    }
+  }
+}
+
 void AliFemtoCorrFctn3DLCMSSym::SetUseLCMS(int aUseLCMS)
 {
   fUseLCMS = aUseLCMS;
@@ -40,6 +40,10 @@ public:
   virtual void AddRealPair(AliFemtoPair* aPair);
   virtual void AddMixedPair(AliFemtoPair* aPair);
 
+  virtual bool AcceptsPairBlocks() const;
+  virtual void AddRealPairBlock(const AliFemtoPairBlock &block);
+  virtual void AddMixedPairBlock(const AliFemtoPairBlock &block);
+
   virtual void Finish();
 
   TH3F* Numerator();
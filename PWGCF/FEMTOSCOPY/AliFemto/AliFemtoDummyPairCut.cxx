@@ -5,6 +5,7 @@
 #include "AliFemtoDummyPairCut.h"
 #include <string>
 #include <cstdio>
+#include <typeinfo>
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -33,6 +34,18 @@ bool AliFemtoDummyPairCut::Pass(const AliFemtoPair* /* pair */)
   return true;
 }
 //__________________
+bool AliFemtoDummyPairCut::AcceptsPairBlocks() const
+{
+  // derived classes overriding Pass() must not inherit the block path
+  return typeid(*this) == typeid(AliFemtoDummyPairCut);
+}
+//__________________
+void AliFemtoDummyPairCut::PassPairBlock(AliFemtoPairBlock &block)
+{
+  // Pass all pairs of the block
+  fNPairsPassed += block.Size();
+}
+//__________________
 AliFemtoString AliFemtoDummyPairCut::Report()
 {
   // prepare a report from the execution
@@ -82,6 +82,8 @@ public:
   AliFemtoDummyPairCut& operator=(const AliFemtoDummyPairCut&);
 
   virtual bool Pass(const AliFemtoPair*);
+  virtual bool AcceptsPairBlocks() const;
+  virtual void PassPairBlock(AliFemtoPairBlock &block);
   virtual AliFemtoString Report();
   virtual TList *ListSettings();
   AliFemtoDummyPairCut* Clone();
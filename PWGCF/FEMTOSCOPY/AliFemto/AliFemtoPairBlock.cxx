@@ -0,0 +1,92 @@
+///
+/// \file AliFemtoPairBlock.cxx
+///
+
+#include "AliFemtoPairBlock.h"
+#include "AliFemtoParticle.h"
+
+#include <TMath.h>
+#include <cmath>
+
+AliFemtoParticleSoA::AliFemtoParticleSoA():
+  fParticle(),
+  fPx(),
+  fPy(),
+  fPz(),
+  fE(),
+  fEta(),
+  fPhi()
+{
+}
+
+void AliFemtoParticleSoA::Fill(const AliFemtoParticleCollection &collection)
+{
+  fParticle.clear();
+  fPx.clear();
+  fPy.clear();
+  fPz.clear();
+  fE.clear();
+  fEta.clear();
+  fPhi.clear();
+
+  for (const AliFemtoParticle *particle : collection) {
+    const AliFemtoLorentzVector &p = particle->FourMomentum();
+    fParticle.push_back(particle);
+    fPx.push_back(p.x());
+    fPy.push_back(p.y());
+    fPz.push_back(p.z());
+    fE.push_back(p.e());
+    fEta.push_back(p.vect().PseudoRapidity());
+    fPhi.push_back(p.vect().Phi());
+  }
+}
+
+AliFemtoPairBlock::AliFemtoPairBlock():
+  fN(0)
+{
+}
+
+void AliFemtoPairBlock::Compute()
+{
+  // Plain loop over arrays, without calls or branches that cannot be
+  // turned into selects, so that the compiler can vectorize it
+  for (int k = 0; k < fN; k++) {
+    const double
+      px = fP1x[k] + fP2x[k],
+      py = fP1y[k] + fP2y[k],
+      pz = fP1z[k] + fP2z[k],
+      e = fE1[k] + fE2[k],
+
+      dx = fP1x[k] - fP2x[k],
+      dy = fP1y[k] - fP2y[k],
+      dz = fP1z[k] - fP2z[k],
+      de = fE1[k] - fE2[k],
+
+      pt = std::sqrt(px*px + py*py),
+      m2 = de*de - dx*dx - dy*dy - dz*dz,
+
+      beta = pz / e,
+      gamma = 1.0 / std::sqrt((1.0 - beta) * (1.0 + beta));
+
+    fKT[k] = 0.5 * pt;
+    fQInv[k] = m2 < 0.0 ? std::sqrt(-m2) : -std::sqrt(m2);
+    fQOut[k] = pt == 0.0 ? 0.0 : (dx*px + dy*py) / pt;
+    fQSide[k] = pt == 0.0 ? 0.0 : 2.0 * (fP2x[k]*fP1y[k] - fP1x[k]*fP2y[k]) / pt;
+    fQLong[k] = gamma * (dz - beta*de);
+
+    double dphi = fPhi2[k] - fPhi1[k];
+    dphi = dphi >= TMath::Pi() ? dphi - TMath::TwoPi() : (dphi < -TMath::Pi() ? dphi + TMath::TwoPi() : dphi);
+    fDEta[k] = fEta2[k] - fEta1[k];
+    fDPhi[k] = dphi;
+    fPass[k] = true;
+  }
+}
+
+int AliFemtoPairBlock::NumberPassing() const
+{
+  int n = 0;
+  for (int k = 0; k < fN; k++) {
+    n += fPass[k];
+  }
+  return n;
+}
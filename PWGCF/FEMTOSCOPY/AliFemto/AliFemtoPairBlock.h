@@ -0,0 +1,105 @@
+///
+/// \file  AliFemtoPairBlock.h
+/// \class AliFemtoParticleSoA
+/// \brief Kinematics of a particle collection in structure-of-arrays layout
+///
+/// \class AliFemtoPairBlock
+/// \brief Pair quantities of a block of pairs, computed in one pass
+///
+/// The batched pairing of AliFemtoSimpleAnalysis packs the particle
+/// collections into AliFemtoParticleSoA objects and gathers the momenta
+/// of up to kMaxPairs pairs into an AliFemtoPairBlock. The pair
+/// quantities of the whole block are then computed in one loop, and the
+/// block is passed to the pair cut and to the correlation functions
+/// which declare that they accept pair blocks.
+///
+/// The definitions follow the ones of AliFemtoPair: QInv() (signed),
+/// KT(), QOutCMS(), QSideCMS() and QLongCMS(). The two-track separation
+/// variables are the differences of pseudorapidity and azimuthal angle
+/// (at the primary vertex) of the second and the first particle.
+///
+
+#ifndef ALIFEMTOPAIRBLOCK_H
+#define ALIFEMTOPAIRBLOCK_H
+
+#include <vector>
+
+#include "AliFemtoParticleCollection.h"
+
+class AliFemtoParticle;
+
+class AliFemtoParticleSoA {
+public:
+  AliFemtoParticleSoA();
+
+  /// Pack the kinematics of the particles in the collection
+  void Fill(const AliFemtoParticleCollection &collection);
+
+  size_t Size() const { return fParticle.size(); }
+
+  std::vector<const AliFemtoParticle*> fParticle; ///< particles of the collection
+  std::vector<double> fPx;   ///< momentum x component
+  std::vector<double> fPy;   ///< momentum y component
+  std::vector<double> fPz;   ///< momentum z component
+  std::vector<double> fE;    ///< energy
+  std::vector<double> fEta;  ///< pseudorapidity
+  std::vector<double> fPhi;  ///< azimuthal angle
+};
+
+class AliFemtoPairBlock {
+public:
+  enum { kMaxPairs = 256 };
+
+  AliFemtoPairBlock();
+
+  int Size() const { return fN; }
+  bool IsFull() const { return fN == kMaxPairs; }
+  void Clear() { fN = 0; }
+
+  /// Add pair (i of c1, j of c2), swapping the particles if requested
+  void Add(const AliFemtoParticleSoA &c1, int i, const AliFemtoParticleSoA &c2, int j, bool swap);
+
+  /// Compute the pair quantities of all the pairs in the block
+  void Compute();
+
+  /// Number of pairs passing the cut (after the pair cut filled fPass)
+  int NumberPassing() const;
+
+  int fN;                                     ///< number of pairs in the block
+
+  const AliFemtoParticle* fTrack1[kMaxPairs]; ///< first particle of each pair
+  const AliFemtoParticle* fTrack2[kMaxPairs]; ///< second particle of each pair
+
+  // Gathered momenta of the two particles
+  double fP1x[kMaxPairs], fP1y[kMaxPairs], fP1z[kMaxPairs], fE1[kMaxPairs], fEta1[kMaxPairs], fPhi1[kMaxPairs];
+  double fP2x[kMaxPairs], fP2y[kMaxPairs], fP2z[kMaxPairs], fE2[kMaxPairs], fEta2[kMaxPairs], fPhi2[kMaxPairs];
+
+  // Pair quantities
+  double fKT[kMaxPairs];     ///< half of the pair transverse momentum
+  double fQInv[kMaxPairs];   ///< invariant relative momentum (signed, as AliFemtoPair::QInv)
+  double fQOut[kMaxPairs];   ///< out component of the relative momentum in LCMS
+  double fQSide[kMaxPairs];  ///< side component of the relative momentum in LCMS
+  double fQLong[kMaxPairs];  ///< long component of the relative momentum in LCMS
+  double fDEta[kMaxPairs];   ///< eta2 - eta1
+  double fDPhi[kMaxPairs];   ///< phi2 - phi1 in [-pi, pi)
+
+  bool fPass[kMaxPairs];     ///< result of the pair cut
+};
+
+inline void AliFemtoPairBlock::Add(const AliFemtoParticleSoA &c1, int i, const AliFemtoParticleSoA &c2, int j, bool swap)
+{
+  const AliFemtoParticleSoA &a = swap ? c2 : c1,
+                            &b = swap ? c1 : c2;
+  const int ia = swap ? j : i,
+            ib = swap ? i : j;
+
+  fTrack1[fN] = a.fParticle[ia];
+  fTrack2[fN] = b.fParticle[ib];
+  fP1x[fN] = a.fPx[ia]; fP1y[fN] = a.fPy[ia]; fP1z[fN] = a.fPz[ia]; fE1[fN] = a.fE[ia];
+  fEta1[fN] = a.fEta[ia]; fPhi1[fN] = a.fPhi[ia];
+  fP2x[fN] = b.fPx[ib]; fP2y[fN] = b.fPy[ib]; fP2z[fN] = b.fPz[ib]; fE2[fN] = b.fE[ib];
+  fEta2[fN] = b.fEta[ib]; fPhi2[fN] = b.fPhi[ib];
+  fN++;
+}
+
+#endif
@@ -17,6 +17,7 @@ class AliFemtoAnalysis;
 #include "AliFemtoString.h"
 #include "AliFemtoEvent.h"
 #include "AliFemtoPair.h"
+#include "AliFemtoPairBlock.h"
 #include "AliFemtoCutMonitorHandler.h"
 #include <TList.h>
 #include <TObjString.h>
@@ -43,6 +44,11 @@ public:
 
   virtual bool Pass(const AliFemtoPair* pair) = 0;  ///< true if pair passes, false if not
 
+  /// Whether the cut can be evaluated on blocks of pairs (see AliFemtoPairBlock)
+  virtual bool AcceptsPairBlocks() const { return false; }
+  /// Set fPass of each pair in the block; only called if AcceptsPairBlocks() is true
+  virtual void PassPairBlock(AliFemtoPairBlock &/* block */) { /* no-op */ }
+
   virtual AliFemtoString Report() = 0;              ///< user-written method to return string describing cuts
   virtual TList *ListSettings() = 0;                ///< Return a TList of settings
 
@@ -3,6 +3,7 @@
 ///
 
 #include "AliFemtoQinvCorrFctn.h"
+#include <typeinfo>
 // #include <cstdio>
 
 #ifdef __ROOT__
@@ -245,6 +246,37 @@ void AliFemtoQinvCorrFctn::AddMixedPair(AliFemtoPair* pair)
   }
 }
 
+//____________________________
+bool AliFemtoQinvCorrFctn::AcceptsPairBlocks() const
+{
+  // blocks only carry the pair kinematics: no own pair cut, no (deta, dphi*)
+  // at a radius and no pair reader; derived classes keep the per-pair path
+  return typeid(*this) == typeid(AliFemtoQinvCorrFctn)
+      && !fPairCut && !fDetaDphiscal && !fPairKinematics;
+}
+
+//____________________________
+void AliFemtoQinvCorrFctn::AddRealPairBlock(const AliFemtoPairBlock &block)
+{
+  for (int k = 0; k < block.fN; k++) {
+    if (!block.fPass[k]) {
+      continue;
+    }
+    fNumerator->Fill(fabs(block.fQInv[k]));
+    fkTMonitor->Fill(block.fKT[k]);
+  }
+}
+
+//____________________________
+void AliFemtoQinvCorrFctn::AddMixedPairBlock(const AliFemtoPairBlock &block)
+{
+  for (int k = 0; k < block.fN; k++) {
+    if (block.fPass[k]) {
+      fDenominator->Fill(fabs(block.fQInv[k]));
+    }
+  }
+}
+
 void AliFemtoQinvCorrFctn::Write()
 {
   // Write out neccessary objects
@@ -66,6 +66,10 @@ public:
   virtual void AddRealPair(AliFemtoPair* aPair);
   virtual void AddMixedPair(AliFemtoPair* aPair);
 
+  virtual bool AcceptsPairBlocks() const;
+  virtual void AddRealPairBlock(const AliFemtoPairBlock &block);
+  virtual void AddMixedPairBlock(const AliFemtoPairBlock &block);
+
   virtual void Finish();
 
   void CalculateDetaDphis(Bool_t, Double_t);
@@ -183,7 +183,11 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis():
   fMinSizePartCollection(0),
   fVerbose(kTRUE),
   fPerformSharedDaughterCut(kFALSE),
-  fEnablePairMonitors(kFALSE)
+  fEnablePairMonitors(kFALSE),
+  fBatchedPairs(kFALSE),
+  fPackedParticles1(),
+  fPackedParticles2(),
+  fPairBlock(nullptr)
 {
   // Default constructor
   fCorrFctnCollection = new AliFemtoCorrFctnCollection;
@@ -205,7 +209,11 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis(const AliFemtoSimpleAnalysis& a):
   fMinSizePartCollection(a.fMinSizePartCollection),
   fVerbose(a.fVerbose),
   fPerformSharedDaughterCut(a.fPerformSharedDaughterCut),
-  fEnablePairMonitors(a.fEnablePairMonitors)
+  fEnablePairMonitors(a.fEnablePairMonitors),
+  fBatchedPairs(a.fBatchedPairs),
+  fPackedParticles1(),
+  fPackedParticles2(),
+  fPairBlock(nullptr)
 {
   /// Copy constructor
 
@@ -317,6 +325,8 @@ AliFemtoSimpleAnalysis::~AliFemtoSimpleAnalysis()
     }
     delete fMixingBuffer;
   }
+
+  delete fPairBlock;
 }
 //______________________
 AliFemtoSimpleAnalysis& AliFemtoSimpleAnalysis::operator=(const AliFemtoSimpleAnalysis& aAna)
@@ -402,6 +412,7 @@ AliFemtoSimpleAnalysis& AliFemtoSimpleAnalysis::operator=(const AliFemtoSimpleAn
   fVerbose = aAna.fVerbose;
   fPerformSharedDaughterCut = aAna.fPerformSharedDaughterCut;
   fEnablePairMonitors = aAna.fEnablePairMonitors;
+  fBatchedPairs = aAna.fBatchedPairs;
 
   return *this;
 }
@@ -598,6 +609,11 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
   // "Seed" this here.
   bool swpart = fNeventsProcessed % 2;
 
+  if (UseBatchedPairs(enablePairMonitors)) {
+    MakePairBlocks(these_are_real_pairs, partCollection1, partCollection2);
+    return;
+  }
+
   // Setup iterator ranges
   //
   // The outer loop alway starts at beginning of particle collection 1.
@@ -680,6 +696,84 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
   delete tPair;
 }
 //_________________________
+bool AliFemtoSimpleAnalysis::UseBatchedPairs(Bool_t enablePairMonitors) const
+{
+  if (!fBatchedPairs || enablePairMonitors || !fPairCut->AcceptsPairBlocks()) {
+    return false;
+  }
+
+  for (auto &cf : *fCorrFctnCollection) {
+    if (!cf->AcceptsPairBlocks()) {
+      return false;
+    }
+  }
+  return true;
+}
+//_________________________
+void AliFemtoSimpleAnalysis::MakePairBlocks(bool these_are_real_pairs,
+                                            AliFemtoParticleCollection *partCollection1,
+                                            AliFemtoParticleCollection *partCollection2)
+{
+/// Same pairs, in the same order and with the same particle swapping, as
+/// the per-pair loop of MakePairs. The particle collections are packed once
+/// and the pair quantities are computed for a whole block at a time.
+
+  if (!fPairBlock) {
+    fPairBlock = new AliFemtoPairBlock;
+  }
+  fPairBlock->Clear();
+
+  bool swpart = fNeventsProcessed % 2;
+
+  fPackedParticles1.Fill(*partCollection1);
+  const int n1 = fPackedParticles1.Size();
+
+  if (partCollection2) {
+    fPackedParticles2.Fill(*partCollection2);
+    const int n2 = fPackedParticles2.Size();
+
+    for (int i = 0; i < n1; i++) {
+      for (int j = 0; j < n2; j++) {
+        fPairBlock->Add(fPackedParticles1, i, fPackedParticles2, j, false);
+        if (fPairBlock->IsFull()) {
+          FlushPairBlock(these_are_real_pairs);
+        }
+      }
+    }
+  }
+  else {
+    // identical particles: swap between first and second particles
+    for (int i = 0; i < n1 - 1; i++) {
+      for (int j = i + 1; j < n1; j++) {
+        fPairBlock->Add(fPackedParticles1, i, fPackedParticles1, j, swpart);
+        swpart = !swpart;
+        if (fPairBlock->IsFull()) {
+          FlushPairBlock(these_are_real_pairs);
+        }
+      }
+    }
+  }
+
+  if (fPairBlock->Size() > 0) {
+    FlushPairBlock(these_are_real_pairs);
+  }
+}
+//_________________________
+void AliFemtoSimpleAnalysis::FlushPairBlock(bool these_are_real_pairs)
+{
+  fPairBlock->Compute();
+  fPairCut->PassPairBlock(*fPairBlock);
+
+  for (auto &tCorrFctn : *fCorrFctnCollection) {
+    if (these_are_real_pairs)
+      tCorrFctn->AddRealPairBlock(*fPairBlock);
+    else
+      tCorrFctn->AddMixedPairBlock(*fPairBlock);
+  }
+
+  fPairBlock->Clear();
+}
+//_________________________
 void AliFemtoSimpleAnalysis::EventBegin(const AliFemtoEvent* ev)
 {
   /// Perform initialization operations at the beginning of the event processing
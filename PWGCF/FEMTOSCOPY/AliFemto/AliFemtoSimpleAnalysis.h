@@ -15,6 +15,7 @@
 #include "AliFemtoParticleCollection.h"
 #include "AliFemtoV0SharedDaughterCut.h"
 #include "AliFemtoXiSharedDaughterCut.h"
+#include "AliFemtoPairBlock.h"
 
 class AliFemtoPicoEventCollectionVectorHideAway;
 class AliFemtoPicoEvent;
@@ -99,6 +100,14 @@ public:
   void SetEnablePairMonitors(Bool_t aEnable);
   Bool_t EnablePairMonitors();
 
+  /// Build and process pairs in blocks of AliFemtoPairBlock::kMaxPairs
+  ///
+  /// Only used when the pair cut and all correlation functions accept pair
+  /// blocks and the pair cut monitors are disabled; otherwise the pairs are
+  /// processed one at a time.
+  void SetBatchedPairs(Bool_t aBatched);
+  Bool_t BatchedPairs() const;
+
   unsigned int NumEventsToMix() const;
   void SetNumEventsToMix(const unsigned int& NumberOfEventsToMix);
   AliFemtoPicoEvent* CurrentPicoEvent();
@@ -159,6 +168,17 @@ protected:
                  AliFemtoParticleCollection* ParticlesPssingCut2=NULL,
                  Bool_t enablePairMonitors=kFALSE);
 
+  /// True if the pairs of this analysis can be processed in blocks
+  bool UseBatchedPairs(Bool_t enablePairMonitors) const;
+
+  /// Block version of MakePairs (see SetBatchedPairs)
+  void MakePairBlocks(bool these_are_real_pairs,
+                      AliFemtoParticleCollection* ParticlesPassingCut1,
+                      AliFemtoParticleCollection* ParticlesPassingCut2);
+
+  /// Apply the pair cut to the block and pass it to the CFs, then clear it
+  void FlushPairBlock(bool these_are_real_pairs);
+
   AliFemtoPicoEventCollectionVectorHideAway* fPicoEventCollectionVectorHideAway; //!<! Mixing Buffer used for Analyses which wrap this one
 
   AliFemtoPairCut*             fPairCut;             ///< cut applied to pairs
@@ -177,6 +197,11 @@ protected:
   Bool_t fVerbose;
   Bool_t fPerformSharedDaughterCut;
   Bool_t fEnablePairMonitors;
+  Bool_t fBatchedPairs;                              ///< Process pairs in blocks when possible
+
+  AliFemtoParticleSoA fPackedParticles1;             //!<! Packed kinematics of the first collection
+  AliFemtoParticleSoA fPackedParticles2;             //!<! Packed kinematics of the second collection
+  AliFemtoPairBlock*  fPairBlock;                    //!<! Block of pairs, allocated on first use
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -305,4 +330,14 @@ inline void AliFemtoSimpleAnalysis::SetEnablePairMonitors(Bool_t aEnable)
   fEnablePairMonitors = aEnable;
 }
 
+inline void AliFemtoSimpleAnalysis::SetBatchedPairs(Bool_t aBatched)
+{
+  fBatchedPairs = aBatched;
+}
+
+inline Bool_t AliFemtoSimpleAnalysis::BatchedPairs() const
+{
+  return fBatchedPairs;
+}
+
 #endif
@@ -208,6 +208,13 @@ class AliFemtoDreamCorrHists {
       }
     }
   }
+  void FillPairInvMEMassQAD(int i, float pairInvMass) {
+    if (!fMinimalBooking) {
+      if (fPairInvMEMassQAD[i]) {
+        fPairInvMEMassQAD[i]->Fill(pairInvMass);
+      }
+    }
+  }
 
   void FillPDGPairInvMassQAD(int i, float kstar,
                           AliFemtoDreamBasePart &part1, float massPart1,
@@ -245,6 +252,13 @@ class AliFemtoDreamCorrHists {
       }
     }
   }
+  void FillPDGPairInvMEMassQAD(int i, float kstar, float pairInvMass) {
+    if (!fMinimalBooking) {
+      if (fPairInvMEMassQAD[i]) {
+        fPairInvMEMassKstarQAD[i]->Fill(pairInvMass, kstar);
+      }
+    }
+  }
 
   void FillMixedEventMultDist(int i, int iMult, float RelK) {
     if (fMixedEventMultDist[i])
@@ -8,8 +8,67 @@
 #include <AliFemtoDreamHigherPairMath.h>
 #include "TMath.h"
 #include "TDatabasePDG.h"
+#include <stdexcept>
 static const float piHi = TMath::Pi();
 
+namespace {
+//Access to eta and phi at the TPC radii of the two kinds of particles
+//entering the close pair rejection
+class BasePartRadii {
+ public:
+  BasePartRadii(const AliFemtoDreamBasePart &part)
+      : fEta(part.GetEta()),
+        fPhiAtRad(part.GetPhiAtRaidius()) {
+  }
+  unsigned int NDaughters() const {
+    return fPhiAtRad.size();
+  }
+  float Eta(unsigned int i) const {
+    return fEta.at(i);
+  }
+  unsigned int NRadii(unsigned int iDaug) const {
+    return fPhiAtRad.at(iDaug).size();
+  }
+  float PhiAtRadius(unsigned int iDaug, unsigned int iRad) const {
+    return fPhiAtRad[iDaug][iRad];
+  }
+ private:
+  std::vector<float> fEta;
+  std::vector<std::vector<float>> fPhiAtRad;
+};
+
+class MixingPartRadii {
+ public:
+  MixingPartRadii(const AliFemtoDreamMixingEvent &evt, unsigned int i)
+      : fPart(evt.GetPart(i)),
+        fEta(evt.GetEta(i)),
+        fPhiAtRad(evt.GetPhiAtRadius(i, 0)) {
+  }
+  unsigned int NDaughters() const {
+    return fPart.fNDaughters;
+  }
+  float Eta(unsigned int i) const {
+    if (i >= fPart.fNEta) {
+      throw std::out_of_range("MixingPartRadii::Eta");
+    }
+    return fEta[i];
+  }
+  unsigned int NRadii(unsigned int iDaug) const {
+    if (iDaug >= fPart.fNDaughters) {
+      throw std::out_of_range("MixingPartRadii::NRadii");
+    }
+    return fPart.fNRadii;
+  }
+  float PhiAtRadius(unsigned int iDaug, unsigned int iRad) const {
+    return fPhiAtRad[iDaug * fPart.fNRadii + iRad];
+  }
+ private:
+  const AliFemtoDreamMixingPart &fPart;
+  const float *fEta;
+  const float *fPhiAtRad;
+};
+}
+
 AliFemtoDreamHigherPairMath::AliFemtoDreamHigherPairMath(
     AliFemtoDreamCollConfig *conf, bool minBooking)
     : fHists(new AliFemtoDreamCorrHists(conf, minBooking)),
@@ -83,6 +142,21 @@ bool AliFemtoDreamHigherPairMath::PassesPairSelection(
   return pass;
 }
 
+bool AliFemtoDreamHigherPairMath::PassesPairSelection(
+    int iHC, const AliFemtoDreamMixingEvent &evt1, unsigned int i1,
+    const AliFemtoDreamMixingEvent &evt2, unsigned int i2, float RelativeK,
+    bool SEorME) {
+  //Same as above for particles from the mixing buffers
+  bool pass = true;
+  bool CPR = fRejPairs.at(iHC);
+  if ((CPR && fDoDeltaEtaDeltaPhiCut) || fHists->GetEtaPhiPlots()) {
+    pass = DeltaEtaDeltaPhiAtRadii(iHC, MixingPartRadii(evt1, i1),
+                                   MixingPartRadii(evt2, i2), SEorME,
+                                   RelativeK);
+  }
+  return pass;
+}
+
 bool AliFemtoDreamHigherPairMath::CommonAncestors(AliFemtoDreamBasePart& part1, AliFemtoDreamBasePart& part2) {
     bool IsCommon = false;
     if(part1.GetMotherID() == part2.GetMotherID()){
@@ -236,6 +310,23 @@ void AliFemtoDreamHigherPairMath::MEMassQA(int iHC, float RelK,
   }
 }
 
+void AliFemtoDreamHigherPairMath::MEMassQA(int iHC, float RelK,
+                                           const AliFemtoDreamMixingPart &part1,
+                                           float massPart1,
+                                           const AliFemtoDreamMixingPart &part2,
+                                           float massPart2) {
+  if (fWhichPairs.at(iHC) && fHists->GetDoMassQA()) {
+    fHists->FillMEMassQADist(iHC, RelK, part1.fInvMass, part2.fInvMass);
+    TLorentzVector PartOne, PartTwo;
+    PartOne.SetXYZM(part1.fPx, part1.fPy, part1.fPz, part1.fInvMass);
+    PartTwo.SetXYZM(part2.fPx, part2.fPy, part2.fPz, part2.fInvMass);
+    fHists->FillPairInvMEMassQAD(iHC, (PartOne + PartTwo).M());
+    PartOne.SetXYZM(part1.fPx, part1.fPy, part1.fPz, massPart1);
+    PartTwo.SetXYZM(part2.fPx, part2.fPy, part2.fPz, massPart2);
+    fHists->FillPDGPairInvMEMassQAD(iHC, RelK, (PartOne + PartTwo).M());
+  }
+}
+
 float AliFemtoDreamHigherPairMath::FillMixedEvent(
     int iHC, int Mult, float cent, AliFemtoDreamBasePart &part1, int PDGPart1,
     AliFemtoDreamBasePart &part2, int PDGPart2,
@@ -243,7 +334,6 @@ float AliFemtoDreamHigherPairMath::FillMixedEvent(
   if (PDGPart1 == 0 || PDGPart2 == 0) {
     AliError("Invalid PDG Code");
   }
-  bool fillHists = fWhichPairs.at(iHC);
   TLorentzVector PartOne, PartTwo;
   TVector3 Part1Momentum = part1.GetMomentum();
   TVector3 Part2Momentum = part2.GetMomentum();
@@ -265,6 +355,14 @@ float AliFemtoDreamHigherPairMath::FillMixedEvent(
     PartOne.SetPhi(PartOne.Phi() + fRandom.Uniform(2 * fPi));
     PartTwo.SetPhi(PartTwo.Phi() + fRandom.Uniform(2 * fPi));
   }
+  return FillMixedEvent(iHC, Mult, cent, PartOne, PartTwo);
+}
+
+float AliFemtoDreamHigherPairMath::FillMixedEvent(int iHC, int Mult,
+                                                  float cent,
+                                                  TLorentzVector &PartOne,
+                                                  TLorentzVector &PartTwo) {
+  bool fillHists = fWhichPairs.at(iHC);
   float RelativeK = RelativePairMomentum(PartOne, PartTwo);
   fHists->FillMixedEventDist(iHC, RelativeK);
   if (fHists->GetDoMultBinning()) {
@@ -290,11 +388,11 @@ float AliFemtoDreamHigherPairMath::FillMixedEvent(
 				   RelativeK); 
   }   
   if (fillHists && fHists->GetDoPtQA()) {
-    fHists->FillPtMEOneQADist(iHC, Part1Momentum.Pt(), Mult + 1);
-    fHists->FillPtMETwoQADist(iHC, Part2Momentum.Pt(), Mult + 1);
+    fHists->FillPtMEOneQADist(iHC, PartOne.Pt(), Mult + 1);
+    fHists->FillPtMETwoQADist(iHC, PartTwo.Pt(), Mult + 1);
     
-    fHists->FillKstarPtMEOneQADist(iHC, RelativeK, Part1Momentum.Pt());
-    fHists->FillKstarPtMETwoQADist(iHC, RelativeK, Part2Momentum.Pt());
+    fHists->FillKstarPtMEOneQADist(iHC, RelativeK, PartOne.Pt());
+    fHists->FillKstarPtMETwoQADist(iHC, RelativeK, PartTwo.Pt());
   }
   return RelativeK;
 }
@@ -372,6 +470,27 @@ void AliFemtoDreamHigherPairMath::MEDetaDPhiPlots(int iHC,
   }
 }
 
+void AliFemtoDreamHigherPairMath::MEDetaDPhiPlots(
+    int iHC, const AliFemtoDreamMixingPart &part1, float massPart1,
+    const AliFemtoDreamMixingPart &part2, float massPart2) {
+  if (fWhichPairs.at(iHC) && fHists->GetDodPhidEtaPlots()) {
+    float deta = part1.fEta - part2.fEta;
+    float dphi = part1.fPhi - part2.fPhi;
+    float mT = 0;
+    if (fHists->GetDodPhidEtamTPlots()) {
+      TLorentzVector PartOne, PartTwo;
+      PartOne.SetXYZM(part1.fMCPx, part1.fMCPy, part1.fMCPz, massPart1);
+      PartTwo.SetXYZM(part2.fMCPx, part2.fMCPy, part2.fMCPz, massPart2);
+      mT = RelativePairmT(PartOne, PartTwo);
+    }
+    if (dphi < 0) {
+      fHists->FilldPhidEtaME(iHC, dphi + 2 * TMath::Pi(), deta, mT);
+    } else {
+      fHists->FilldPhidEtaME(iHC, dphi, deta, mT);
+    }
+  }
+}
+
 void AliFemtoDreamHigherPairMath::SEMomentumResolution(
     int iHC, AliFemtoDreamBasePart* part1, int PDGPart1,
     AliFemtoDreamBasePart* part2, int PDGPart2, float RelativeK) {
@@ -430,6 +549,23 @@ void AliFemtoDreamHigherPairMath::MEMomentumResolution(
   }
 }
 
+void AliFemtoDreamHigherPairMath::MEMomentumResolution(
+    int iHC, const AliFemtoDreamMixingPart &part1, int PDGPart1,
+    float massPart1, const AliFemtoDreamMixingPart &part2, int PDGPart2,
+    float massPart2, float RelativeK) {
+  if (fWhichPairs[iHC] && fHists->GetObtainMomentumResolution()) {
+    TLorentzVector PartOne, PartTwo;
+    PartOne.SetXYZM(part1.fMCPx, part1.fMCPy, part1.fMCPz, massPart1);
+    PartTwo.SetXYZM(part2.fMCPx, part2.fMCPy, part2.fMCPz, massPart2);
+    float RelKTrue = RelativePairMomentum(PartOne, PartTwo);
+    fHists->FillMomentumResolutionMEAll(iHC, RelKTrue, RelativeK);
+    if ((PDGPart1 == TMath::Abs(part1.fMCPDGCode))
+        && ((PDGPart2 == TMath::Abs(part2.fMCPDGCode)))) {
+      fHists->FillMomentumResolutionME(iHC, RelKTrue, RelativeK);
+    }
+  }
+}
+
 float AliFemtoDreamHigherPairMath::RelativePairMomentum(
     AliFemtoDreamBasePart *part1, const int pdg1, AliFemtoDreamBasePart *part2,
     const int pdg2) {
@@ -515,6 +651,16 @@ bool AliFemtoDreamHigherPairMath::DeltaEtaDeltaPhi(int Hist,
                                                    AliFemtoDreamBasePart &part1,
                                                    AliFemtoDreamBasePart &part2,
                                                    bool SEorME, float relk) {
+  return DeltaEtaDeltaPhiAtRadii(Hist, BasePartRadii(part1),
+                                 BasePartRadii(part2), SEorME, relk);
+}
+
+template <class Part1, class Part2>
+bool AliFemtoDreamHigherPairMath::DeltaEtaDeltaPhiAtRadii(int Hist,
+                                                          const Part1 &part1,
+                                                          const Part2 &part2,
+                                                          bool SEorME,
+                                                          float relk) {
   bool pass = true;
   // if nDaug == 1 => Single Track, else decay
   unsigned int DoThisPair = fWhichPairs.at(Hist);
@@ -522,48 +668,45 @@ bool AliFemtoDreamHigherPairMath::DeltaEtaDeltaPhi(int Hist,
   if (nDaug1 > 9) {
     AliWarning("you are doing something wrong \n");
   }
-  if (nDaug1 > part1.GetPhiAtRaidius().size()) {
+  if (nDaug1 > part1.NDaughters()) {
     TString outMessage =
         TString::Format(
             "For pair number %u your number of Daughters 1 (%u) and Radii 1 (%u) do not correspond \n",
-            Hist, nDaug1, (unsigned int)part1.GetPhiAtRaidius().size());
+            Hist, nDaug1, part1.NDaughters());
     AliWarning(outMessage.Data());
   }
   unsigned int nDaug2 = (unsigned int) DoThisPair % 10;
 
-  if (nDaug2 > part2.GetPhiAtRaidius().size()) {
+  if (nDaug2 > part2.NDaughters()) {
     TString outMessage =
         TString::Format(
             "For pair number %u your number of Daughters 2 (%u) and Radii 2 (%u) do not correspond \n",
-            Hist, nDaug2, (unsigned int)part2.GetPhiAtRaidius().size());
+            Hist, nDaug2, part2.NDaughters());
     AliWarning(outMessage.Data());
   }
-  std::vector<float> eta1 = part1.GetEta();
-  std::vector<float> eta2 = part2.GetEta();
 
   for (unsigned int iDaug1 = 0; iDaug1 < nDaug1; ++iDaug1) {
-    std::vector<float> PhiAtRad1 = part1.GetPhiAtRaidius().at(iDaug1);
+    const unsigned int nRad1 = part1.NRadii(iDaug1);
     float etaPar1;
     if (nDaug1 == 1) {
-      etaPar1 = eta1.at(0);
+      etaPar1 = part1.Eta(0);
     } else {
-      etaPar1 = eta1.at(iDaug1 + 1);
+      etaPar1 = part1.Eta(iDaug1 + 1);
     }
     for (unsigned int iDaug2 = 0; iDaug2 < nDaug2; ++iDaug2) {
-      std::vector<float> phiAtRad2 = part2.GetPhiAtRaidius().at(iDaug2);
+      const unsigned int nRad2 = part2.NRadii(iDaug2);
       float etaPar2;
       if (nDaug2 == 1) {
-        etaPar2 = eta2.at(0);
+        etaPar2 = part2.Eta(0);
       } else {
-        etaPar2 = eta2.at(iDaug2 + 1);
+        etaPar2 = part2.Eta(iDaug2 + 1);
       }
       float deta = etaPar1 - etaPar2;
-      const int size =
-          (PhiAtRad1.size() > phiAtRad2.size()) ?
-              phiAtRad2.size() : PhiAtRad1.size();
+      const int size = (nRad1 > nRad2) ? nRad2 : nRad1;
       float dphiAvg = 0;
       for (int iRad = 0; iRad < size; ++iRad) {
-        float dphi = PhiAtRad1.at(iRad) - phiAtRad2.at(iRad);
+        float dphi = part1.PhiAtRadius(iDaug1, iRad)
+            - part2.PhiAtRadius(iDaug2, iRad);
         if (dphi > piHi) {
           dphi += -piHi * 2;
         } else if (dphi < -piHi) {
@@ -13,6 +13,7 @@
 #include "AliFemtoDreamBasePart.h"
 #include "AliFemtoDreamCollConfig.h"
 #include "AliFemtoDreamCorrHists.h"
+#include "AliFemtoDreamMixingEvent.h"
 #include <vector>
 class AliFemtoDreamHigherPairMath {
  public:
@@ -34,6 +35,9 @@ class AliFemtoDreamHigherPairMath {
   bool PassesPairSelection(int iHC, AliFemtoDreamBasePart& part1,
                            AliFemtoDreamBasePart& part2, float RelativeK,
                            bool SEorME, bool Recalculate);
+  bool PassesPairSelection(int iHC, const AliFemtoDreamMixingEvent &evt1,
+                           unsigned int i1, const AliFemtoDreamMixingEvent &evt2,
+                           unsigned int i2, float RelativeK, bool SEorME);
   bool CommonAncestors(AliFemtoDreamBasePart& part1, AliFemtoDreamBasePart& part2);
   void RecalculatePhiStar(AliFemtoDreamBasePart &part);
   float FillSameEvent(int iHC, int Mult, float cent, AliFemtoDreamBasePart& part1,
@@ -42,6 +46,9 @@ class AliFemtoDreamHigherPairMath {
               AliFemtoDreamBasePart &part2, int PDGPart2);
   void MEMassQA(int iHC, float RelK, AliFemtoDreamBasePart &part1, int PDGPart1,
               AliFemtoDreamBasePart &part2, int PDGPart2);
+  void MEMassQA(int iHC, float RelK, const AliFemtoDreamMixingPart &part1,
+                float massPart1, const AliFemtoDreamMixingPart &part2,
+                float massPart2);
   void SEMomentumResolution(int iHC, AliFemtoDreamBasePart* part1, int PDGPart1,
                             AliFemtoDreamBasePart* part2, int PDGPart2,
                             float RelativeK);
@@ -55,12 +62,21 @@ class AliFemtoDreamHigherPairMath {
   float FillMixedEvent(int iHC, int Mult, float cent, AliFemtoDreamBasePart& part1,
                        int PDGPart1, AliFemtoDreamBasePart& part2, int PDGPart2,
                        AliFemtoDreamCollConfig::UncorrelatedMode mode);
+  float FillMixedEvent(int iHC, int Mult, float cent, TLorentzVector &PartOne,
+                       TLorentzVector &PartTwo);
   void MEMomentumResolution(int iHC, AliFemtoDreamBasePart* part1, int PDGPart1,
                             AliFemtoDreamBasePart* part2, int PDGPart2,
                             float RelativeK);
+  void MEMomentumResolution(int iHC, const AliFemtoDreamMixingPart &part1,
+                            int PDGPart1, float massPart1,
+                            const AliFemtoDreamMixingPart &part2, int PDGPart2,
+                            float massPart2, float RelativeK);
   void MEDetaDPhiPlots(int iHC, AliFemtoDreamBasePart& part1, int PDGPart1,
                        AliFemtoDreamBasePart& part2, int PDGPart2,
                        float RelativeK, bool recalculate);
+  void MEDetaDPhiPlots(int iHC, const AliFemtoDreamMixingPart &part1,
+                       float massPart1, const AliFemtoDreamMixingPart &part2,
+                       float massPart2);
   void FillEffectiveMixingDepth(int iHC, int iDepth) {
     fHists->FillEffectiveMixingDepth(iHC, iDepth);
   }
@@ -95,6 +111,9 @@ class AliFemtoDreamHigherPairMath {
  private:
   bool DeltaEtaDeltaPhi(int Hist, AliFemtoDreamBasePart &part1,
                         AliFemtoDreamBasePart &part2, bool SEorME, float relk);
+  template <class Part1, class Part2>
+  bool DeltaEtaDeltaPhiAtRadii(int Hist, const Part1 &part1,
+                               const Part2 &part2, bool SEorME, float relk);
   AliFemtoDreamCorrHists *fHists;
   std::vector<unsigned int> fWhichPairs;
   float fBField;
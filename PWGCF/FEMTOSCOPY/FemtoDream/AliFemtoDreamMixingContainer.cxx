@@ -0,0 +1,42 @@
+/*
+ * AliFemtoDreamMixingContainer.cxx
+ *
+ *  Mixing buffer of one particle species in one ZVtx/Mult bin, holding
+ *  compact AliFemtoDreamMixingEvent copies instead of full particles.
+ */
+
+#include "AliFemtoDreamMixingContainer.h"
+
+AliFemtoDreamMixingContainer::AliFemtoDreamMixingContainer()
+    : fEvents(),
+      fNEvents(0),
+      fNext(0) {
+}
+
+AliFemtoDreamMixingContainer::AliFemtoDreamMixingContainer(int MixingDepth)
+    : fEvents(MixingDepth),
+      fNEvents(0),
+      fNext(0) {
+}
+
+AliFemtoDreamMixingContainer::~AliFemtoDreamMixingContainer() {
+}
+
+void AliFemtoDreamMixingContainer::SetEvent(
+    const std::vector<AliFemtoDreamBasePart> &Particles) {
+  if (fEvents.empty()) {
+    return;
+  }
+  //Overwrites the oldest event once the buffer is full
+  fEvents[fNext].Set(Particles);
+  fNext = (fNext + 1) % fEvents.size();
+  if (fNEvents < fEvents.size()) {
+    ++fNEvents;
+  }
+}
+
+const AliFemtoDreamMixingEvent &AliFemtoDreamMixingContainer::GetEvent(
+    int Depth) const {
+  const unsigned int size = fEvents.size();
+  return fEvents[(fNext + size - fNEvents + Depth) % size];
+}
@@ -0,0 +1,33 @@
+/*
+ * AliFemtoDreamMixingContainer.h
+ *
+ *  Mixing buffer of one particle species in one ZVtx/Mult bin, holding
+ *  compact AliFemtoDreamMixingEvent copies instead of full particles.
+ */
+
+#ifndef ALIFEMTODREAMMIXINGCONTAINER_H_
+#define ALIFEMTODREAMMIXINGCONTAINER_H_
+#include <vector>
+
+#include "AliFemtoDreamMixingEvent.h"
+
+//Ring buffer of the last MixingDepth events. The events are overwritten in
+//place, the storage is reused once the buffer is full. GetEvent(0) is the
+//oldest event, as for AliFemtoDreamPartContainer.
+class AliFemtoDreamMixingContainer {
+ public:
+  AliFemtoDreamMixingContainer();
+  AliFemtoDreamMixingContainer(int MixingDepth);
+  virtual ~AliFemtoDreamMixingContainer();
+  void SetEvent(const std::vector<AliFemtoDreamBasePart> &Particles);
+  const AliFemtoDreamMixingEvent &GetEvent(int Depth) const;
+  unsigned int GetMixingDepth() const {
+    return fNEvents;
+  }
+ private:
+  std::vector<AliFemtoDreamMixingEvent> fEvents;
+  unsigned int fNEvents;
+  unsigned int fNext;
+};
+
+#endif /* ALIFEMTODREAMMIXINGCONTAINER_H_ */
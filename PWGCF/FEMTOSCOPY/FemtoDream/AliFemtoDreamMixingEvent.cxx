@@ -0,0 +1,67 @@
+/*
+ * AliFemtoDreamMixingEvent.cxx
+ *
+ *  Compact copy of the particles of one species in one event, as kept in
+ *  the mixing buffers of AliFemtoDreamZVtxMultContainer.
+ */
+
+#include "AliFemtoDreamMixingEvent.h"
+
+AliFemtoDreamMixingEvent::AliFemtoDreamMixingEvent()
+    : fParts(),
+      fEtaPool(),
+      fPhiAtRadiusPool() {
+}
+
+AliFemtoDreamMixingEvent::~AliFemtoDreamMixingEvent() {
+}
+
+void AliFemtoDreamMixingEvent::Clear() {
+  fParts.clear();
+  fEtaPool.clear();
+  fPhiAtRadiusPool.clear();
+}
+
+void AliFemtoDreamMixingEvent::Set(
+    const std::vector<AliFemtoDreamBasePart> &Particles) {
+  Clear();
+  fParts.reserve(Particles.size());
+  for (auto &part : Particles) {
+    AliFemtoDreamMixingPart rec;
+    const TVector3 mom = part.GetMomentum();
+    const TVector3 mcMom = part.GetMCMomentum();
+    rec.fPx = mom.X();
+    rec.fPy = mom.Y();
+    rec.fPz = mom.Z();
+    rec.fMCPx = mcMom.X();
+    rec.fMCPy = mcMom.Y();
+    rec.fMCPz = mcMom.Z();
+    rec.fInvMass = part.GetInvMass();
+    rec.fMCPDGCode = part.GetMCPDGCode();
+
+    const std::vector<float> phi = part.GetPhi();
+    rec.fPhi = phi.empty() ? 0.f : phi[0];
+
+    const std::vector<float> eta = part.GetEta();
+    rec.fEta = eta.empty() ? 0.f : eta[0];
+    rec.fEtaOffset = fEtaPool.size();
+    rec.fNEta = eta.size();
+    fEtaPool.insert(fEtaPool.end(), eta.begin(), eta.end());
+
+    //All daughters are propagated to the same radii, in case they are not
+    //only the common ones are kept, as in the close pair rejection
+    const std::vector<std::vector<float>> phiAtRad = part.GetPhiAtRaidius();
+    unsigned int nRadii = phiAtRad.empty() ? 0 : phiAtRad[0].size();
+    for (auto &daug : phiAtRad) {
+      nRadii = (daug.size() < nRadii) ? daug.size() : nRadii;
+    }
+    rec.fPhiAtRadiusOffset = fPhiAtRadiusPool.size();
+    rec.fNDaughters = phiAtRad.size();
+    rec.fNRadii = nRadii;
+    for (auto &daug : phiAtRad) {
+      fPhiAtRadiusPool.insert(fPhiAtRadiusPool.end(), daug.begin(),
+                              daug.begin() + nRadii);
+    }
+    fParts.push_back(rec);
+  }
+}
@@ -0,0 +1,64 @@
+/*
+ * AliFemtoDreamMixingEvent.h
+ *
+ *  Compact copy of the particles of one species in one event, as kept in
+ *  the mixing buffers of AliFemtoDreamZVtxMultContainer.
+ */
+
+#ifndef ALIFEMTODREAMMIXINGEVENT_H_
+#define ALIFEMTODREAMMIXINGEVENT_H_
+#include <vector>
+
+#include "AliFemtoDreamBasePart.h"
+
+//Plain record with the quantities of one particle needed for the pairing
+//in the mixed event. Eta and phi at the TPC radii have a variable length,
+//they are stored in the pools of the AliFemtoDreamMixingEvent and the record
+//only holds the offsets.
+struct AliFemtoDreamMixingPart {
+  float fPx;
+  float fPy;
+  float fPz;
+  float fMCPx;
+  float fMCPy;
+  float fMCPz;
+  float fInvMass;
+  int fMCPDGCode;
+  float fEta;                   // first entry of AliFemtoDreamBasePart::GetEta()
+  float fPhi;                   // first entry of AliFemtoDreamBasePart::GetPhi()
+  unsigned int fEtaOffset;      // offset of all the eta values in the eta pool
+  unsigned int fNEta;
+  unsigned int fPhiAtRadiusOffset; // offset of the phi at radii in the radii pool
+  unsigned short fNDaughters;   // number of entries in GetPhiAtRaidius()
+  unsigned short fNRadii;       // number of radii per daughter
+};
+
+//Particles of one species of one event, stored contiguously. Refilling
+//an event keeps the capacity of the vectors, such that a ring buffer of
+//these objects does not allocate once it has been filled.
+class AliFemtoDreamMixingEvent {
+ public:
+  AliFemtoDreamMixingEvent();
+  virtual ~AliFemtoDreamMixingEvent();
+  void Set(const std::vector<AliFemtoDreamBasePart> &Particles);
+  void Clear();
+  unsigned int GetSize() const {
+    return fParts.size();
+  }
+  const AliFemtoDreamMixingPart &GetPart(unsigned int i) const {
+    return fParts[i];
+  }
+  const float *GetEta(unsigned int i) const {
+    return fEtaPool.data() + fParts[i].fEtaOffset;
+  }
+  const float *GetPhiAtRadius(unsigned int i, unsigned int iDaug) const {
+    return fPhiAtRadiusPool.data() + fParts[i].fPhiAtRadiusOffset
+        + iDaug * fParts[i].fNRadii;
+  }
+ private:
+  std::vector<AliFemtoDreamMixingPart> fParts;
+  std::vector<float> fEtaPool;
+  std::vector<float> fPhiAtRadiusPool;
+};
+
+#endif /* ALIFEMTODREAMMIXINGEVENT_H_ */
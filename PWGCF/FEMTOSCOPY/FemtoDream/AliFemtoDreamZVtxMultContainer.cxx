@@ -14,6 +14,7 @@
 ClassImp(AliFemtoDreamPartContainer)
 AliFemtoDreamZVtxMultContainer::AliFemtoDreamZVtxMultContainer()
     : fPartContainer(0),
+      fCurrentEvent(0),
       fPDGParticleSpecies(0),
       fWhichPairs(){
 }
@@ -21,7 +22,8 @@ AliFemtoDreamZVtxMultContainer::AliFemtoDreamZVtxMultContainer()
 AliFemtoDreamZVtxMultContainer::AliFemtoDreamZVtxMultContainer(
     AliFemtoDreamCollConfig *conf)
     : fPartContainer(conf->GetNParticles(),
-                     AliFemtoDreamPartContainer(conf->GetMixingDepth())),
+                     AliFemtoDreamMixingContainer(conf->GetMixingDepth())),
+      fCurrentEvent(conf->GetNParticles()),
       fPDGParticleSpecies(conf->GetPDGCodes()),
       fWhichPairs(conf->GetWhichPairs()){
   TDatabasePDG::Instance()->AddParticle("deuteron", "deuteron", 1.8756134,
@@ -45,8 +47,8 @@ void AliFemtoDreamZVtxMultContainer::SetEvent(
   //  } else {
   std::vector<std::vector<AliFemtoDreamBasePart>>::iterator itInput = Particles
       .begin();
-  std::vector<AliFemtoDreamPartContainer>::iterator itContainer = fPartContainer
-      .begin();
+  std::vector<AliFemtoDreamMixingContainer>::iterator itContainer =
+      fPartContainer.begin();
   while (itContainer != fPartContainer.end()) {
     if (itInput->size() > 0) {
       itContainer->SetEvent(*itInput);
@@ -120,63 +122,63 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesSE(
 void AliFemtoDreamZVtxMultContainer::PairParticlesME(
     std::vector<std::vector<AliFemtoDreamBasePart>> &Particles,
     AliFemtoDreamHigherPairMath *HigherMath, int iMult, float cent) {
+  //The particles of this event are packed the same way as the ones in the
+  //mixing buffer, such that the pair loops only run over compact records
+  fCurrentEvent.resize(Particles.size());
+  for (unsigned int iSpec = 0; iSpec < Particles.size(); ++iSpec) {
+    fCurrentEvent[iSpec].Set(Particles[iSpec]);
+  }
   int HistCounter = 0;
-  auto itPDGPar1 = fPDGParticleSpecies.begin();
   //First loop over all the different Species
-  for (auto itSpec1 = Particles.begin(); itSpec1 != Particles.end();
-      ++itSpec1) {
+  for (unsigned int iSpec1 = 0; iSpec1 < fCurrentEvent.size(); ++iSpec1) {
+    const AliFemtoDreamMixingEvent &Event1 = fCurrentEvent[iSpec1];
+    const int PDGPar1 = fPDGParticleSpecies[iSpec1];
+    const float MassPar1 = TDatabasePDG::Instance()->GetParticle(PDGPar1)
+        ->Mass();
     //We dont want to correlate the particles twice. Mixed Event Dist. of
     //Particle1 + Particle2 == Particle2 + Particle 1
-    int SkipPart = itSpec1 - Particles.begin();
-    auto itPDGPar2 = fPDGParticleSpecies.begin() + SkipPart;
-    for (auto itSpec2 = fPartContainer.begin() + SkipPart;
-        itSpec2 != fPartContainer.end(); ++itSpec2) {
-      if (itSpec1->size() > 0) {
-        HigherMath->FillEffectiveMixingDepth(HistCounter,
-                                             (int) itSpec2->GetMixingDepth());
+    for (unsigned int iSpec2 = iSpec1; iSpec2 < fPartContainer.size();
+        ++iSpec2) {
+      const AliFemtoDreamMixingContainer &Container2 = fPartContainer[iSpec2];
+      const int PDGPar2 = fPDGParticleSpecies[iSpec2];
+      const float MassPar2 = TDatabasePDG::Instance()->GetParticle(PDGPar2)
+          ->Mass();
+      if (Event1.GetSize() > 0) {
+        HigherMath->FillEffectiveMixingDepth(
+            HistCounter, (int) Container2.GetMixingDepth());
       }
-      for (int iDepth = 0; iDepth < (int) itSpec2->GetMixingDepth(); ++iDepth) {
-        std::vector<AliFemtoDreamBasePart> ParticlesOfEvent = itSpec2->GetEvent(
-            iDepth);
-        HigherMath->FillPairCounterME(HistCounter, itSpec1->size(),
-                                      ParticlesOfEvent.size());
-        for (auto itPart1 = itSpec1->begin(); itPart1 != itSpec1->end();
-            ++itPart1) {
-          for (auto itPart2 = ParticlesOfEvent.begin();
-              itPart2 != ParticlesOfEvent.end(); ++itPart2) {
-
+      for (int iDepth = 0; iDepth < (int) Container2.GetMixingDepth();
+          ++iDepth) {
+        const AliFemtoDreamMixingEvent &Event2 = Container2.GetEvent(iDepth);
+        HigherMath->FillPairCounterME(HistCounter, Event1.GetSize(),
+                                      Event2.GetSize());
+        for (unsigned int iPart1 = 0; iPart1 < Event1.GetSize(); ++iPart1) {
+          const AliFemtoDreamMixingPart &Part1 = Event1.GetPart(iPart1);
+          for (unsigned int iPart2 = 0; iPart2 < Event2.GetSize(); ++iPart2) {
+            const AliFemtoDreamMixingPart &Part2 = Event2.GetPart(iPart2);
             TLorentzVector PartOne, PartTwo;
-            PartOne.SetXYZM(
-                itPart1->GetMomentum().X(), itPart1->GetMomentum().Y(),
-                itPart1->GetMomentum().Z(),
-                TDatabasePDG::Instance()->GetParticle(*itPDGPar1)->Mass());
-            PartTwo.SetXYZM(
-                itPart2->GetMomentum().X(), itPart2->GetMomentum().Y(),
-                itPart2->GetMomentum().Z(),
-                TDatabasePDG::Instance()->GetParticle(*itPDGPar2)->Mass());
+            PartOne.SetXYZM(Part1.fPx, Part1.fPy, Part1.fPz, MassPar1);
+            PartTwo.SetXYZM(Part2.fPx, Part2.fPy, Part2.fPz, MassPar2);
             float RelativeK = HigherMath->RelativePairMomentum(PartOne, PartTwo);
-            if (!HigherMath->PassesPairSelection(HistCounter, *itPart1, *itPart2,
-                                                 RelativeK, false, false)) {
+            if (!HigherMath->PassesPairSelection(HistCounter, Event1, iPart1,
+                                                 Event2, iPart2, RelativeK,
+                                                 false)) {
               continue;
             }
-            RelativeK = HigherMath->FillMixedEvent(
-                HistCounter, iMult, cent, *itPart1, *itPDGPar1,
-                *itPart2, *itPDGPar2,
-                AliFemtoDreamCollConfig::kNone);
+            RelativeK = HigherMath->FillMixedEvent(HistCounter, iMult, cent,
+                                                   PartOne, PartTwo);
 
-            HigherMath->MEMassQA(HistCounter, RelativeK, *itPart1, *itPDGPar1,
-                                                         *itPart2, *itPDGPar2);
-            HigherMath->MEDetaDPhiPlots(HistCounter, *itPart1, *itPDGPar1,
-                                        *itPart2, *itPDGPar2, RelativeK, false);
-            HigherMath->MEMomentumResolution(HistCounter, &(*itPart1),
-                                             *itPDGPar1, &(*itPart2),
-                                             *itPDGPar2, RelativeK);
+            HigherMath->MEMassQA(HistCounter, RelativeK, Part1, MassPar1,
+                                 Part2, MassPar2);
+            HigherMath->MEDetaDPhiPlots(HistCounter, Part1, MassPar1, Part2,
+                                        MassPar2);
+            HigherMath->MEMomentumResolution(HistCounter, Part1, PDGPar1,
+                                             MassPar1, Part2, PDGPar2,
+                                             MassPar2, RelativeK);
           }
         }
       }
       ++HistCounter;
-      ++itPDGPar2;
     }
-    ++itPDGPar1;
   }
 }
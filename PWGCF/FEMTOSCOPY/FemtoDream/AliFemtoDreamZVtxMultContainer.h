@@ -13,6 +13,7 @@
 #include "AliFemtoDreamCollConfig.h"
 #include "AliFemtoDreamCorrHists.h"
 #include "AliFemtoDreamPartContainer.h"
+#include "AliFemtoDreamMixingContainer.h"
 #include "AliFemtoDreamHigherPairMath.h"
 
 //Class containing the array buffer of the different particle species for one
@@ -35,13 +36,16 @@ class AliFemtoDreamZVtxMultContainer {
                         AliFemtoDreamBasePart &part2);
   float ComputeDeltaPhi(AliFemtoDreamBasePart &part1,
                         AliFemtoDreamBasePart &part2);
+  //Only a compact copy of the particles is kept for the mixing, see
+  //AliFemtoDreamMixingEvent
   void SetEvent(std::vector<std::vector<AliFemtoDreamBasePart>> &Particles);
   TString ClassName() {
     return "zVtxMult Container";
   }
   ;
  private:
-  std::vector<AliFemtoDreamPartContainer> fPartContainer;
+  std::vector<AliFemtoDreamMixingContainer> fPartContainer;  //!
+  std::vector<AliFemtoDreamMixingEvent> fCurrentEvent;  //! packed particles of the event being mixed
   std::vector<int> fPDGParticleSpecies;
   std::vector<unsigned int> fWhichPairs;
 //  std::vector<bool> fRejPairs;
@@ -50,7 +54,7 @@ class AliFemtoDreamZVtxMultContainer {
 //  float fDeltaPhiMax;
 //  float fDeltaPhiEtaMax;
 
-ClassDef(AliFemtoDreamZVtxMultContainer, 4)
+ClassDef(AliFemtoDreamZVtxMultContainer, 5)
   ;
 };
 
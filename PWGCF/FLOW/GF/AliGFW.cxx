@@ -7,7 +7,8 @@ Extention of Generic Flow (https://arxiv.org/abs/1312.3572)
 need to add flags to have control over what is added, e.g. what happens, when I have several overlapping regions of different types: reference, pT-diff unID and pT-diff. ID?
 */
 AliGFW::AliGFW():
-  fInitialized(kFALSE)
+  fInitialized(kFALSE),
+  fEventStamp(0)
 {
 };
 
@@ -75,6 +76,7 @@ Int_t AliGFW::CreateRegions() {
     return 0;
   };
   SplitRegions();
+  fStringPlans.clear(); //strings are parsed again against the final regions
   //for(auto pitr = fRegions.begin(); pitr!=fRegions.end(); pitr++) pitr->PrintStructure();
   Int_t nRegions=0;
   for(auto pItr=fRegions.begin(); pItr!=fRegions.end(); pItr++) {
@@ -93,46 +95,107 @@ Int_t AliGFW::CreateRegions() {
 void AliGFW::Fill(Double_t eta, Int_t ptin, Double_t phi, Double_t weight, Int_t mask, Double_t SecondWeight) {
   if(!fInitialized) CreateRegions();
   if(!fInitialized) return;
+  fEventStamp++;
   for(Int_t i=0;i<(Int_t)fRegions.size();++i) {
     if(fRegions.at(i).EtaMin<eta && fRegions.at(i).EtaMax>eta && (fRegions.at(i).BitMask&mask))
       fCumulants.at(i).FillArray(eta,ptin,phi,weight,SecondWeight);
   };
 };
-TComplex AliGFW::TwoRec(Int_t n1, Int_t n2, Int_t p1, Int_t p2, Int_t ptbin, AliGFWCumulant *r1, AliGFWCumulant *r2, AliGFWCumulant *r3) {
-  TComplex part1 = r1->Vec(n1,p1,ptbin);
-  TComplex part2 = r2->Vec(n2,p2,ptbin);
-  TComplex part3 = r3?r3->Vec(n1+n2,p1+p2,ptbin):TComplex(0,0);
-  TComplex formula = part1*part2-part3;
-  return formula;
+void AliGFW::FillN(Int_t nTracks, const Double_t *eta, const Int_t *ptin, const Double_t *phi, const Double_t *weight, Int_t mask, const Double_t *SecondWeight) {
+  if(!fInitialized) CreateRegions();
+  if(!fInitialized) return;
+  fEventStamp++;
+  for(Int_t i=0;i<(Int_t)fRegions.size();++i) {
+    const Region &lRegion = fRegions[i];
+    if(!(lRegion.BitMask&mask)) continue;
+    fBufPt.clear();
+    fBufPhi.clear();
+    fBufWeight.clear();
+    fBufSecondWeight.clear();
+    for(Int_t j=0;j<nTracks;j++) {
+      if(!(lRegion.EtaMin<eta[j] && lRegion.EtaMax>eta[j])) continue;
+      fBufPt.push_back(ptin[j]);
+      fBufPhi.push_back(phi[j]);
+      fBufWeight.push_back(weight[j]);
+      fBufSecondWeight.push_back(SecondWeight?SecondWeight[j]:-1);
+    };
+    if(fBufPt.empty()) continue;
+    fCumulants.at(i).FillArrays((Int_t)fBufPt.size(),fBufPt.data(),fBufPhi.data(),fBufWeight.data(),fBufSecondWeight.data());
+  };
 };
-TComplex AliGFW::RecursiveCorr(AliGFWCumulant *qpoi, AliGFWCumulant *qref, AliGFWCumulant *qol, Int_t ptbin, vector<Int_t> hars, vector<Int_t> pows) {
-  if(pows.size()==0) //if powers are not initialized, initialize them to 1
-    for(Int_t i=0; i<(Int_t)hars.size(); i++)
-      pows.push_back(1);
-  if((pows.at(0)!=1) && qol) qpoi=qol; //if the power of POI is not unity, then always use overlap (if defined).
+Int_t AliGFW::CompileTerm(Int_t poi, Int_t ref, Int_t ovl, const vector<Int_t> &hars, const vector<Int_t> &pows) {
+  //Same recursion as the generic framework formula, but each distinct term is only created once
+  if(hars.size()==0) return -1;
+  if((pows.at(0)!=1) && ovl>-1) poi=ovl; //if the power of POI is not unity, then always use overlap (if defined).
   //Only valid for 1 particle of interest though!
-  if(hars.size()<2) return qpoi->Vec(hars.at(0),pows.at(0),ptbin);
-  if(hars.size()<3) return TwoRec(hars.at(0), hars.at(1),pows.at(0),pows.at(1), ptbin, qpoi, qref, qol);
-  Int_t harlast=hars.at(hars.size()-1);
-  Int_t powlast=pows.at(pows.size()-1);
-  hars.erase(hars.end()-1);
-  pows.erase(pows.end()-1);
-  TComplex formula = RecursiveCorr(qpoi, qref, qol, ptbin, hars, pows)*qref->Vec(harlast,powlast);
-  for(Int_t i=0;i<(Int_t)hars.size();i++) {
-    vector<Int_t> lhars = hars;
-    vector<Int_t> lpows = pows;
-    lhars.at(i)+=harlast;
-    lpows.at(i)+=powlast;
-    //The issue is here. In principle, if i=0 (dif), then the overlap is only qpoi (0, if no overlap);
-    //Otherwise, if we are not working with the 1st entry (dif.), then overlap will always be from qref
-    //One should thus (probably) make a check if i=0, then qovl=qpoi, otherwise qovl=qref. But need to think more
-    //-- This is not aplicable anymore, since the overlap is explicitly specified
-    formula-=RecursiveCorr(qpoi, qref, qol, ptbin, lhars, lpows);
+  vector<Int_t> key;
+  key.push_back(poi);
+  key.push_back(ref);
+  key.push_back(ovl);
+  key.insert(key.end(),hars.begin(),hars.end());
+  key.insert(key.end(),pows.begin(),pows.end());
+  auto found = fTermIndex.find(key);
+  if(found!=fTermIndex.end()) return found->second;
+  CorrTerm term;
+  term.Poi=poi;
+  term.Ref=ref;
+  term.Ovl=ovl;
+  term.Nhar=(Int_t)hars.size();
+  term.Har0=hars.at(0);
+  term.Pow0=pows.at(0);
+  term.Har1=(term.Nhar>1)?hars.at(1):0;
+  term.Pow1=(term.Nhar>1)?pows.at(1):0;
+  term.HarLast=hars.back();
+  term.PowLast=pows.back();
+  term.Prefix=-1;
+  if(term.Nhar>2) {
+    vector<Int_t> lhars(hars.begin(),hars.end()-1);
+    vector<Int_t> lpows(pows.begin(),pows.end()-1);
+    term.Prefix = CompileTerm(poi, ref, ovl, lhars, lpows);
+    for(Int_t i=0;i<(Int_t)lhars.size();i++) {
+      vector<Int_t> mhars = lhars;
+      vector<Int_t> mpows = lpows;
+      mhars.at(i)+=term.HarLast;
+      mpows.at(i)+=term.PowLast;
+      term.Subtract.push_back(CompileTerm(poi, ref, ovl, mhars, mpows));
+    };
+  };
+  fTerms.push_back(term);
+  Int_t index = (Int_t)fTerms.size()-1;
+  fTermIndex[key]=index;
+  //Stride of the memoization arrays changed, so start over
+  fTermValues.clear();
+  fTermStamp.clear();
+  return index;
+};
+TComplex AliGFW::EvaluateTerm(Int_t termIndex, Int_t ptbin) {
+  if(termIndex<0) return TComplex(0,0);
+  UInt_t ind = (UInt_t)ptbin*fTerms.size()+termIndex;
+  if(ind>=fTermStamp.size()) {
+    fTermStamp.resize((ptbin+1)*fTerms.size(),fEventStamp-1);
+    fTermValues.resize((ptbin+1)*fTerms.size());
   };
+  if(fTermStamp[ind]==fEventStamp) return fTermValues[ind];
+  const CorrTerm &term = fTerms[termIndex];
+  AliGFWCumulant *qpoi = &fCumulants.at(term.Poi);
+  AliGFWCumulant *qref = &fCumulants.at(term.Ref);
+  TComplex formula;
+  if(term.Nhar<2) formula = qpoi->Vec(term.Har0,term.Pow0,ptbin);
+  else if(term.Nhar<3) {
+    formula = qpoi->Vec(term.Har0,term.Pow0,ptbin)*qref->Vec(term.Har1,term.Pow1,ptbin);
+    if(term.Ovl>-1) formula-=fCumulants.at(term.Ovl).Vec(term.Har0+term.Har1,term.Pow0+term.Pow1,ptbin);
+  } else {
+    formula = EvaluateTerm(term.Prefix,ptbin)*qref->Vec(term.HarLast,term.PowLast);
+    for(Int_t i=0;i<(Int_t)term.Subtract.size();i++) formula-=EvaluateTerm(term.Subtract[i],ptbin);
+  };
+  //the recursion above does not add terms, so the memoization arrays are still valid here
+  fTermValues[ind]=formula;
+  fTermStamp[ind]=fEventStamp;
   return formula;
 };
 void AliGFW::Clear() {
   for(auto ptr = fCumulants.begin(); ptr!=fCumulants.end(); ++ptr) ptr->ResetQs();
+  fEventStamp++;
   fCalculatedNames.clear();
   fCalculatedQs.clear();
 };
@@ -141,24 +204,27 @@ TComplex AliGFW::Calculate(TString config, Bool_t SetHarmsToZero) {
     printf("Configuration empty!\n");
     return TComplex(0,0);
   };
-  TString tmp;
-  Ssiz_t sz1=0;
-  TComplex ret(1,0);
-  while(config.Tokenize(tmp,sz1,"}")) {
-    if(SetHarmsToZero) SetHarmonicsToZero(tmp);
-    /*Int_t ind=FindCalculated(tmp);
-    if(ind>=0) {
-      ret*=fCalculatedQs.at(ind);
-      continue;
-    };*/
-    TComplex val=CalculateSingle(tmp);
-    ret*=val;
-    fCalculatedQs.push_back(val);
-    fCalculatedNames.push_back(tmp);
+  //Parse the configuration only the first time it is requested
+  std::pair<TString,Bool_t> key(config,SetHarmsToZero);
+  auto found = fStringPlans.find(key);
+  if(found==fStringPlans.end()) {
+    vector<std::pair<Int_t,Int_t> > factors;
+    TString tmp;
+    Ssiz_t sz1=0;
+    while(config.Tokenize(tmp,sz1,"}")) {
+      if(SetHarmsToZero) SetHarmonicsToZero(tmp);
+      Int_t ptbin=0;
+      Int_t term=CompileSingle(tmp,ptbin);
+      factors.push_back(std::make_pair(term,ptbin));
+    };
+    found = fStringPlans.insert(std::make_pair(key,factors)).first;
   };
+  TComplex ret(1,0);
+  const vector<std::pair<Int_t,Int_t> > &factors = found->second;
+  for(Int_t i=0;i<(Int_t)factors.size();i++) ret*=EvaluateTerm(factors[i].first,factors[i].second);
   return ret;
 };
-TComplex AliGFW::CalculateSingle(TString config) {
+Int_t AliGFW::CompileSingle(TString config, Int_t &ptbin) {
   //First remove all ; and ,:
   config.ReplaceAll(","," ");
   config.ReplaceAll(";"," ");
@@ -166,7 +232,7 @@ TComplex AliGFW::CalculateSingle(TString config) {
   while(config.Index("  ")>-1) config.ReplaceAll("  "," ");
   vector<Int_t> regs;
   vector<Int_t> hars;
-  Int_t ptbin=0;
+  ptbin=0;
   Ssiz_t sz1=0;
   Ssiz_t szend=0;
   TString ts, ts2;
@@ -179,7 +245,7 @@ TComplex AliGFW::CalculateSingle(TString config) {
   if(sz1<0) sz1=0;
   if(!config.Tokenize(ts,szend,"{")) {
     printf("Could not find harmonics!\n");
-    return TComplex(0,0);
+    return -1;
   };
   //Fetch regions
   while(ts.Tokenize(ts2,sz1," ")) {
@@ -192,10 +258,16 @@ TComplex AliGFW::CalculateSingle(TString config) {
     };
     regs.push_back(ind);
   };
+  if(regs.size()==0) return -1;
   //Fetch harmonics
   while(config.Tokenize(ts,szend," ")) hars.push_back(ts.Atoi());
-  if(regs.size()==1) return Calculate(regs.at(0),hars);
-  return Calculate(regs.at(0),regs.at(1),hars,ptbin);
+  vector<Int_t> pows(hars.size(),1);
+  if(regs.size()==1) { //Integrated case
+    ptbin=0;
+    return CompileTerm(regs.at(0),regs.at(0),regs.at(0),hars,pows);
+  };
+  //Differential case: POI and reference, POI is also the overlap
+  return CompileTerm(regs.at(0),regs.at(1),regs.at(0),hars,pows);
 };
 AliGFW::CorrConfig AliGFW::GetCorrelatorConfig(TString config, TString head, Bool_t ptdif) {
   //First remove all ; and ,:
@@ -263,43 +335,69 @@ AliGFW::CorrConfig AliGFW::GetCorrelatorConfig(TString config, TString head, Boo
   return ReturnConfig;
 };
 
-TComplex AliGFW::Calculate(Int_t poi, Int_t ref, vector<Int_t> hars, Int_t ptbin) {
-  AliGFWCumulant *qref = &fCumulants.at(ref);
-  AliGFWCumulant *qpoi = &fCumulants.at(poi);
-  AliGFWCumulant *qovl = qpoi;
-  return RecursiveCorr(qpoi, qref, qovl, ptbin, hars);
+Int_t AliGFW::CompileCorrelator(const CorrConfig &corconf, Bool_t SetHarmsToZero, Bool_t DisableOverlap) {
+  CorrPlan plan;
+  plan.Poi=-1;
+  plan.Term1=-1;
+  plan.Term2=-1;
+  if(corconf.Regs.size()>0) {
+    Int_t poi = corconf.Regs.at(0);
+    Int_t ref = (corconf.Regs.size()>1)?corconf.Regs.at(1):corconf.Regs.at(0);
+    Int_t ovl = -1;
+    if(corconf.Overlap1 > -1)
+      ovl = DisableOverlap?-1:corconf.Overlap1;
+    else if(ref==poi) ovl = ref; //If ref and poi are the same, then the same is for overlap. Only, when OL not explicitly defined
+    vector<Int_t> hars = corconf.Hars;
+    if(SetHarmsToZero) for(Int_t i=0;i<(Int_t)hars.size();i++) hars.at(i) = 0;
+    plan.Poi = poi;
+    plan.Term1 = CompileTerm(poi, ref, ovl, hars, vector<Int_t>(hars.size(),1));
+    if(corconf.Regs2.size()>0) {
+      poi = corconf.Regs2.at(0);
+      ref = (corconf.Regs2.size()>1)?corconf.Regs2.at(1):corconf.Regs2.at(0);
+      if(corconf.Overlap2 > -1)
+        ovl = DisableOverlap?-1:corconf.Overlap2;
+      else if(ref==poi) ovl = ref; //Only when OL is not explicitly defined, then set it to ref/POI if they are the same
+      hars = corconf.Hars2;
+      if(SetHarmsToZero) for(Int_t i=0;i<(Int_t)hars.size();i++) hars.at(i) = 0;
+      plan.Term2 = CompileTerm(poi, ref, ovl, hars, vector<Int_t>(hars.size(),1));
+    };
+  };
+  fPlans.push_back(plan);
+  return (Int_t)fPlans.size()-1;
 };
-TComplex AliGFW::Calculate(CorrConfig corconf, Int_t ptbin, Bool_t SetHarmsToZero, Bool_t DisableOverlap) {
-  if(corconf.Regs.size()==0) return TComplex(0,0);
-  Int_t poi = corconf.Regs.at(0);
-  Int_t ref = (corconf.Regs.size()>1)?corconf.Regs.at(1):corconf.Regs.at(0);
-  AliGFWCumulant *qref = &fCumulants.at(ref);
-  AliGFWCumulant *qpoi = &fCumulants.at(poi);
-  AliGFWCumulant *qovl=0;
-  if(corconf.Overlap1 > -1)
-    qovl = DisableOverlap?0:(&fCumulants.at(corconf.Overlap1));//;DisableOverlap?0:qpoi;
-  else if(ref==poi) qovl = qref; //If ref and poi are the same, then the same is for overlap. Only, when OL not explicitly defined
-  if(!qpoi->IsPtBinFilled(ptbin)) return TComplex(0,0);
-  //if(!qref->IsPtBinFilled(ptbin)) return TComplex(0,0);
-  if(SetHarmsToZero) for(Int_t i=0;i<(Int_t)corconf.Hars.size();i++) corconf.Hars.at(i) = 0;
-  TComplex retval = RecursiveCorr(qpoi, qref, qovl, ptbin, corconf.Hars);
-  if(corconf.Regs2.size()==0) return retval;
-  poi = corconf.Regs2.at(0);
-  ref = (corconf.Regs2.size()>1)?corconf.Regs2.at(1):corconf.Regs2.at(0);
-  qref = &fCumulants.at(ref);
-  qpoi = &fCumulants.at(poi);
-  if(corconf.Overlap2 > -1)
-    qovl = DisableOverlap?0:(&fCumulants.at(corconf.Overlap2));//;DisableOverlap?0:qpoi;
-  else if(ref==poi) qovl = qref; //Only when OL is not explicitly defined, then set it to ref/POI if they are the same
-  if(SetHarmsToZero) for(Int_t i=0;i<(Int_t)corconf.Hars2.size();i++) corconf.Hars2.at(i) = 0;
-  retval*=RecursiveCorr(qpoi, qref, qovl, 0, corconf.Hars2);
+TComplex AliGFW::CalculatePlan(Int_t planIndex, Int_t ptbin) {
+  const CorrPlan &plan = fPlans.at(planIndex);
+  if(plan.Poi<0) return TComplex(0,0);
+  if(!fCumulants.at(plan.Poi).IsPtBinFilled(ptbin)) return TComplex(0,0);
+  TComplex retval = EvaluateTerm(plan.Term1,ptbin);
+  if(plan.Term2<0) return retval;
+  retval*=EvaluateTerm(plan.Term2,0);
   return retval;
 };
-
-TComplex AliGFW::Calculate(Int_t poi, vector<Int_t> hars) {
-  AliGFWCumulant *qpoi = &fCumulants.at(poi);
-  return RecursiveCorr(qpoi, qpoi, qpoi, 0, hars);
+TComplex AliGFW::Calculate(const CorrConfig &corconf, Int_t ptbin, Bool_t SetHarmsToZero, Bool_t DisableOverlap) {
+  if(corconf.Regs.size()==0) return TComplex(0,0);
+  //Look up the compiled plan; the key buffer is reused to avoid allocations per call
+  fPlanKey.clear();
+  fPlanKey.push_back(SetHarmsToZero);
+  fPlanKey.push_back(DisableOverlap);
+  fPlanKey.push_back(corconf.Overlap1);
+  fPlanKey.push_back(corconf.Overlap2);
+  fPlanKey.push_back(corconf.Regs.size());
+  fPlanKey.insert(fPlanKey.end(),corconf.Regs.begin(),corconf.Regs.end());
+  fPlanKey.push_back(corconf.Hars.size());
+  fPlanKey.insert(fPlanKey.end(),corconf.Hars.begin(),corconf.Hars.end());
+  fPlanKey.push_back(corconf.Regs2.size());
+  fPlanKey.insert(fPlanKey.end(),corconf.Regs2.begin(),corconf.Regs2.end());
+  fPlanKey.insert(fPlanKey.end(),corconf.Hars2.begin(),corconf.Hars2.end());
+  auto found = fPlanIndex.find(fPlanKey);
+  Int_t plan;
+  if(found==fPlanIndex.end()) {
+    plan = CompileCorrelator(corconf,SetHarmsToZero,DisableOverlap);
+    fPlanIndex[fPlanKey]=plan;
+  } else plan = found->second;
+  return CalculatePlan(plan,ptbin);
 };
+
 Int_t AliGFW::FindRegionByName(TString refName) {
   for(Int_t i=0;i<(Int_t)fRegions.size();i++) if(fRegions.at(i).rName.EqualTo(refName)) return i;
   return -1;
@@ -8,6 +8,7 @@ Extention of Generic Flow (https://arxiv.org/abs/1312.3572)
 #include <vector>
 #include <utility>
 #include <algorithm>
+#include <map>
 #include "TString.h"
 #include "TObjArray.h"
 using std::vector;
@@ -56,29 +57,59 @@ class AliGFW {
   void AddRegion(TString refName, Int_t lNhar, Int_t *lNparVec, Double_t lEtaMin, Double_t lEtaMax, Int_t lNpT=1, Int_t BitMask=1);
   Int_t CreateRegions();
   void Fill(Double_t eta, Int_t ptin, Double_t phi, Double_t weight, Int_t mask, Double_t secondWeight=-1);
+  //Batched version of Fill: nTracks tracks with the same mask, each region is filled with one call to AliGFWCumulant::FillArrays
+  void FillN(Int_t nTracks, const Double_t *eta, const Int_t *ptin, const Double_t *phi, const Double_t *weight, Int_t mask, const Double_t *secondWeight=0);
   void Clear();// { for(auto ptr = fCumulants.begin(); ptr!=fCumulants.end(); ++ptr) ptr->ResetQs(); };
   AliGFWCumulant GetCumulant(Int_t index) { return fCumulants.at(index); };
   TComplex Calculate(TString config, Bool_t SetHarmsToZero=kFALSE);
   CorrConfig GetCorrelatorConfig(TString config, TString head = "", Bool_t ptdif=kFALSE);
-  TComplex Calculate(CorrConfig corconf, Int_t ptbin, Bool_t SetHarmsToZero, Bool_t DisableOverlap=kFALSE);
+  TComplex Calculate(const CorrConfig &corconf, Int_t ptbin, Bool_t SetHarmsToZero, Bool_t DisableOverlap=kFALSE);
+  //Correlators compiled into plans once; sub-terms shared between plans are evaluated only once per event
+  Int_t CompileCorrelator(const CorrConfig &corconf, Bool_t SetHarmsToZero=kFALSE, Bool_t DisableOverlap=kFALSE);
+  TComplex CalculatePlan(Int_t plan, Int_t ptbin=0);
  private:
+  //One term of the recursion, i.e. one correlator of given regions, harmonics and powers
+  struct CorrTerm {
+    Int_t Poi, Ref, Ovl; //Region indices, Ovl=-1 if no overlap
+    Int_t Nhar; //1: single Q-vector, 2: explicit two-particle formula, >2: recursion
+    Int_t Har0, Har1, Pow0, Pow1; //Harmonics and powers of the first two particles (Nhar<3)
+    Int_t HarLast, PowLast; //Harmonic and power of the last particle (Nhar>2)
+    Int_t Prefix; //Term without the last particle (Nhar>2)
+    vector<Int_t> Subtract; //Terms with the last particle merged into one of the others (Nhar>2)
+  };
+  struct CorrPlan {
+    Int_t Poi; //Region for which the pT bin has to be filled
+    Int_t Term1, Term2; //Terms multiplied together, Term2=-1 if only one
+  };
   Bool_t fInitialized;
   void SplitRegions();
   AliGFWCumulant fEmptyCumulant;
-  TComplex TwoRec(Int_t n1, Int_t n2, Int_t p1, Int_t p2, Int_t ptbin, AliGFWCumulant*, AliGFWCumulant*, AliGFWCumulant*);
-  TComplex RecursiveCorr(AliGFWCumulant *qpoi, AliGFWCumulant *qref, AliGFWCumulant *qol, Int_t ptbin, vector<Int_t> hars, vector<Int_t> pows={}); //POI, Ref. flow, overlapping region
+  //Buffers for tracks selected in a region, reused by FillN
+  vector<Int_t> fBufPt; //!
+  vector<Double_t> fBufPhi; //!
+  vector<Double_t> fBufWeight; //!
+  vector<Double_t> fBufSecondWeight; //!
+  //Compiled terms and plans, with per-event memoization of term values
+  vector<CorrTerm> fTerms; //!
+  std::map<vector<Int_t>,Int_t> fTermIndex; //!
+  vector<CorrPlan> fPlans; //!
+  std::map<vector<Int_t>,Int_t> fPlanIndex; //!
+  std::map<std::pair<TString,Bool_t>,vector<std::pair<Int_t,Int_t> > > fStringPlans; //! (config string, harmonics set to zero) -> (term, pT bin) of each factor
+  vector<Int_t> fPlanKey; //! key buffer reused by Calculate(CorrConfig)
+  vector<TComplex> fTermValues; //!
+  vector<Long64_t> fTermStamp; //!
+  Long64_t fEventStamp; //! incremented whenever the Q-vectors change; memoized term values are valid only for the current stamp
+  Int_t CompileTerm(Int_t poi, Int_t ref, Int_t ovl, const vector<Int_t> &hars, const vector<Int_t> &pows);
+  TComplex EvaluateTerm(Int_t term, Int_t ptbin);
   //Deprecated and not used (for now):
-  void AddRegion(Region inreg) { fRegions.push_back(inreg); };
+  void AddRegion(Region inreg) { fRegions.push_back(inreg); fStringPlans.clear(); }; //parsed strings depend on the region names
   Region GetRegion(Int_t index) { return fRegions.at(index); };
   Int_t FindRegionByName(TString refName);
   vector<TString> fCalculatedNames;
   vector<TComplex> fCalculatedQs;
   Int_t FindCalculated(TString identifier);
-  //Calculateing functions:
-  TComplex Calculate(Int_t poi, Int_t ref, vector<Int_t> hars, Int_t ptbin=0); //For differential, need POI and reference
-  TComplex Calculate(Int_t poi, vector<Int_t> hars); //For integrated case
-  //Process one string (= one region)
-  TComplex CalculateSingle(TString config);
+  //Process one string (= one region), returns the compiled term
+  Int_t CompileSingle(TString config, Int_t &ptbin);
 
   Bool_t SetHarmonicsToZero(TString &instr);
 
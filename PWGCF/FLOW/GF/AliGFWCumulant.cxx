@@ -3,13 +3,20 @@ Author: Vytautas Vislavicius
 Extention of Generic Flow (https://arxiv.org/abs/1312.3572)
 */
 #include "AliGFWCumulant.h"
+#include <cstring>
+
+//Number of tracks processed together in FillArrays. Small enough to keep the temporary arrays on the stack
+static const Int_t kGFWTrackBlock = 64;
 
 AliGFWCumulant::AliGFWCumulant():
-  fQvector(0),
+  fQRe(0),
+  fQIm(0),
+  fPrefactors(0),
   fUsed(kBlank),
   fNEntries(-1),
   fN(1),
   fPow(1),
+  fMaxPow(1),
   fPt(1),
   fFilledPts(0),
   fInitialized(kFALSE)
@@ -22,51 +29,92 @@ AliGFWCumulant::~AliGFWCumulant()
   //DestroyComplexVectorArray();
 };
 void AliGFWCumulant::FillArray(Double_t eta, Int_t ptin, Double_t phi, Double_t weight, Double_t SecondWeight) {
+  FillArrays(1,&ptin,&phi,&weight,&SecondWeight);
+};
+void AliGFWCumulant::FillArrays(Int_t nTracks, const Int_t *ptin, const Double_t *phi, const Double_t *weight, const Double_t *SecondWeight) {
   if(!fInitialized)
     CreateComplexVectorArray(1,1,1);
-  if(fPt==1) ptin=0; //If one bin, then just fill it straight; otherwise, if ptin is out-of-range, do not fill
-  else if(ptin<0 || ptin>=fPt) return;
-  fFilledPts[ptin] = kTRUE;
-  for(Int_t lN = 0; lN<fN; lN++) {
-    Double_t lSin = TMath::Sin(lN*phi); //No need to recalculate for each power
-    Double_t lCos = TMath::Cos(lN*phi); //No need to recalculate for each power
-    for(Int_t lPow=0; lPow<PW(lN); lPow++) {
-      Double_t lPrefactor = 0;
-      //Dont calculate it twice; multiplication is cheaper that power
-      //Also, if second weight is specified, then keep the first weight with power no more than 1, and us the other weight otherwise
+  //Per-block temporaries: pT bin, cos/sin of phi, cos/sin of n*phi and weight prefactors for each power
+  Int_t lPt[kGFWTrackBlock];
+  Double_t lCos[kGFWTrackBlock], lSin[kGFWTrackBlock];
+  Double_t lCn[kGFWTrackBlock], lSn[kGFWTrackBlock];
+  Double_t lBase[kGFWTrackBlock];
+  Double_t *lPf = fPrefactors;
+  Int_t lTrack=0;
+  while(lTrack<nTracks) {
+    //Collect the next block of tracks with a valid pT bin
+    Int_t nb=0;
+    for(;lTrack<nTracks && nb<kGFWTrackBlock;lTrack++) {
+      Int_t lPtBin = ptin[lTrack];
+      if(fPt==1) lPtBin=0; //If one bin, then just fill it straight; otherwise, if ptin is out-of-range, do not fill
+      else if(lPtBin<0 || lPtBin>=fPt) continue;
+      fFilledPts[lPtBin] = kTRUE;
+      lPt[nb] = lPtBin;
+      lCos[nb] = TMath::Cos(phi[lTrack]);
+      lSin[nb] = TMath::Sin(phi[lTrack]);
+      //If second weight is specified, then keep the first weight with power no more than 1, and use the other weight otherwise
       //this is important when POIs are a subset of REFs and have different weights than REFs
-      if(SecondWeight>0 && lPow>1) lPrefactor = TMath::Power(SecondWeight, lPow-1)*weight;
-      else lPrefactor = TMath::Power(weight,lPow);
-      Double_t qsin = lPrefactor * lSin;
-      Double_t qcos = lPrefactor * lCos;
-      fQvector[ptin][lN][lPow](fQvector[ptin][lN][lPow].Re()+qcos,fQvector[ptin][lN][lPow].Im()+qsin);//+=TComplex(qcos,qsin);
+      Double_t lSecondWeight = SecondWeight?SecondWeight[lTrack]:-1;
+      lBase[nb] = (lSecondWeight>0)?lSecondWeight:weight[lTrack];
+      lPf[nb] = 1;
+      if(fMaxPow>1) lPf[kGFWTrackBlock+nb] = weight[lTrack];
+      nb++;
+    };
+    if(!nb) break;
+    //Weight prefactors for higher powers: multiplication is cheaper than power
+    for(Int_t lPow=2; lPow<fMaxPow; lPow++) {
+      const Double_t *lPrev = lPf+(lPow-1)*kGFWTrackBlock;
+      Double_t *lCurr = lPf+lPow*kGFWTrackBlock;
+      for(Int_t i=0;i<nb;i++) lCurr[i] = lPrev[i]*lBase[i];
+    };
+    //Harmonics via complex multiplication recurrence: e^{i(n+1)phi} = e^{in phi} e^{i phi}
+    for(Int_t i=0;i<nb;i++) { lCn[i]=1; lSn[i]=0; };
+    for(Int_t lN=0; lN<fN; lN++) {
+      if(lN>0) {
+        for(Int_t i=0;i<nb;i++) {
+          Double_t lTmp = lCn[i]*lCos[i]-lSn[i]*lSin[i];
+          lSn[i] = lSn[i]*lCos[i]+lCn[i]*lSin[i];
+          lCn[i] = lTmp;
+        };
+      };
+      for(Int_t lPow=0; lPow<fPowVec[lN]; lPow++) {
+        const Double_t *lPfPow = lPf+lPow*kGFWTrackBlock;
+        if(fPt==1) {
+          Double_t qcos=0, qsin=0;
+          for(Int_t i=0;i<nb;i++) {
+            qcos += lPfPow[i]*lCn[i];
+            qsin += lPfPow[i]*lSn[i];
+          };
+          fQRe[QIndex(0,lN,lPow)] += qcos;
+          fQIm[QIndex(0,lN,lPow)] += qsin;
+        } else {
+          for(Int_t i=0;i<nb;i++) {
+            Int_t ind = QIndex(lPt[i],lN,lPow);
+            fQRe[ind] += lPfPow[i]*lCn[i];
+            fQIm[ind] += lPfPow[i]*lSn[i];
+          };
+        };
+      };
     };
+    fNEntries+=nb;
   };
-  Inc();
 };
 void AliGFWCumulant::ResetQs() {
   if(!fNEntries) return; //If 0 entries, then no need to reset. Otherwise, if -1, then just initialized and need to set to 0.
-  for(Int_t i=0; i<fPt; i++) {
-    fFilledPts[i] = kFALSE;
-    for(Int_t lN=0;lN<fN;lN++) {
-      for(Int_t lPow=0;lPow<PW(lN);lPow++) {
-  	       fQvector[i][lN][lPow](0.,0.);
-      };
-    };
-  };
+  for(Int_t i=0; i<fPt; i++) fFilledPts[i] = kFALSE;
+  Int_t lSize = fPt*fN*fMaxPow;
+  memset(fQRe,0,lSize*sizeof(Double_t));
+  memset(fQIm,0,lSize*sizeof(Double_t));
   fNEntries=0;
 };
 void AliGFWCumulant::DestroyComplexVectorArray() {
   if(!fInitialized) return;
-  for(Int_t l_n = 0; l_n<fN; l_n++) {
-    for(Int_t i=0;i<fPt;i++) {
-      delete [] fQvector[i][l_n];
-    };
-  };
-  for(Int_t i=0;i<fPt;i++) {
-    delete [] fQvector[i];
-  };
-  delete [] fQvector;
+  delete [] fQRe;
+  delete [] fQIm;
+  fQRe=0;
+  fQIm=0;
+  delete [] fPrefactors;
+  fPrefactors=0;
   delete [] fFilledPts;
   fInitialized=kFALSE;
   fNEntries=-1;
@@ -85,21 +133,19 @@ void AliGFWCumulant::CreateComplexVectorArrayVarPower(Int_t N, vector<Int_t> Pow
   fPt=Pt;
   fFilledPts = new Bool_t[Pt];
   fPowVec = PowVec;
-  fQvector = new TComplex**[fPt];
-  for(Int_t i=0;i<fPt;i++) {
-    fQvector[i] = new TComplex*[fN];
-  };
-  for(Int_t l_n=0;l_n<fN;l_n++) {
-    for(Int_t i=0;i<fPt;i++) {
-      fQvector[i][l_n] = new TComplex[PW(l_n)];
-    };
-  };
+  fMaxPow=1;
+  for(Int_t l_n=0;l_n<fN;l_n++) if(PW(l_n)>fMaxPow) fMaxPow=PW(l_n);
+  Int_t lSize = fPt*fN*fMaxPow;
+  fQRe = new Double_t[lSize];
+  fQIm = new Double_t[lSize];
+  fPrefactors = new Double_t[fMaxPow*kGFWTrackBlock];
+  fNEntries=-1; //Make sure the arrays are zeroed
   ResetQs();
   fInitialized=kTRUE;
 };
 TComplex AliGFWCumulant::Vec(Int_t n, Int_t p, Int_t ptbin) {
   if(!fInitialized) return 0;
   if(ptbin>=fPt || ptbin<0) ptbin=0;
-  if(n>=0) return fQvector[ptbin][n][p];
-  return TComplex::Conjugate(fQvector[ptbin][-n][p]);
+  if(n>=0) return TComplex(fQRe[QIndex(ptbin,n,p)],fQIm[QIndex(ptbin,n,p)]);
+  return TComplex(fQRe[QIndex(ptbin,-n,p)],-fQIm[QIndex(ptbin,-n,p)]);
 };
@@ -8,6 +8,7 @@ Extention of Generic Flow (https://arxiv.org/abs/1312.3572)
 #include "TNamed.h"
 #include "TMath.h"
 #include "TAxis.h"
+#include <vector>
 using std::vector;
 class AliGFWCumulant {
  public:
@@ -15,12 +16,17 @@ class AliGFWCumulant {
   ~AliGFWCumulant();
   void ResetQs();
   void FillArray(Double_t eta, Int_t ptin, Double_t phi, Double_t weight=1, Double_t SecondWeight=-1);
+  //Fills a batch of tracks at once. SecondWeight can be 0, then it is -1 (=not used) for all tracks
+  void FillArrays(Int_t nTracks, const Int_t *ptin, const Double_t *phi, const Double_t *weight, const Double_t *SecondWeight=0);
   enum UsedFlags_t {kBlank = 0, kFull=1, kPt=2};
   void SetType(UInt_t infl) { DestroyComplexVectorArray(); fUsed = infl; };
   void Inc() { fNEntries++; };
   Int_t GetN() { return fNEntries; };
   // protected:
-  TComplex ***fQvector;
+  //Q-vectors are stored as structure of arrays, real and imaginary parts separately, indexed [ptbin][harmonic][power]
+  Double_t *fQRe; //!
+  Double_t *fQIm; //!
+  Double_t *fPrefactors; //! Scratch space for weight prefactors of a block of tracks in FillArrays
   UInt_t fUsed;
   Int_t fNEntries;
   //Q-vectors. Could be done recursively, but maybe defining each one of them explicitly is easier to read
@@ -28,12 +34,14 @@ class AliGFWCumulant {
   Int_t fN; //! Harmonics
   Int_t fPow; //! Power
   vector<Int_t> fPowVec; //! Powers array
+  Int_t fMaxPow; //! Largest number of powers, stride of the Q-vector arrays
   Int_t fPt; //!fPt bins
   Bool_t *fFilledPts;
   Bool_t fInitialized; //Arrays are initialized
   void CreateComplexVectorArray(Int_t N=1, Int_t P=1, Int_t Pt=1);
   void CreateComplexVectorArrayVarPower(Int_t N=1, vector<Int_t> Pvec={1}, Int_t Pt=1);
   Int_t PW(Int_t ind) { return fPowVec.at(ind); }; //No checks to speed up, be carefull!!!
+  Int_t QIndex(Int_t ptbin, Int_t n, Int_t p) { return (ptbin*fN+n)*fMaxPow+p; }; //No checks either
   void DestroyComplexVectorArray();
   Bool_t IsPtBinFilled(Int_t ptb) { if(!fFilledPts) return kFALSE; return fFilledPts[ptb]; };
 };
@@ -49,7 +49,8 @@ AliHistogramManager::AliHistogramManager() :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(0)
+  fNVars(0),
+  fFillPlans()
 {
   //
   // Constructor
@@ -71,7 +72,8 @@ AliHistogramManager::AliHistogramManager(const Char_t* name, Int_t nvars) :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(nvars)
+  fNVars(nvars),
+  fFillPlans()
 {
   //
   // Constructor
@@ -130,6 +132,7 @@ void AliHistogramManager::AddHistClass(const Char_t* histClass) {
   THashList* hList=new THashList;
   hList->SetOwner(kTRUE);
   hList->SetName(histClass);
+  hList->SetUniqueID(fMainList.GetEntries());   // position in the main list, used as the class handle
   fMainList.Add(hList);
 }
 
@@ -620,150 +623,176 @@ THnF* AliHistogramManager::CreateHistogram( const Char_t* name, const Char_t* ti
 
 
 //__________________________________________________________________
-void AliHistogramManager::FillHistClass(const Char_t* className, Float_t* values) {
+Int_t AliHistogramManager::GetHistClassHandle(const Char_t* className) {
   //
-  //  fill a class of histograms
+  // Return an integer handle of the histogram class, to be used with FillHistClass(Int_t, Float_t*)
+  // The handle is the position of the class in the main list, so it stays valid after streaming
   //
   THashList* hList = (THashList*)fMainList.FindObject(className);
   if(!hList) {
-    /*cout << "Warning in AliHistogramManager::FillHistClass(): Histogram list " << className << " not found!" << endl;
-    cout << "         Histogram list not filled" << endl; */
-    return;
+    cout << "Warning in AliHistogramManager::GetHistClassHandle(): Histogram list " << className << " not found!" << endl;
+    return -1;
   }
-  if(!hList) {
-    return;
+  SyncFillPlans();
+  Int_t handle = hList->GetUniqueID();
+  if(handle<(Int_t)fFillPlans.size() && fFillPlans[handle].fList==hList) return handle;
+  return fMainList.IndexOf(hList);
+}
+
+//__________________________________________________________________
+void AliHistogramManager::SyncFillPlans() {
+  //
+  // Make sure there is one fill plan per histogram class in the main list
+  //
+  if((Int_t)fFillPlans.size()==fMainList.GetEntries()) return;
+  fFillPlans.resize(fMainList.GetEntries());
+  TIter next(&fMainList);
+  THashList* hList=0x0;
+  Int_t iclass=0;
+  while((hList=(THashList*)next())) {
+    if(fFillPlans[iclass].fList!=hList) {
+      fFillPlans[iclass].fList = hList;
+      fFillPlans[iclass].fNHists = -1;
+    }
+    hList->SetUniqueID(iclass);
+    ++iclass;
   }
-    
-  TIter next(hList);
+}
+
+//__________________________________________________________________
+void AliHistogramManager::CompileFillPlan(FillPlan& plan) {
+  //
+  // Decode the histogram types and the variables from the unique IDs, once for all histograms in the class
+  // Histograms using variables which are not flagged as used are not filled, as before
+  //
+  plan.fEntries.clear();
+  plan.fVars.clear();
+  plan.fNHists = plan.fList->GetEntries();
+  
+  TIter next(plan.fList);
   TObject* h=0x0;
-  Bool_t isProfile;
-  Bool_t isTHn;
-  Int_t thnDim=0;
-  Bool_t isSparse=kFALSE;
-  Double_t fillValues[20]={0.0};
-  Int_t uid = 0;
-  Int_t varX=-1, varY=-1, varZ=-1, varT=-1, varW=-1;
-  Int_t dimension=0;
   while((h=next())) {
-    Bool_t allVarsGood = kTRUE;
-    uid = h->GetUniqueID();
-    isProfile = (uid%10==1 ? kTRUE : kFALSE);   // units digit encodes the isProfile
-    isTHn = ((uid%100)>10 ? kTRUE : kFALSE);      
-    if(isTHn) thnDim = (uid%100)-10;        // the excess over 10 from the last 2 digits give the dimension of the THn
-    if(isTHn && ((TString)h->ClassName()).Contains("Sparse")) isSparse = kTRUE;
-    dimension = 0;
-    if(!isTHn) dimension = ((TH1*)h)->GetDimension();
-        
+    Int_t uid = h->GetUniqueID();
+    Bool_t isProfile = (uid%10==1 ? kTRUE : kFALSE);   // units digit encodes the isProfile
+    Bool_t isTHn = ((uid%100)>10 ? kTRUE : kFALSE);
+    Int_t thnDim = (isTHn ? (uid%100)-10 : 0);          // the excess over 10 from the last 2 digits give the dimension of the THn
+    
     uid = (uid-(uid%100))/100;
-    varX = -1;
-    varY = -1;
-    varZ = -1;
-    varT = -1;
-    varW = -1;
+    Int_t varT = -1;
+    Int_t varW = AliReducedVarManager::kNothing;
     if(uid>0) {
       varW = uid%(fNVars+1)-1;
       if(varW==0) varW=AliReducedVarManager::kNothing;
       uid = (uid-(uid%(fNVars+1)))/(fNVars+1);
       if(uid>0) varT = uid - 1;
-      //cout << "Filling " << h->GetName() << " with varT " << varT << endl;
     }
-        
-    if(!isTHn) {
-      varX = ((TH1*)h)->GetXaxis()->GetUniqueID();
-      if(fUsedVars[varX]) {
-        switch(dimension) {
-          case 1:
-            if(isProfile) {
-              varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-              if(!fUsedVars[varY]) break;
-              if(varW>AliReducedVarManager::kNothing) { 
-                if(!fUsedVars[varW]) break;
-                ((TProfile*)h)->Fill(values[varX],values[varY],values[varW]);
-              }
-              else 
-                ((TProfile*)h)->Fill(values[varX],values[varY]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH1F*)h)->Fill(values[varX],values[varW]);
-              }
-              else
-                ((TH1F*)h)->Fill(values[varX]);
-            }
-          break;
-          case 2:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            if(isProfile) {
-              varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-              if(!fUsedVars[varZ]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ]);        
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH2F*)h)->Fill(values[varX],values[varY], values[varW]);
-              }
-              else
-                ((TH2F*)h)->Fill(values[varX],values[varY]);
-            }
-          break;
-          case 3:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-            if(!fUsedVars[varZ]) break;
-            if(isProfile) {
-              if(!fUsedVars[varT]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT],values[varW]);
-              }
-              else
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ]);
-            }
-          break;
-          default:
-          break;
-        }  // end switch
-      }
-    }  // end if(!isTHn)
+    if(varW>AliReducedVarManager::kNothing && !fUsedVars[varW]) continue;
+    
+    FillEntry entry;
+    entry.fHist = h;
+    entry.fFirstVar = plan.fVars.size();
+    entry.fVarW = varW;
+    Bool_t allVarsGood = kTRUE;
+    if(isTHn) {
+      if(thnDim>20) continue;
+      Bool_t isSparse = h->InheritsFrom(THnSparse::Class());
+      entry.fKind = (isSparse ? kFillTHnSparse : kFillTHn);
+      entry.fNVars = thnDim;
+      for(Int_t idim=0;idim<thnDim;++idim)
+        plan.fVars.push_back(((THnBase*)h)->GetAxis(idim)->GetUniqueID());
+    }
     else {
-      for(Int_t idim=0;idim<thnDim;++idim) {
-        if (isSparse) {
-          allVarsGood &= fUsedVars[((THnSparseF*)h)->GetAxis(idim)->GetUniqueID()];
-          fillValues[idim] = values[((THnSparseF*)h)->GetAxis(idim)->GetUniqueID()];
-        } else {
-          allVarsGood &= fUsedVars[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
-          fillValues[idim] = values[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
-        }
-      }
-      if(allVarsGood) {
-        if(varW>AliReducedVarManager::kNothing) {
-          if(fUsedVars[varW]) {
-            if (isSparse) ((THnSparseF*)h)->Fill(fillValues,values[varW]);
-            else          ((THnF*)h)->Fill(fillValues,values[varW]);
-          }
-        }
-        else {
-          if (isSparse) ((THnSparseF*)h)->Fill(fillValues);
-          else          ((THnF*)h)->Fill(fillValues);
-        }
+      TH1* h1 = (TH1*)h;
+      Int_t dimension = h1->GetDimension();
+      if(dimension<1 || dimension>3) continue;
+      plan.fVars.push_back(h1->GetXaxis()->GetUniqueID());
+      if(dimension>1 || isProfile) plan.fVars.push_back(h1->GetYaxis()->GetUniqueID());
+      if(dimension>2 || (dimension==2 && isProfile)) plan.fVars.push_back(h1->GetZaxis()->GetUniqueID());
+      if(dimension==3 && isProfile) {
+        if(varT<0) allVarsGood = kFALSE;
+        else plan.fVars.push_back(varT);
       }
+      entry.fNVars = plan.fVars.size()-entry.fFirstVar;
+      if(isProfile) entry.fKind = (dimension==1 ? kFillProfile : (dimension==2 ? kFillProfile2D : kFillProfile3D));
+      else          entry.fKind = (dimension==1 ? kFillTH1 : (dimension==2 ? kFillTH2 : kFillTH3));
+    }
+    for(Int_t ivar=entry.fFirstVar; ivar<(Int_t)plan.fVars.size(); ++ivar)
+      allVarsGood &= fUsedVars[plan.fVars[ivar]];
+    if(!allVarsGood) {
+      plan.fVars.resize(entry.fFirstVar);
+      continue;
+    }
+    plan.fEntries.push_back(entry);
+  }
+}
+
+//__________________________________________________________________
+void AliHistogramManager::FillHistClass(const Char_t* className, Float_t* values) {
+  //
+  //  fill a class of histograms
+  //
+  THashList* hList = (THashList*)fMainList.FindObject(className);
+  if(!hList) {
+    /*cout << "Warning in AliHistogramManager::FillHistClass(): Histogram list " << className << " not found!" << endl;
+    cout << "         Histogram list not filled" << endl; */
+    return;
+  }
+  SyncFillPlans();
+  Int_t handle = hList->GetUniqueID();
+  if(handle>=(Int_t)fFillPlans.size() || fFillPlans[handle].fList!=hList) handle = fMainList.IndexOf(hList);
+  FillHistClass(handle, values);
+}
+
+//__________________________________________________________________
+void AliHistogramManager::FillHistClass(Int_t classHandle, Float_t* values) {
+  //
+  //  fill a class of histograms using its precompiled fill plan
+  //
+  if(classHandle<0) return;
+  SyncFillPlans();
+  if(classHandle>=(Int_t)fFillPlans.size()) return;
+  FillPlan& plan = fFillPlans[classHandle];
+  if(plan.fNHists!=plan.fList->GetEntries()) CompileFillPlan(plan);   // histograms were added since the last fill
+  
+  Double_t fillValues[20]={0.0};
+  const Int_t* vars = 0x0;
+  for(std::vector<FillEntry>::const_iterator it=plan.fEntries.begin(); it!=plan.fEntries.end(); ++it) {
+    const FillEntry& e = *it;
+    vars = &plan.fVars[e.fFirstVar];
+    Bool_t weighted = (e.fVarW>AliReducedVarManager::kNothing);
+    switch(e.fKind) {
+      case kFillTH1:
+        if(weighted) ((TH1*)e.fHist)->Fill(values[vars[0]],values[e.fVarW]);
+        else         ((TH1*)e.fHist)->Fill(values[vars[0]]);
+        break;
+      case kFillTH2:
+        if(weighted) ((TH2*)e.fHist)->Fill(values[vars[0]],values[vars[1]],values[e.fVarW]);
+        else         ((TH2*)e.fHist)->Fill(values[vars[0]],values[vars[1]]);
+        break;
+      case kFillTH3:
+        if(weighted) ((TH3*)e.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[e.fVarW]);
+        else         ((TH3*)e.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]]);
+        break;
+      case kFillProfile:
+        if(weighted) ((TProfile*)e.fHist)->Fill(values[vars[0]],values[vars[1]],values[e.fVarW]);
+        else         ((TProfile*)e.fHist)->Fill(values[vars[0]],values[vars[1]]);
+        break;
+      case kFillProfile2D:
+        if(weighted) ((TProfile2D*)e.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[e.fVarW]);
+        else         ((TProfile2D*)e.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]]);
+        break;
+      case kFillProfile3D:
+        if(weighted) ((TProfile3D*)e.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[vars[3]],values[e.fVarW]);
+        else         ((TProfile3D*)e.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[vars[3]]);
+        break;
+      case kFillTHn:
+      case kFillTHnSparse:
+        for(Int_t idim=0;idim<e.fNVars;++idim) fillValues[idim] = values[vars[idim]];
+        if(weighted) ((THnBase*)e.fHist)->Fill(fillValues,values[e.fVarW]);
+        else         ((THnBase*)e.fHist)->Fill(fillValues);
+        break;
+      default:
+        break;
     }
   }
 }
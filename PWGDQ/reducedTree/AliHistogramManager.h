@@ -14,6 +14,8 @@
 #include <TList.h>
 #include <THashList.h>
 
+#include <vector>
+
 #include "AliReducedVarManager.h"
 
 class TAxis;
@@ -69,6 +71,8 @@ class AliHistogramManager : public TObject {
                         TAxis* axis);
   
   void FillHistClass(const Char_t* className, Float_t* values);
+  void FillHistClass(Int_t classHandle, Float_t* values);
+  Int_t GetHistClassHandle(const Char_t* className);   // integer handle of a histogram class, -1 if not found
   
   void SetUseDefaultVariableNames(Bool_t flag) {fUseDefaultVariableNames = flag;};
   void SetDefaultVarNames(TString* vars, TString* units);
@@ -106,7 +110,26 @@ class AliHistogramManager : public TObject {
   TString fVariableUnits[AliReducedVarManager::kNVars];               //! variable units
   Int_t fNVars;                          // maximum number of variables
   
+  // Fill plan of a histogram class, decoded once from the histogram and axis unique IDs
+  enum EFillKind {kFillTH1=0, kFillTH2, kFillTH3, kFillProfile, kFillProfile2D, kFillProfile3D, kFillTHn, kFillTHnSparse};
+  struct FillEntry {
+    TObject* fHist;      // histogram to be filled
+    Int_t fKind;         // one of EFillKind
+    Int_t fNVars;        // number of variables used for the coordinates
+    Int_t fFirstVar;     // position of the first variable in FillPlan::fVars
+    Int_t fVarW;         // weight variable, kNothing if not weighted
+  };
+  struct FillPlan {
+    THashList* fList;                  // histogram class
+    Int_t fNHists;                     // number of histograms in the list when the plan was compiled, -1 if not compiled
+    std::vector<FillEntry> fEntries;   // one entry per histogram
+    std::vector<Int_t> fVars;          // variable indices of all entries
+  };
+  std::vector<FillPlan> fFillPlans;    //! fill plans, indexed by the position of the class in fMainList
+  
   void MakeAxisLabels(TAxis* ax, const Char_t* labels);
+  void SyncFillPlans();
+  void CompileFillPlan(FillPlan& plan);
   
   ClassDef(AliHistogramManager, 4)
 };
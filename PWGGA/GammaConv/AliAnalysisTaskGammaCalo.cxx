@@ -457,6 +457,7 @@ AliAnalysisTaskGammaCalo::AliAnalysisTaskGammaCalo(): AliAnalysisTaskSE(),
   fIsOverlappingWithOtherHeader(kFALSE),
   fIsMC(0),
   fDoTHnSparse(kTRUE),
+  fUsePooledBGBuffers(kFALSE),
   fSetPlotHistsExtQA(kFALSE),
   fDoSoftAnalysis(kFALSE),
   fWeightJetJetMC(1),
@@ -876,6 +877,7 @@ AliAnalysisTaskGammaCalo::AliAnalysisTaskGammaCalo(const char *name):
   fIsOverlappingWithOtherHeader(kFALSE),
   fIsMC(0),
   fDoTHnSparse(kTRUE),
+  fUsePooledBGBuffers(kFALSE),
   fSetPlotHistsExtQA(kFALSE),
   fDoSoftAnalysis(kFALSE),
   fWeightJetJetMC(1),
@@ -995,6 +997,7 @@ void AliAnalysisTaskGammaCalo::InitBack(){
                                     ((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->UseTrackMultiplicity(),
                                     4,8,7);
         }
+        fBGHandler[iCut]->SetUsePooledBuffers(fUsePooledBGBuffers);
       }
     }
   }
@@ -69,6 +69,7 @@ class AliAnalysisTaskGammaCalo : public AliAnalysisTaskSE {
     void SetDoMesonQA(Int_t flag){fDoMesonQA = flag;}
     void SetDoClusterQA(Int_t flag){fDoClusterQA = flag;}
     void SetDoTHnSparse(Bool_t flag){fDoTHnSparse = flag;}
+    void SetUsePooledBGBuffers(Bool_t flag){fUsePooledBGBuffers = flag;}
     void SetPlotHistsExtQA(Bool_t flag){fSetPlotHistsExtQA = flag;}
     void SetAllowOverlapHeaders( Bool_t allowOverlapHeader ) {fAllowOverlapHeaders = allowOverlapHeader;}
     void SetDoPi0Only(Bool_t flag){fDoPi0Only = flag;}
@@ -561,6 +562,7 @@ class AliAnalysisTaskGammaCalo : public AliAnalysisTaskSE {
     Bool_t                fIsOverlappingWithOtherHeader;                        // flag for particles in MC overlapping between headers
     Int_t                 fIsMC;                                                // flag for MC information
     Bool_t                fDoTHnSparse;                                         // flag for using THnSparses for background estimation
+    Bool_t                fUsePooledBGBuffers;                                  // flag for reusing pooled photons in the background handlers
     Bool_t                fSetPlotHistsExtQA;                                   // flag for extended QA hists
     Bool_t                fDoSoftAnalysis;                                      // bool for Sphericity analysis without jets
     Double_t              fWeightJetJetMC;                                      // weight for Jet-Jet MC
@@ -586,7 +588,7 @@ class AliAnalysisTaskGammaCalo : public AliAnalysisTaskSE {
     AliAnalysisTaskGammaCalo(const AliAnalysisTaskGammaCalo&);                  // Prevent copy-construction
     AliAnalysisTaskGammaCalo &operator=(const AliAnalysisTaskGammaCalo&);       // Prevent assignment
 
-    ClassDef(AliAnalysisTaskGammaCalo, 82);
+    ClassDef(AliAnalysisTaskGammaCalo, 83);
 };
 
 #endif
@@ -349,6 +349,7 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(): AliAnalysisTaskSE(),
   fDoPlotVsCentrality(kFALSE),
   fIsMC(0),
   fDoTHnSparse(kFALSE),
+  fUsePooledBGBuffers(kFALSE),
   fWeightJetJetMC(1),
   fWeightCentrality(NULL),
   fEnableClusterCutsForTrigger(kFALSE),
@@ -651,6 +652,7 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(const char *name):
   fDoPlotVsCentrality(kFALSE),
   fIsMC(0),
   fDoTHnSparse(kFALSE),
+  fUsePooledBGBuffers(kFALSE),
   fWeightJetJetMC(1),
   fWeightCentrality(NULL),
   fEnableClusterCutsForTrigger(kFALSE),
@@ -767,6 +769,7 @@ void AliAnalysisTaskGammaConvV1::InitBack(){
                                   ((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->GetNumberOfBGEvents(),
                                   ((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->UseTrackMultiplicity(),
                                   0,8,5);
+        fBGHandler[iCut]->SetUsePooledBuffers(fUsePooledBGBuffers);
         fBGHandlerRP[iCut] = NULL;
       } else if(((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->BackgroundHandlerType() != 2){
         fBGHandlerRP[iCut] = new AliConversionAODBGHandlerRP(
@@ -24,11 +24,43 @@
 #include "AliKFParticle.h"
 #include "AliAODConversionPhoton.h"
 #include "AliAODConversionMother.h"
+#include <new>
 
 using namespace std;
 
 ClassImp(AliGammaConversionAODBGHandler)
 
+namespace {
+	// pool of the (z, mult, event) slot, to be filled with the nObjects objects of the new event
+	// a pool holding another number of objects is released, so that a slot never keeps more
+	// objects than the event buffered in it and the pools do not use more memory than new/delete
+	template<class T> vector<T> &GetPoolSlot(vector<vector<vector<vector<T> > > > &pools, Int_t nBinsZ, Int_t nBinsMult, Int_t nEvents,
+	                                         Int_t z, Int_t m, Int_t event, UInt_t nObjects){
+		if(pools.empty()){
+			pools.assign(nBinsZ,vector<vector<vector<T> > >(nBinsMult,vector<vector<T> >(nEvents)));
+		}
+		vector<T> &pool = pools[z][m][event];
+		if(pool.size() != nObjects){
+			vector<T>().swap(pool);
+			pool.reserve(nObjects);
+		}
+		return pool;
+	}
+
+	// object i of the pool as a copy of source, rebuilt in place if the pool already holds it
+	// (the assignment operators of the conversion particles do not copy)
+	// the pool is reserved for all objects of the event, the returned pointers stay valid
+	template<class T> T *AddPooled(vector<T> &pool, UInt_t i, const T &source){
+		if(i < pool.size()){
+			T *object = &pool[i];
+			object->~T();
+			return new (object) T(source);
+		}
+		pool.push_back(source);
+		return &pool.back();
+	}
+}
+
 //_____________________________________________________________________________________________________________________________
 AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler() :
 	TObject(),
@@ -47,7 +79,11 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler() :
 	fBGEvents(),
 	fBGEventsENeg(),
 	fBGEventsMeson(),
-	fBGEventsMCParticle()
+	fBGEventsMCParticle(),
+	fUsePooledBuffers(kFALSE),
+	fBGPoolPhotons(),
+	fBGPoolENeg(),
+	fBGPoolMesons()
 {
 	// constructor
 }
@@ -70,7 +106,11 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(Int_t binsZ,Int_t
 	fBGEvents(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsENeg(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents))),
-	fBGEventsMCParticle(binsZ,AliGammaMCParticleMultipicityVector(binsMultiplicity,AliGammaMCParticleBGEventVector(nEvents)))
+	fBGEventsMCParticle(binsZ,AliGammaMCParticleMultipicityVector(binsMultiplicity,AliGammaMCParticleBGEventVector(nEvents))),
+	fUsePooledBuffers(kFALSE),
+	fBGPoolPhotons(),
+	fBGPoolENeg(),
+	fBGPoolMesons()
 {
 	// constructor
 }
@@ -95,7 +135,11 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(Int_t collisionSy
 	fBGEvents(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsENeg(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents))),
-	fBGEventsMCParticle(binsZ,AliGammaMCParticleMultipicityVector(binsMultiplicity,AliGammaMCParticleBGEventVector(nEvents)))
+	fBGEventsMCParticle(binsZ,AliGammaMCParticleMultipicityVector(binsMultiplicity,AliGammaMCParticleBGEventVector(nEvents))),
+	fUsePooledBuffers(kFALSE),
+	fBGPoolPhotons(),
+	fBGPoolENeg(),
+	fBGPoolMesons()
 {
 	// constructor
     if(fNBinsMultiplicity>5) fNBinsMultiplicity = 5;
@@ -400,7 +444,11 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(const AliGammaCon
 	fBGEvents(original.fBGEvents),
 	fBGEventsENeg(original.fBGEventsENeg),
 	fBGEventsMeson(original.fBGEventsMeson),
-	fBGEventsMCParticle(original.fBGEventsMCParticle)
+	fBGEventsMCParticle(original.fBGEventsMCParticle),
+	fUsePooledBuffers(original.fUsePooledBuffers),
+	fBGPoolPhotons(),
+	fBGPoolENeg(),
+	fBGPoolMesons()
 {
 	//copy constructor	
 }
@@ -655,6 +703,16 @@ void AliGammaConversionAODBGHandler::AddEvent(TList* const eventGammas,Double_t
 	//  cout<<"Checking the entries: Z="<<z<<", M="<<m<<", eventCounter="<<eventCounter<<endl;
 
 	//  cout<<"The size of this vector is: "<<fBGEvents[z][m][eventCounter].size()<<endl;
+	if(fUsePooledBuffers){
+		// the photons of the overwritten event are rebuilt in place if the pool has the right size
+		fBGEvents[z][m][eventCounter].clear();
+		AliGammaConversionPhotonPool &pool = GetPoolSlot(fBGPoolPhotons,fNBinsZ,fNBinsMultiplicity,fNEvents,z,m,eventCounter,eventGammas->GetEntries());
+		for(Int_t i=0; i< eventGammas->GetEntries();i++){
+			fBGEvents[z][m][eventCounter].push_back(AddPooled(pool,i,*(AliAODConversionPhoton*)(eventGammas->At(i))));
+		}
+		fBGEventCounter[z][m]++;
+		return;
+	}
     for(UInt_t d=0;d<fBGEvents[z][m][eventCounter].size();d++){
 		delete (AliAODConversionPhoton*)(fBGEvents[z][m][eventCounter][d]);
 	}
@@ -686,6 +744,16 @@ void AliGammaConversionAODBGHandler::AddMesonEvent(TList* const eventMothers, Do
 	fBGEventVertex[z][m][eventCounter].fZ = zvalue;
 	fBGEventVertex[z][m][eventCounter].fEP = epvalue;
 
+	if(fUsePooledBuffers){
+		fBGEventsMeson[z][m][eventCounter].clear();
+		AliGammaConversionMotherPool &pool = GetPoolSlot(fBGPoolMesons,fNBinsZ,fNBinsMultiplicity,fNEvents,z,m,eventCounter,eventMothers->GetEntries());
+		for(Int_t i=0; i< eventMothers->GetEntries();i++){
+			fBGEventsMeson[z][m][eventCounter].push_back(AddPooled(pool,i,*(AliAODConversionMother*)(eventMothers->At(i))));
+		}
+		fBGEventMesonCounter[z][m]++;
+		return;
+	}
+
 	//first clear the vector
   for(UInt_t d=0;d<fBGEventsMeson[z][m][eventCounter].size();d++){
 		delete (AliAODConversionMother*)(fBGEventsMeson[z][m][eventCounter][d]);
@@ -714,6 +782,16 @@ void AliGammaConversionAODBGHandler::AddMesonEvent(const std::vector<AliAODConve
   fBGEventVertex[z][m][eventCounter].fZ = zvalue;
   fBGEventVertex[z][m][eventCounter].fEP = epvalue;
 
+  if(fUsePooledBuffers){
+    fBGEventsMeson[z][m][eventCounter].clear();
+    AliGammaConversionMotherPool &pool = GetPoolSlot(fBGPoolMesons,fNBinsZ,fNBinsMultiplicity,fNEvents,z,m,eventCounter,eventMother.size());
+    for(UInt_t i=0; i<eventMother.size(); i++){
+      fBGEventsMeson[z][m][eventCounter].push_back(AddPooled(pool,i,eventMother[i]));
+    }
+    fBGEventMesonCounter[z][m]++;
+    return;
+  }
+
   //first clear the vector
   for(UInt_t d=0;d<fBGEvents[z][m][eventCounter].size();d++){
     delete (AliAODConversionMother*)(fBGEventsMeson[z][m][eventCounter][d]);
@@ -743,6 +821,15 @@ void AliGammaConversionAODBGHandler::AddElectronEvent(TClonesArray* const eventE
 	//  cout<<"Checking the entries: Z="<<z<<", M="<<m<<", eventCounter="<<eventCounter<<endl;
 
 	//  cout<<"The size of this vector is: "<<fBGEvents[z][m][eventCounter].size()<<endl;
+	if(fUsePooledBuffers){
+		fBGEventsENeg[z][m][eventENegCounter].clear();
+		AliGammaConversionPhotonPool &pool = GetPoolSlot(fBGPoolENeg,fNBinsZ,fNBinsMultiplicity,fNEvents,z,m,eventENegCounter,eventENeg->GetEntriesFast());
+		for(Int_t i=0; i< eventENeg->GetEntriesFast();i++){
+			fBGEventsENeg[z][m][eventENegCounter].push_back(AddPooled(pool,i,*(AliAODConversionPhoton*)(eventENeg->At(i))));
+		}
+		fBGEventENegCounter[z][m]++;
+		return;
+	}
     for(UInt_t d=0;d<fBGEventsENeg[z][m][eventENegCounter].size();d++){
 		delete (AliAODConversionPhoton*)(fBGEventsENeg[z][m][eventENegCounter][d]);
 	}
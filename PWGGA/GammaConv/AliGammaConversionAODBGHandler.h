@@ -49,6 +49,12 @@ class AliGammaConversionAODBGHandler : public TObject {
         typedef std::vector<AliAODMCParticleVector> AliGammaMCParticleBGEventVector;
 	typedef std::vector<AliGammaMCParticleBGEventVector> AliGammaMCParticleMultipicityVector;
 	typedef std::vector<AliGammaMCParticleMultipicityVector> AliAODMCParticleBGVector;
+
+	// storage of the pooled buffers: one pool of objects per (z, mult, event) slot
+	typedef std::vector<AliAODConversionPhoton> AliGammaConversionPhotonPool;
+	typedef std::vector<std::vector<std::vector<AliGammaConversionPhotonPool> > > AliGammaConversionPhotonPoolVector;
+	typedef std::vector<AliAODConversionMother> AliGammaConversionMotherPool;
+	typedef std::vector<std::vector<std::vector<AliGammaConversionMotherPool> > > AliGammaConversionMotherPoolVector;
 	
 
 	AliGammaConversionAODBGHandler();																							//constructor
@@ -74,6 +80,12 @@ class AliGammaConversionAODBGHandler : public TObject {
 
 	Int_t GetNBGEvents()const {return fNEvents;}
 
+	// Keep the buffered photons, electrons and mesons in one contiguous pool per slot, reused in place
+	// when the ring wraps onto an event with as many objects, instead of new/delete of every object.
+	// A pool holds only the objects of its event. To be set before the first event is added.
+	void SetUsePooledBuffers(Bool_t flag = kTRUE){fUsePooledBuffers = flag;}
+	Bool_t GetUsePooledBuffers() const {return fUsePooledBuffers;}
+
 	// Get BG photons
 	AliGammaConversionAODVector* GetBGGoodV0s(Int_t zbin, Int_t mbin, Int_t event);
         AliAODMCParticleVector* GetBGGoodV0sMC(Int_t zbin, Int_t mbin, Int_t event);
@@ -108,7 +120,11 @@ class AliGammaConversionAODBGHandler : public TObject {
 		AliGammaConversionBGVector 			fBGEventsENeg; 					// electron background electron events
 		AliGammaConversionMotherBGVector                fBGEventsMeson; 				// neutral meson background events
 		AliAODMCParticleBGVector 	                fBGEventsMCParticle; 				// MC Particle background events
+		Bool_t								fUsePooledBuffers;				// reuse pooled objects for the buffered events
+		AliGammaConversionPhotonPoolVector	fBGPoolPhotons;					//! pooled photons
+		AliGammaConversionPhotonPoolVector	fBGPoolENeg;					//! pooled electrons
+		AliGammaConversionMotherPoolVector	fBGPoolMesons;					//! pooled mesons
 		
-	ClassDef(AliGammaConversionAODBGHandler,8)
+	ClassDef(AliGammaConversionAODBGHandler,9)
 };
 #endif
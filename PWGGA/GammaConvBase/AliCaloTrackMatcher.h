@@ -72,6 +72,12 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     vector<Int_t> GetMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi);
     vector<Int_t> GetMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, Float_t dR);
 
+    // all primary matches of the event, without residual selection: returns the number of matches and
+    // sets the pointer to the first of them (valid until the next event is processed)
+    // tracks are given by their position in the event for AOD and by their ID for ESD
+    Int_t GetMatchedTracksForCluster(Int_t clusterID, const Int_t *&tracks) const {return fClusterToTrack.Find(clusterID,tracks);}
+    Int_t GetMatchedClustersForTrack(AliVEvent *event, Int_t trackID, const Int_t *&clusters) {return fTrackToCluster.Find(GetTrackPosition(event,trackID),clusters);}
+
     //general methods
     Float_t SumTrackEtAroundCluster(AliVEvent* event, Int_t clusterID, Float_t dR);
 
@@ -84,6 +90,16 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     typedef pair<Float_t, Float_t> pairFloat;
     typedef map<pairInt, Int_t> mapT;
 
+    // flat association of keys to values (CSR), built once per event
+    struct FlatMap {
+      vector<Int_t> fKeys;    // sorted keys
+      vector<Int_t> fOffsets; // values of fKeys[i] are fValues[fOffsets[i]] ... fValues[fOffsets[i+1]-1]
+      vector<Int_t> fValues;  // values, in insertion order for a given key
+      void  Clear();
+      void  Build(const vector<Int_t> &keys, const vector<Int_t> &values);
+      Int_t Find(Int_t key, const Int_t *&values) const;
+    };
+
     AliCaloTrackMatcher (const AliCaloTrackMatcher&); // not implemented
     AliCaloTrackMatcher & operator=(const AliCaloTrackMatcher&); // not implemented
 
@@ -91,6 +107,7 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     void Initialize(Int_t runNumber);
     void ProcessEvent(AliVEvent *event);
     void SetLogBinningYTH2(TH2* histoRebin);
+    Int_t GetTrackPosition(AliVEvent *event, Int_t trackID);
 
     // debug methods
     void DebugMatching();
@@ -118,12 +135,18 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
 
     TClonesArray*         fArrClusters;            //! array with clusters
 
-    multimap<Int_t,Int_t> fMapTrackToCluster;      //! connects a given track ID with all associated cluster IDs
-    multimap<Int_t,Int_t> fMapClusterToTrack;      //! connects a given cluster ID with all associated track IDs
+    vector<Int_t>         fMatchTrackKeys;         //! track of every match (position in the event for AOD, ID for ESD)
+    vector<Int_t>         fMatchTrackIDs;          //! track ID of every match
+    vector<Int_t>         fMatchClusterIDs;        //! cluster ID of every match
+    FlatMap               fTrackToCluster;         //! connects a given track with all associated cluster IDs
+    FlatMap               fClusterToTrack;         //! connects a given cluster ID with all associated tracks
 
     Int_t                 fNEntries;               //! number of current TrackID/ClusterID -> Eta/Phi connections
     vector<pairFloat>     fVectorDeltaEtaDeltaPhi; //! vector of all matching residuals for a specific TrackID/ClusterID
-    mapT                  fMap_TrID_ClID_ToIndex;  //! map tuple of (trackID,clusterID) to index in vector fVectorDeltaEtaDeltaPhi
+    vector<pair<pairInt,Int_t> > fResidualIndex;   //! sorted tuples (trackID,clusterID) with their index in vector fVectorDeltaEtaDeltaPhi
+
+    AliVEvent*            fTrackPositionEvent;     //! event for which fTrackIDToPosition is filled
+    vector<pairInt>       fTrackIDToPosition;      //! sorted (track ID, position in the event) for AOD
 
     // for cluster <-> V0-track matching (running with different mass hypthesis)
     multimap<Int_t,Int_t> fSecMapTrackToCluster;      //! connects a given secondary track ID with all associated cluster IDs
@@ -142,7 +165,7 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     Bool_t                fDoLightOutput;          // switch for running light output, kFALSE -> normal mode, kTRUE -> light mode
 
     Double_t              fMassHypothesis;          // mass used for track propagation to calorimeter surface
-    ClassDef(AliCaloTrackMatcher,9)
+    ClassDef(AliCaloTrackMatcher,10)
 };
 
 #endif
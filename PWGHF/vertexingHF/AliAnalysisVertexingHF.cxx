@@ -70,6 +70,7 @@
 #include "AliCodeTimer.h"
 #include "AliMultSelection.h"
 #include <cstring>
+#include <vector>
 
 /// \cond CLASSIMP
 ClassImp(AliAnalysisVertexingHF);
@@ -651,6 +652,66 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   fMinPt3Prong=TMath::Min(fCutsDplustoKpipi->GetMinPtCandidate(),fCutsDstoKKpi->GetMinPtCandidate());
   fMinPt3Prong=TMath::Min(fMinPt3Prong,fCutsLctopKpi->GetMinPtCandidate());
 
+  // Combinatorial pruning of 3 and 4 prongs (only with fMassCutBeforeVertexing):
+  // momenta and energies of the selected tracks at the primary vertex are packed
+  // in arrays, and loose invariant-mass and pt windows (union of the hypotheses
+  // and pt bins) reject combinations before any DCA or vertex is computed.
+  // Survivors still go through SelectInvMassAndPt*, so candidates are unchanged.
+  Bool_t prune3Prong = fMassCutBeforeVertexing && f3Prong;
+  Bool_t prune4Prong = fMassCutBeforeVertexing && f4Prong;
+  std::vector<Double_t> soaP, soaEpi, soaEK, soaEp;
+  std::vector<UChar_t> mask3Prong, mask4Prong;
+  Double_t window3Prong[3]={-1.,0.,0.}; // min pt^2, min mass^2, max mass^2
+  Double_t window4Prong[3]={-1.,0.,0.};
+  Double_t massPi=TDatabasePDG::Instance()->GetParticle(211)->Mass();
+  Double_t massP=TDatabasePDG::Instance()->GetParticle(2212)->Mass();
+  if(prune3Prong || prune4Prong) {
+    soaP.resize(3*nSeleTrks);
+    soaEpi.resize(nSeleTrks); soaEK.resize(nSeleTrks); soaEp.resize(nSeleTrks);
+    mask3Prong.resize(nSeleTrks); mask4Prong.resize(nSeleTrks);
+    Double_t momAtVtx[3];
+    for(Int_t iTrk=0; iTrk<nSeleTrks; iTrk++) {
+      ((AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrk))->GetPxPyPz(momAtVtx);
+      for(Int_t ic=0; ic<3; ic++) soaP[ic*nSeleTrks+iTrk]=momAtVtx[ic];
+      Double_t p2=momAtVtx[0]*momAtVtx[0]+momAtVtx[1]*momAtVtx[1]+momAtVtx[2]*momAtVtx[2];
+      soaEpi[iTrk]=TMath::Sqrt(massPi*massPi+p2);
+      soaEK[iTrk]=TMath::Sqrt(fMassK*fMassK+p2);
+      soaEp[iTrk]=TMath::Sqrt(massP*massP+p2);
+    }
+  }
+  // windows are widened by a relative 1e-6 to stay conservative w.r.t. rounding
+  if(prune3Prong) {
+    Double_t lo2=1.e30, hi2=0.;
+    Int_t nBins=TMath::Max(1,fCutsDplustoKpipi->GetNPtBins());
+    for(Int_t iBin=0; iBin<nBins; iBin++) {
+      Double_t mrange=fCutsDplustoKpipi->GetMassCut(iBin);
+      lo2=TMath::Min(lo2,(fMassDplus-mrange)*(fMassDplus-mrange));
+      hi2=TMath::Max(hi2,(fMassDplus+mrange)*(fMassDplus+mrange));
+    }
+    nBins=TMath::Max(1,fCutsDstoKKpi->GetNPtBins());
+    for(Int_t iBin=0; iBin<nBins; iBin++) {
+      Double_t mrange=fCutsDstoKKpi->GetMassCut(iBin);
+      lo2=TMath::Min(lo2,(fMassDs-mrange)*(fMassDs-mrange));
+      hi2=TMath::Max(hi2,(fMassDs+mrange)*(fMassDs+mrange));
+    }
+    nBins=TMath::Max(1,fCutsLctopKpi->GetNPtBins());
+    for(Int_t iBin=0; iBin<nBins; iBin++) {
+      Double_t mrange=fCutsLctopKpi->GetMassCut(iBin);
+      lo2=TMath::Min(lo2,(fMassLambdaC-mrange)*(fMassLambdaC-mrange));
+      hi2=TMath::Max(hi2,(fMassLambdaC+mrange)*(fMassLambdaC+mrange));
+    }
+    if(fMinPt3Prong>0.1) window3Prong[0]=fMinPt3Prong*fMinPt3Prong*(1.-1.e-6);
+    window3Prong[1]=lo2*(1.-1.e-6);
+    window3Prong[2]=hi2*(1.+1.e-6);
+  }
+  if(prune4Prong) {
+    Double_t mrange=fCutsD0toKpipipi->GetMassCut();
+    Double_t minPt=fCutsD0toKpipipi->GetMinPtCandidate();
+    if(minPt>0.1) window4Prong[0]=minPt*minPt*(1.-1.e-6);
+    window4Prong[1]=(fMassDzero-mrange)*(fMassDzero-mrange)*(1.-1.e-6);
+    window4Prong[2]=(fMassDzero+mrange)*(fMassDzero+mrange)*(1.+1.e-6);
+  }
+
   Double_t minPtV0=0.;
   if(fCutsLctoV0) minPtV0=fCutsLctoV0->GetMinV0PtCut();
   if(fCutsDstoK0sK){
@@ -1056,6 +1117,17 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	continue;
       }
 
+      // third prong candidates compatible with the 3 prong windows, assuming
+      // the lightest (pi) and heaviest (p) mass for all daughters
+      if(prune3Prong) {
+	Double_t sumP[3]={mompos1[0]+momneg1[0],mompos1[1]+momneg1[1],mompos1[2]+momneg1[2]};
+	Double_t p2pos1=mompos1[0]*mompos1[0]+mompos1[1]*mompos1[1]+mompos1[2]*mompos1[2];
+	Double_t p2neg1=momneg1[0]*momneg1[0]+momneg1[1]*momneg1[1]+momneg1[2]*momneg1[2];
+	Double_t sumEpi=TMath::Sqrt(massPi*massPi+p2pos1)+TMath::Sqrt(massPi*massPi+p2neg1);
+	Double_t sumEp=TMath::Sqrt(massP*massP+p2pos1)+TMath::Sqrt(massP*massP+p2neg1);
+	PreSelectCombinations(nSeleTrks,&soaP[0],&soaEpi[0],&soaEp[0],sumP,sumEpi,sumEp,window3Prong,&mask3Prong[0]);
+      }
+
 
       // 2nd LOOP  ON  POSITIVE  TRACKS
       for(iTrkP2=iTrkP1+1; iTrkP2<nSeleTrks; iTrkP2++) {
@@ -1137,6 +1209,11 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	SetParametersAtVertex(negtrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN1));
 	SetParametersAtVertex(postrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP2));
 
+	// outside the 3 prong windows: only the 4 prong loop can still use this triplet
+	// (skipped only after the reset above, the tracks may still be at the previous secondary vertex)
+	Bool_t outOf3ProngWindow = prune3Prong && !mask3Prong[iTrkP2];
+	if(outOf3ProngWindow && (!f4Prong || isLikeSign2Prong || isLikeSign3Prong)) { postrack2=0; continue; }
+
 	//printf("********** %d %d %d\n",postrack1->GetID(),postrack2->GetID(),negtrack1->GetID());
 
 	dcap2n1 = postrack2->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
@@ -1156,7 +1233,9 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    threeTrackArray->AddAt(postrack1,1);
 	    threeTrackArray->AddAt(postrack2,2);
 	  }
-	  if(fMassCutBeforeVertexing){
+	  if(outOf3ProngWindow){
+	    massCutOK=kFALSE;
+	  }else if(fMassCutBeforeVertexing){
 	    postrack2->GetPxPyPz(mompos2);
 	    Double_t pxDau[3]={mompos1[0],momneg1[0],mompos2[0]};
 	    Double_t pyDau[3]={mompos1[1],momneg1[1],mompos2[1]};
@@ -1225,6 +1304,18 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	}
 
 	// 4 prong candidates
+	// fourth prong candidates compatible with the D0 window (pi and K masses)
+	Bool_t any4Prong=kTRUE;
+	if(prune4Prong && !isLikeSign2Prong && !isLikeSign3Prong) {
+	  Double_t sumP[3], sumEpi=0., sumEK=0.;
+	  Int_t iTrk3[3]={iTrkP1,iTrkN1,iTrkP2};
+	  for(Int_t ic=0; ic<3; ic++) sumP[ic]=soaP[ic*nSeleTrks+iTrkP1]+soaP[ic*nSeleTrks+iTrkN1]+soaP[ic*nSeleTrks+iTrkP2];
+	  for(Int_t it=0; it<3; it++) { sumEpi+=soaEpi[iTrk3[it]]; sumEK+=soaEK[iTrk3[it]]; }
+	  PreSelectCombinations(nSeleTrks,&soaP[0],&soaEpi[0],&soaEK[0],sumP,sumEpi,sumEK,window4Prong,&mask4Prong[0]);
+	  any4Prong=kFALSE;
+	  for(iTrkN2=iTrkN1+1; iTrkN2<nSeleTrks; iTrkN2++) any4Prong |= mask4Prong[iTrkN2];
+	}
+
 	if(f4Prong
 	   // don't make 4 prong with like-sign pairs and triplets
 	   && !isLikeSign2Prong && !isLikeSign3Prong
@@ -1239,14 +1330,14 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	  SetParametersAtVertex(negtrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN1));
 	  SetParametersAtVertex(postrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP2));
 
-	  // Vertexing for these 3 (can be taken from above?)
+	  // Vertexing for these 3 (can be taken from above?), not needed if no fourth prong is compatible
           threeTrackArray->AddAt(postrack1,0);
           threeTrackArray->AddAt(negtrack1,1);
 	  threeTrackArray->AddAt(postrack2,2);
-          AliAODVertex* vertexp1n1p2 = ReconstructSecondaryVertex(threeTrackArray,dispersion);
+          AliAODVertex* vertexp1n1p2 = any4Prong ? ReconstructSecondaryVertex(threeTrackArray,dispersion) : 0x0;
 
 	  // 3rd LOOP  ON  NEGATIVE  TRACKS (for 4 prong)
-	  for(iTrkN2=iTrkN1+1; iTrkN2<nSeleTrks; iTrkN2++) {
+	  for(iTrkN2=iTrkN1+1; iTrkN2<nSeleTrks && any4Prong; iTrkN2++) {
 
 	    if(iTrkN2==iTrkP1 || iTrkN2==iTrkP2 || iTrkN2==iTrkN1) continue;
 
@@ -1277,6 +1368,8 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    SetParametersAtVertex(postrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP2));
 	    SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 
+	    if(prune4Prong && !mask4Prong[iTrkN2]) { negtrack2=0; continue; }
+
 	    dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
 	    if(dcap1n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
             dcap2n2 = postrack2->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
@@ -1334,7 +1427,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
       twoTrackArray2->Clear();
 
       // 2nd LOOP  ON  NEGATIVE  TRACKS (for 3 prong -+-)
-      for(iTrkN2=iTrkN1+1; iTrkN2<nSeleTrks; iTrkN2++) {
+      for(iTrkN2=iTrkN1+1; iTrkN2<nSeleTrks && f3Prong; iTrkN2++) {
 
 	if(iTrkN2==iTrkP1 || iTrkN2==iTrkP2 || iTrkN2==iTrkN1) continue;
 
@@ -1410,6 +1503,8 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 	//printf("********** %d %d %d\n",postrack1->GetID(),negtrack1->GetID(),negtrack2->GetID());
 
+	if(prune3Prong && !mask3Prong[iTrkN2]) { negtrack2=0; continue; }
+
 	dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
 	if(dcap1n2>dcaMax) { negtrack2=0; continue; }
 	dcan1n2 = negtrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
@@ -3437,6 +3532,29 @@ Bool_t AliAnalysisVertexingHF::SelectInvMassAndPtCascade(Double_t *px,
   return retval;
 }
 //-----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::PreSelectCombinations(Int_t nTrks,const Double_t *soaP,
+						   const Double_t *soaELight,const Double_t *soaEHeavy,
+						   const Double_t sumP[3],Double_t sumELight,Double_t sumEHeavy,
+						   const Double_t window[3],UChar_t *mask) const {
+  /// Loose pt and invariant mass check of the combinations of a set of prongs
+  /// (sums of momenta and energies in sumP, sumELight, sumEHeavy) with each
+  /// selected track: the mass with all daughters of the lightest (heaviest)
+  /// hypothesis is a lower (upper) bound of the mass of any hypothesis.
+  /// window: min pt^2, min mass^2, max mass^2
+
+  const Double_t *px=soaP, *py=soaP+nTrks, *pz=soaP+2*nTrks;
+  for(Int_t iTrk=0; iTrk<nTrks; iTrk++) {
+    Double_t pxc=sumP[0]+px[iTrk];
+    Double_t pyc=sumP[1]+py[iTrk];
+    Double_t pzc=sumP[2]+pz[iTrk];
+    Double_t pt2=pxc*pxc+pyc*pyc;
+    Double_t eLight=sumELight+soaELight[iTrk];
+    Double_t eHeavy=sumEHeavy+soaEHeavy[iTrk];
+    mask[iTrk] = (pt2>=window[0]) & (eLight*eLight-pt2-pzc*pzc<window[2]) & (eHeavy*eHeavy-pt2-pzc*pzc>window[1]);
+  }
+  return;
+}
+//-----------------------------------------------------------------------------
 void AliAnalysisVertexingHF::SelectTracksAndCopyVertex(const AliVEvent *event,
 						       Int_t trkEntries,
 						       TObjArray &seleTrksArray,
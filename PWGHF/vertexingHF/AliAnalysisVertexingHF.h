@@ -414,6 +414,11 @@ class AliAnalysisVertexingHF : public TNamed {
   Bool_t SelectInvMassAndPtDstarD0pi(TObjArray *trkArray);
   Bool_t SelectInvMassAndPtCascade(TObjArray *trkArray);
 
+  void PreSelectCombinations(Int_t nTrks,const Double_t *soaP,
+			     const Double_t *soaELight,const Double_t *soaEHeavy,
+			     const Double_t sumP[3],Double_t sumELight,Double_t sumEHeavy,
+			     const Double_t window[3],UChar_t *mask) const;
+
   void   SelectTracksAndCopyVertex(const AliVEvent *event,Int_t trkEntries,
 				   TObjArray &seleTrksArray,
 				   TObjArray &tracksAtVertex,
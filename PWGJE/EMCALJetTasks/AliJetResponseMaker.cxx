@@ -19,9 +19,13 @@
 
 #include "AliJetResponseMaker.h"
 
+#include <algorithm>
+#include <map>
+
 #include <TClonesArray.h>
 #include <TH2F.h>
 #include <THnSparse.h>
+#include <TVector2.h>
 
 #include "AliTLorentzVector.h"
 #include "AliAnalysisManager.h"
@@ -46,6 +50,7 @@ AliJetResponseMaker::AliJetResponseMaker() :
   fMatchingPar2(0),
   fUseCellsToMatch(kFALSE),
   fMinJetMCPt(1),
+  fUseFastMatching(kTRUE),
   fEmbeddingQA(),
   fHistoType(0),
   fDeltaPtAxis(0),
@@ -135,6 +140,7 @@ AliJetResponseMaker::AliJetResponseMaker(const char *name) :
   fMatchingPar2(0),
   fUseCellsToMatch(kFALSE),
   fMinJetMCPt(1),
+  fUseFastMatching(kTRUE),
   fEmbeddingQA(),
   fHistoType(0),
   fDeltaPtAxis(0),
@@ -1417,6 +1423,13 @@ Bool_t AliJetResponseMaker::DoJetMatching()
 void AliJetResponseMaker::DoJetLoop()
 {
   // Do the jet loop.
+  //
+  // With fUseFastMatching only the pairs that can end up as closest or second closest jet
+  // of one of the two jets are passed to SetMatchingLevel, in the order of the full loop,
+  // so that the result is the same as with the full loop:
+  //  - geometrical matching: the two nearest jets of each jet, found on an eta-phi grid;
+  //  - MC label / same collections matching: the pairs sharing constituents, plus for each jet
+  //    the first two partners without shared constituents (all at the same distance, 1).
 
   AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
   AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
@@ -1426,8 +1439,13 @@ void AliJetResponseMaker::DoJetLoop()
   AliEmcalJet* jet1 = 0;
   AliEmcalJet* jet2 = 0;
 
+  std::vector<AliEmcalJet*> jetList1, jetList2;
+
   jets2->ResetCurrentID();
-  while ((jet2 = jets2->GetNextJet())) jet2->ResetMatching();
+  while ((jet2 = jets2->GetNextJet())) {
+    jet2->ResetMatching();
+    jetList2.push_back(jet2);
+  }
 
   jets1->ResetCurrentID();
   while ((jet1 = jets1->GetNextJet())) {
@@ -1435,11 +1453,221 @@ void AliJetResponseMaker::DoJetLoop()
 
     if (jet1->MCPt() < fMinJetMCPt) continue;
 
-    jets2->ResetCurrentID();
-    while ((jet2 = jets2->GetNextJet())) {
-      SetMatchingLevel(jet1, jet2, fMatching);
-    } // jet2 loop
-  } // jet1 loop
+    jetList1.push_back(jet1);
+  }
+
+  if (jetList1.empty() || jetList2.empty()) return;
+
+  std::vector<std::pair<Int_t, Int_t> > pairs;
+  Bool_t fullLoop = !fUseFastMatching;
+  if (!fullLoop) {
+    if (fMatching == kGeometrical) {
+      FindGeometricalCandidates(jetList1, jetList2, pairs);
+    }
+    else if (fMatching == kMCLabel || fMatching == kSameCollections) {
+      fullLoop = !FindConstituentCandidates(jetList1, jetList2, pairs);
+    }
+    else {
+      fullLoop = kTRUE;
+    }
+  }
+
+  if (fullLoop) {
+    for (UInt_t i1 = 0; i1 < jetList1.size(); i1++) {
+      for (UInt_t i2 = 0; i2 < jetList2.size(); i2++) {
+        SetMatchingLevel(jetList1[i1], jetList2[i2], fMatching);
+      } // jet2 loop
+    } // jet1 loop
+    return;
+  }
+
+  std::sort(pairs.begin(), pairs.end());
+  pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+  for (UInt_t ip = 0; ip < pairs.size(); ip++) {
+    SetMatchingLevel(jetList1[pairs[ip].first], jetList2[pairs[ip].second], fMatching);
+  }
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::FindGeometricalCandidates(const std::vector<AliEmcalJet*> &jets1, const std::vector<AliEmcalJet*> &jets2, std::vector<std::pair<Int_t, Int_t> > &pairs) const
+{
+  // For each jet of one collection, add the pairs with the two nearest jets of the other collection
+  // (ties resolved by the position in the collection, as in the full loop).
+  // The jets to be searched are binned in an eta-phi grid, periodic in phi; the search proceeds
+  // in rings of cells around the jet until no jet outside can be closer than the second nearest.
+
+  for (Int_t side = 0; side < 2; side++) {
+    const std::vector<AliEmcalJet*> &query = (side == 0) ? jets1 : jets2;
+    const std::vector<AliEmcalJet*> &target = (side == 0) ? jets2 : jets1;
+    const Int_t nTarget = target.size();
+
+    Double_t etaMin = target[0]->Eta(), etaMax = target[0]->Eta();
+    for (Int_t it = 1; it < nTarget; it++) {
+      etaMin = TMath::Min(etaMin, target[it]->Eta());
+      etaMax = TMath::Max(etaMax, target[it]->Eta());
+    }
+
+    // about one jet per cell
+    const Double_t cellSize = TMath::Max(0.05, TMath::Sqrt((etaMax - etaMin + 0.05) * TMath::TwoPi() / nTarget));
+    const Int_t nPhi = TMath::Max(1, TMath::Min(64, TMath::FloorNint(TMath::TwoPi() / cellSize)));
+    const Double_t cellPhi = TMath::TwoPi() / nPhi;
+    const Int_t nEta = TMath::Max(1, TMath::Min(64, TMath::CeilNint((etaMax - etaMin) / cellSize)));
+    const Double_t cellEta = TMath::Max((etaMax - etaMin) / nEta, 1e-6);
+    const Double_t cellMin = TMath::Min(cellEta, cellPhi);
+
+    std::vector<std::vector<Int_t> > cells(nEta * nPhi);
+    for (Int_t it = 0; it < nTarget; it++) {
+      const Int_t iEta = TMath::Min(nEta - 1, TMath::Max(0, Int_t((target[it]->Eta() - etaMin) / cellEta)));
+      const Int_t iPhi = TMath::Min(nPhi - 1, Int_t(TVector2::Phi_0_2pi(target[it]->Phi()) / cellPhi));
+      cells[iEta * nPhi + iPhi].push_back(it);
+    }
+
+    std::vector<Int_t> visited(nEta * nPhi, -1);
+    std::vector<std::pair<Double_t, Int_t> > found;
+    for (Int_t iq = 0; iq < Int_t(query.size()); iq++) {
+      AliEmcalJet *jet = query[iq];
+      const Int_t iEta0 = TMath::Min(nEta - 1, TMath::Max(0, Int_t(TMath::Floor((jet->Eta() - etaMin) / cellEta))));
+      const Int_t iPhi0 = TMath::Min(nPhi - 1, Int_t(TVector2::Phi_0_2pi(jet->Phi()) / cellPhi));
+
+      found.clear();
+      for (Int_t ring = 0; ; ring++) {
+        for (Int_t dEta = -ring; dEta <= ring; dEta++) {
+          const Int_t iEta = iEta0 + dEta;
+          if (iEta < 0 || iEta >= nEta) continue;
+          for (Int_t dPhi = -ring; dPhi <= ring; dPhi++) {
+            if (TMath::Abs(dEta) != ring && TMath::Abs(dPhi) != ring) continue;
+            const Int_t iCell = iEta * nPhi + ((iPhi0 + dPhi) % nPhi + nPhi) % nPhi;
+            if (visited[iCell] == iq) continue;
+            visited[iCell] = iq;
+            for (UInt_t ij = 0; ij < cells[iCell].size(); ij++) {
+              const Int_t it = cells[iCell][ij];
+              // same distance as in SetMatchingLevel
+              const Double_t d = (side == 0) ? jet->DeltaR(target[it]) : target[it]->DeltaR(jet);
+              found.push_back(std::make_pair(d, it));
+            }
+          }
+        }
+        if (ring >= nEta && 2 * ring + 1 >= nPhi) break; // all cells visited
+        if (found.size() < 2) continue;
+        std::partial_sort(found.begin(), found.begin() + 2, found.end());
+        // the jets outside of the visited cells are at least ring * cellMin away
+        if (found[1].first < ring * cellMin - 1e-9) break;
+      }
+
+      const Int_t nFound = TMath::Min(2, Int_t(found.size()));
+      std::partial_sort(found.begin(), found.begin() + nFound, found.end());
+      for (Int_t ic = 0; ic < nFound; ic++) {
+        if (side == 0) pairs.push_back(std::make_pair(iq, found[ic].second));
+        else pairs.push_back(std::make_pair(found[ic].second, iq));
+      }
+    }
+  }
+}
+
+//________________________________________________________________________
+Bool_t AliJetResponseMaker::FindConstituentCandidates(const std::vector<AliEmcalJet*> &jets1, const std::vector<AliEmcalJet*> &jets2, std::vector<std::pair<Int_t, Int_t> > &pairs) const
+{
+  // Add the pairs that may share constituents, found through a map from the constituent index
+  // to the jets 2 that contain it (the MC particle index, for MC label matching), and for each
+  // jet the first two partners that do not share constituents: for those the matching level
+  // does not depend on the partner.
+  // Returns kFALSE if the configuration is not supported (cell matching), in which case all pairs
+  // have to be tried.
+
+  if (fUseCellsToMatch && fCaloCells) return kFALSE;
+
+  AliJetContainer *jetCont1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
+  AliJetContainer *jetCont2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+
+  AliParticleContainer *tracks1   = jetCont1->GetParticleContainer();
+  AliClusterContainer  *clusters1 = jetCont1->GetClusterContainer();
+  AliParticleContainer *tracks2   = jetCont2->GetParticleContainer();
+  AliClusterContainer  *clusters2 = jetCont2->GetClusterContainer();
+
+  if (fMatching == kMCLabel && !tracks2) return kFALSE;
+
+  const Bool_t useTracks = (fMatching == kMCLabel) || (tracks1 && tracks2);
+  const Bool_t useClusters = (fMatching == kMCLabel) || (clusters1 && clusters2);
+
+  // constituent index -> jets 2 containing it
+  std::map<Int_t, std::vector<Int_t> > trackToJet2, clusterToJet2;
+  for (Int_t i2 = 0; i2 < Int_t(jets2.size()); i2++) {
+    AliEmcalJet *jet2 = jets2[i2];
+    if (useTracks) {
+      for (Int_t iTrack2 = 0; iTrack2 < jet2->GetNumberOfTracks(); iTrack2++) trackToJet2[jet2->TrackAt(iTrack2)].push_back(i2);
+    }
+    if (useClusters && fMatching == kSameCollections) {
+      for (Int_t iClus2 = 0; iClus2 < jet2->GetNumberOfClusters(); iClus2++) clusterToJet2[jet2->ClusterAt(iClus2)].push_back(i2);
+    }
+  }
+
+  std::vector<std::vector<Int_t> > partners1(jets1.size()), partners2(jets2.size());
+  std::vector<Int_t> keys;
+  for (Int_t i1 = 0; i1 < Int_t(jets1.size()); i1++) {
+    AliEmcalJet *jet1 = jets1[i1];
+    std::vector<Int_t> &partners = partners1[i1];
+
+    if (fMatching == kMCLabel) {
+      // the MC particles of the constituents of jet 1, found as in GetMCLabelMatchingLevel
+      keys.clear();
+      for (Int_t iTrack = 0; iTrack < jet1->GetNumberOfTracks(); iTrack++) {
+        AliVParticle *track = jet1->Track(iTrack);
+        if (!track) continue;
+        Int_t MClabel = TMath::Abs(track->GetLabel()) - fMCLabelShift;
+        if (MClabel > 0) keys.push_back(tracks2->GetIndexFromLabel(MClabel));
+      }
+      for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
+        AliVCluster *clus = jet1->Cluster(iClus);
+        if (!clus) continue;
+        Int_t MClabel = TMath::Abs(clus->GetLabel()) - fMCLabelShift;
+        if (MClabel > 0) keys.push_back(tracks2->GetIndexFromLabel(MClabel));
+      }
+      for (UInt_t ik = 0; ik < keys.size(); ik++) {
+        if (keys[ik] < 0) continue;
+        std::map<Int_t, std::vector<Int_t> >::const_iterator it = trackToJet2.find(keys[ik]);
+        if (it != trackToJet2.end()) partners.insert(partners.end(), it->second.begin(), it->second.end());
+      }
+    }
+    else {
+      if (useTracks) {
+        for (Int_t iTrack1 = 0; iTrack1 < jet1->GetNumberOfTracks(); iTrack1++) {
+          std::map<Int_t, std::vector<Int_t> >::const_iterator it = trackToJet2.find(jet1->TrackAt(iTrack1));
+          if (it != trackToJet2.end()) partners.insert(partners.end(), it->second.begin(), it->second.end());
+        }
+      }
+      if (useClusters) {
+        for (Int_t iClus1 = 0; iClus1 < jet1->GetNumberOfClusters(); iClus1++) {
+          std::map<Int_t, std::vector<Int_t> >::const_iterator it = clusterToJet2.find(jet1->ClusterAt(iClus1));
+          if (it != clusterToJet2.end()) partners.insert(partners.end(), it->second.begin(), it->second.end());
+        }
+      }
+    }
+
+    std::sort(partners.begin(), partners.end());
+    partners.erase(std::unique(partners.begin(), partners.end()), partners.end());
+    for (UInt_t ip = 0; ip < partners.size(); ip++) {
+      pairs.push_back(std::make_pair(i1, partners[ip]));
+      partners2[partners[ip]].push_back(i1); // filled in increasing order of i1
+    }
+  }
+
+  // first two partners without shared constituents, in the order of the full loop
+  for (Int_t side = 0; side < 2; side++) {
+    const std::vector<std::vector<Int_t> > &partnerLists = (side == 0) ? partners1 : partners2;
+    const Int_t nOther = (side == 0) ? jets2.size() : jets1.size();
+    for (Int_t i = 0; i < Int_t(partnerLists.size()); i++) {
+      const std::vector<Int_t> &partners = partnerLists[i];
+      Int_t nAdded = 0;
+      for (Int_t j = 0; j < nOther && nAdded < 2; j++) {
+        if (std::binary_search(partners.begin(), partners.end(), j)) continue;
+        if (side == 0) pairs.push_back(std::make_pair(i, j));
+        else pairs.push_back(std::make_pair(j, i));
+        nAdded++;
+      }
+    }
+  }
+
+  return kTRUE;
 }
 
 //________________________________________________________________________
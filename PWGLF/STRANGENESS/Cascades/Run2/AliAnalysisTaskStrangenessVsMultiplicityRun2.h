@@ -44,6 +44,8 @@ class AliPIDResponse;
 class AliCFContainer;
 class AliV0Result;
 class AliCascadeResult;
+class AliV0CutMatrix;
+class AliCascadeCutMatrix;
 class AliExternalTrackParam;
 
 //#include "TString.h"
@@ -256,6 +258,8 @@ private:
     AliEventCuts fEventCutsStrictAntipileup; /// Event cuts class
 
     TRandom3 *fRand; //!
+    AliV0CutMatrix      *fV0CutMatrix;      //! column copy of the V0 configurations
+    AliCascadeCutMatrix *fCascadeCutMatrix; //! column copy of the cascade configurations
 
     //Objects Controlling Task Behaviour
     Bool_t fkSaveEventTree;           //if true, save Event TTree
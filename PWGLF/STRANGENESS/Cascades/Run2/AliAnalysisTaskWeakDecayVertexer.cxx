@@ -88,6 +88,7 @@ class AliAODv0;
 #include "AliAnalysisTaskSE.h"
 #include "AliAnalysisUtils.h"
 #include "AliEventCuts.h"
+#include "AliWeakDecayPairPreselector.h"
 #include "AliAnalysisTaskWeakDecayVertexer.h"
 
 //stuff for mat corr
@@ -154,6 +155,10 @@ fkDoCascadeRefit( kFALSE ) ,
 fMaxIterationsWhenMinimizing(27),
 fkPreselectX(kTRUE),
 fkSkipLargeXYDCA(kTRUE),
+fkUsePairPreselection(kFALSE),
+fPairPreselectionTolerance(2.0),
+fPairPreselectionThreads(0),
+fPairPreselector(0),
 fkMonteCarlo(kFALSE),
 fkUseOptimalTrackParams(kFALSE),
 fkUseOptimalTrackParamsBachelor(kFALSE),
@@ -223,6 +228,10 @@ fkDoCascadeRefit( kFALSE ) ,
 fMaxIterationsWhenMinimizing(27),
 fkPreselectX(kTRUE),
 fkSkipLargeXYDCA(kTRUE),
+fkUsePairPreselection(kFALSE),
+fPairPreselectionTolerance(2.0),
+fPairPreselectionThreads(0),
+fPairPreselector(0),
 fkMonteCarlo(kFALSE), 
 fkUseOptimalTrackParams(kFALSE),
 fkUseOptimalTrackParamsBachelor(kFALSE),
@@ -279,6 +288,10 @@ AliAnalysisTaskWeakDecayVertexer::~AliAnalysisTaskWeakDecayVertexer()
         delete fListHist;
         fListHist = 0x0;
     }
+    if (fPairPreselector) {
+        delete fPairPreselector;
+        fPairPreselector = 0x0;
+    }
 }
 
 //________________________________________________________________________
@@ -699,12 +712,27 @@ Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0vertices(AliESDEvent *event) {
     
       int nHypSel = fV0HypSelArray ? fV0HypSelArray->GetEntriesFast() : 0;
     
+    //Geometrical pre-selection of the pairs to try (not with OTF params:
+    //the propagation would not start from the same tracks)
+    Bool_t lPreselect = fkUsePairPreselection && !fkUseOptimalTrackParams;
+    if( lPreselect ){
+        if( !fPairPreselector ) fPairPreselector = new AliWeakDecayPairPreselector();
+        fPairPreselector->SetTolerance( fPairPreselectionTolerance*fV0VertexerSels[3] );
+        fPairPreselector->SetNThreads( fPairPreselectionThreads );
+        fPairPreselector->Clear();
+        for (i=0; i<nneg; i++) fPairPreselector->AddTrack(0, event->GetTrack(neg[i]), b, fV0VertexerSels[6]);
+        for (i=0; i<npos; i++) fPairPreselector->AddTrack(1, event->GetTrack(pos[i]), b, fV0VertexerSels[6]);
+        fPairPreselector->Process();
+    }
+    
     for (i=0; i<nneg; i++) {
         Long_t nidx=neg[i];
         AliESDtrack *ntrk=event->GetTrack(nidx);
         if(!ntrk) continue;
         
-        for (Int_t k=0; k<npos; k++) {
+        Long_t lNCandidates = lPreselect ? fPairPreselector->GetNCandidates(i) : npos;
+        for (Long_t ic=0; ic<lNCandidates; ic++) {
+            Int_t k = lPreselect ? fPairPreselector->GetCandidate(i,ic) : ic;
             Int_t pidx=pos[k];
             AliESDtrack *ptrk=event->GetTrack(pidx);
             if(!ptrk) continue;
@@ -1284,13 +1312,33 @@ Long_t AliAnalysisTaskWeakDecayVertexer::V0sTracks2CascadeVertices(AliESDEvent *
     Double_t massLambda=1.11568;
     Long_t ncasc=0;
     
+    //Geometrical pre-selection of the V0-bachelor pairs to try (not with
+    //OTF bachelor params: the propagation would not start from the same track)
+    Bool_t lPreselect = fkUsePairPreselection && !fkUseOptimalTrackParamsBachelor;
+    if( lPreselect ){
+        if( !fPairPreselector ) fPairPreselector = new AliWeakDecayPairPreselector();
+        fPairPreselector->SetTolerance( fPairPreselectionTolerance*fCascadeVertexerSels[4] );
+        fPairPreselector->SetNThreads( fPairPreselectionThreads );
+        fPairPreselector->Clear();
+        for (i=0; i<nV0; i++) {
+            //the cascade decays before the V0, within the fiducial zone
+            AliESDv0 *v=(AliESDv0*)vtcs.UncheckedAt(i);
+            Double_t x1,y1,z1; v->GetXYZ(x1,y1,z1);
+            fPairPreselector->AddV0(0, v, TMath::Min( TMath::Sqrt(x1*x1+y1*y1), fCascadeVertexerSels[7] ) );
+        }
+        for (i=0; i<ntr; i++) fPairPreselector->AddTrack(1, event->GetTrack(trk[i]), b, fCascadeVertexerSels[7]);
+        fPairPreselector->Process();
+    }
+    
     // Looking for the cascades...
     for (i=0; i<nV0; i++) { //loop on V0s
         AliESDv0 *v=(AliESDv0*)vtcs.UncheckedAt(i);
         AliESDv0 v0(*v);
         v0.ChangeMassHypothesis(kLambda0); // the v0 must be Lambda
         if (TMath::Abs(v0.GetEffMass()-massLambda)>fCascadeVertexerSels[2]) continue;
-        for (Int_t j=0; j<ntr; j++) {//loop on tracks
+        Long_t lNCandidates = lPreselect ? fPairPreselector->GetNCandidates(i) : ntr;
+        for (Long_t ic=0; ic<lNCandidates; ic++) {//loop on tracks
+            Int_t j = lPreselect ? fPairPreselector->GetCandidate(i,ic) : ic;
             Int_t bidx=trk[j];
             //Bo:   if (bidx==v->GetNindex()) continue; //bachelor and v0's negative tracks must be different
             if (bidx==v0.GetIndex(0)) continue; //Bo:  consistency 0 for neg
@@ -1386,7 +1434,9 @@ Long_t AliAnalysisTaskWeakDecayVertexer::V0sTracks2CascadeVertices(AliESDEvent *
         v0.ChangeMassHypothesis(kLambda0Bar); //the v0 must be anti-Lambda
         if (TMath::Abs(v0.GetEffMass()-massLambda)>fCascadeVertexerSels[2]) continue;
         
-        for (Int_t j=0; j<ntr; j++) {//loop on tracks
+        Long_t lNCandidates = lPreselect ? fPairPreselector->GetNCandidates(i) : ntr;
+        for (Long_t ic=0; ic<lNCandidates; ic++) {//loop on tracks
+            Int_t j = lPreselect ? fPairPreselector->GetCandidate(i,ic) : ic;
             Int_t bidx=trk[j];
             if (bidx==v0.GetIndex(1)) continue; //Bo:  consistency 1 for pos
             
@@ -3008,6 +3058,7 @@ void AliAnalysisTaskWeakDecayVertexer::Print()
     cout<<" Casc. mass window (GeV/c2).: "<<fMassWindowAroundCascade<<endl;
     cout<<" Master Niterations value...: "<<fMaxIterationsWhenMinimizing<<endl;
     cout<<" Skip large DCAXY in opt....: "<<fkSkipLargeXYDCA<<endl;
+    cout<<" Pair pre-selection.........: "<<fkUsePairPreselection<<" (tolerance "<<fPairPreselectionTolerance<<", threads "<<fPairPreselectionThreads<<")"<<endl;
     cout<<" MC associated only (MCflag): "<<fkMonteCarlo<<endl;
     cout<<" --> Experimental flags: "<<endl;
     cout<<" Run casc. find. with OTFV0.: "<<fkUseOnTheFlyV0Cascading<<endl;
@@ -35,6 +35,7 @@ class AliV0HypSel;
 class AliESDpid;
 class AliESDEvent;
 class AliPhysicsSelection;
+class AliWeakDecayPairPreselector;
 
 #include "AliEventCuts.h"
 //For mapping functionality
@@ -250,6 +251,13 @@ public:
     void SetSkipLargeXYDCA( Bool_t lOpt = kTRUE) {
         fkSkipLargeXYDCA=lOpt;
     }
+    //Geometrical pair pre-selection before propagation: pairs whose
+    //trajectories stay further apart than lTolerance x (DCA cut) are not tried
+    void SetUsePairPreselection( Bool_t lOpt = kTRUE, Double_t lTolerance = 2.0, Int_t lNThreads = 0 ) {
+        fkUsePairPreselection = lOpt;
+        fPairPreselectionTolerance = lTolerance;
+        fPairPreselectionThreads = lNThreads;
+    }
     void SetUseMonteCarloAssociation( Bool_t lOpt = kTRUE) {
         fkMonteCarlo=lOpt;
     }
@@ -385,6 +393,10 @@ private:
     Long_t fMaxIterationsWhenMinimizing;
     Bool_t fkPreselectX;
     Bool_t fkSkipLargeXYDCA;
+    Bool_t fkUsePairPreselection; //geometrical pair pre-selection before propagation
+    Double_t fPairPreselectionTolerance; //in units of the DCA daughters cut
+    Int_t fPairPreselectionThreads; //threads for the candidate search (0, 1: sequential)
+    AliWeakDecayPairPreselector *fPairPreselector; //!
     
     //Master MC switch
     Bool_t fkMonteCarlo; //do MC association in vertexing
@@ -432,8 +444,9 @@ private:
     AliAnalysisTaskWeakDecayVertexer(const AliAnalysisTaskWeakDecayVertexer&);            // not implemented
     AliAnalysisTaskWeakDecayVertexer& operator=(const AliAnalysisTaskWeakDecayVertexer&); // not implemented
 
-    ClassDef(AliAnalysisTaskWeakDecayVertexer, 1);
+    ClassDef(AliAnalysisTaskWeakDecayVertexer, 2);
     //1: first implementation
+    //2: pair pre-selection
 };
 
 #endif
@@ -0,0 +1,289 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// Column-oriented copy of the selections of a set of AliCascadeResult
+// configurations, for the superlight output mode.
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#include "TList.h"
+#include "TH3F.h"
+#include "TMath.h"
+#include "AliCascadeResult.h"
+#include "AliCascadeCutMatrix.h"
+
+//________________________________________________________________
+AliCascadeCutMatrix::AliCascadeCutMatrix() :
+fConfigToSave(""),
+fNConfigs(0)
+{
+    for(Int_t i=0; i<4; i++) fLists[i] = 0x0;
+}
+//________________________________________________________________
+AliCascadeCutMatrix::~AliCascadeCutMatrix()
+{
+    //histograms are owned by the AliCascadeResult objects
+}
+//________________________________________________________________
+void AliCascadeCutMatrix::Compile( TList *lXiMinus, TList *lXiPlus, TList *lOmegaMinus, TList *lOmegaPlus,
+                                  const TString &lConfigToSave )
+{
+    TList *lLists[4] = {lXiMinus, lXiPlus, lOmegaMinus, lOmegaPlus};
+    Long_t lNConfigs = 0;
+    Bool_t lUpToDate = fConfigToSave.EqualTo( lConfigToSave );
+    for(Int_t il=0; il<4; il++){
+        if( lLists[il] ) lNConfigs += lLists[il]->GetEntries();
+        if( lLists[il] != fLists[il] ) lUpToDate = kFALSE;
+    }
+    if( lUpToDate && lNConfigs == fNConfigs ) return;
+
+    for(Int_t il=0; il<4; il++) fLists[il] = lLists[il];
+    fConfigToSave = lConfigToSave;
+    fNConfigs = lNConfigs;
+
+    fHisto.clear(); fHypo.clear(); fSaveToTree.clear(); fCharge.clear();
+    fMinEtaTracks.clear(); fMaxEtaTracks.clear(); fMinRapidity.clear(); fMaxRapidity.clear();
+    fDCANegToPV.clear(); fDCAPosToPV.clear(); fDCAV0Daughters.clear(); fV0CosPA.clear();
+    fV0Radius.clear(); fDCAV0ToPV.clear(); fV0Mass.clear(); fDCABachToPV.clear();
+    fDCACascDaughters.clear(); fCascCosPA.clear(); fCascRadius.clear(); fV0MassSigma.clear();
+    fProperLifetime.clear(); fLeastNumberOfClusters.clear(); fTPCdEdx.clear();
+    fUseTOFUnchecked.clear(); fIsOmega.clear(); fXiRejection.clear(); fDCABachToBaryon.clear();
+    fUseVarBBCosPA.clear(); fBBCosPA.clear(); fMinV0Lifetime.clear(); fMaxV0Lifetime.clear();
+    fUseITSRefitTracks.clear(); fMaxChi2PerCluster.clear(); fMinTrackLength.clear();
+    fUseParametricLength.clear(); fUse276TeVV0CosPA.clear(); fDCACascadeToPV.clear();
+    fAtLeastOneTOF.clear(); fUseITSRefitNegative.clear(); fUseITSRefitPositive.clear();
+    fUseITSRefitBachelor.clear(); fIsCowboy.clear(); fIsCascadeCowboy.clear();
+    fMinCrossedRowsOverLength.clear(); fLeastNumberOfCrossedRows.clear(); fITSorTOF.clear();
+    fVarConfigs.clear(); fVarUse.clear(); fVarPar.clear();
+
+    for(Int_t il=0; il<4; il++){
+        if( !lLists[il] ) continue;
+        for(Int_t icfg=0; icfg<lLists[il]->GetEntries(); icfg++){
+            AliCascadeResult *lCascadeResult = (AliCascadeResult*) lLists[il]->At(icfg);
+            const AliCascadeResult::EMassHypo lHypo = lCascadeResult->GetMassHypothesis();
+            const Bool_t lIsOmega = lHypo == AliCascadeResult::kOmegaMinus || lHypo == AliCascadeResult::kOmegaPlus;
+
+            Int_t lCharge = (lHypo == AliCascadeResult::kXiMinus || lHypo == AliCascadeResult::kOmegaMinus) ? -1 : +1;
+            if ( lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
+
+            UChar_t lVarUse =
+            (lCascadeResult->GetCutUseVarCascCosPA()  ? 1 : 0) |
+            (lCascadeResult->GetCutUseVarV0CosPA()    ? 2 : 0) |
+            (lCascadeResult->GetCutUseVarBBCosPA()    ? 4 : 0) |
+            (lCascadeResult->GetCutUseVarDCACascDau() ? 8 : 0);
+            if( lVarUse ){
+                fVarConfigs.push_back( fHisto.size() );
+                fVarUse.push_back( lVarUse );
+                //Parameters are used in single precision, as in the task
+                fVarPar.push_back( lCascadeResult->GetCutVarCascCosPAExp0Const() );
+                fVarPar.push_back( lCascadeResult->GetCutVarCascCosPAExp0Slope() );
+                fVarPar.push_back( lCascadeResult->GetCutVarCascCosPAExp1Const() );
+                fVarPar.push_back( lCascadeResult->GetCutVarCascCosPAExp1Slope() );
+                fVarPar.push_back( lCascadeResult->GetCutVarCascCosPAConst() );
+                fVarPar.push_back( lCascadeResult->GetCutVarV0CosPAExp0Const() );
+                fVarPar.push_back( lCascadeResult->GetCutVarV0CosPAExp0Slope() );
+                fVarPar.push_back( lCascadeResult->GetCutVarV0CosPAExp1Const() );
+                fVarPar.push_back( lCascadeResult->GetCutVarV0CosPAExp1Slope() );
+                fVarPar.push_back( lCascadeResult->GetCutVarV0CosPAConst() );
+                fVarPar.push_back( lCascadeResult->GetCutVarBBCosPAExp0Const() );
+                fVarPar.push_back( lCascadeResult->GetCutVarBBCosPAExp0Slope() );
+                fVarPar.push_back( lCascadeResult->GetCutVarBBCosPAExp1Const() );
+                fVarPar.push_back( lCascadeResult->GetCutVarBBCosPAExp1Slope() );
+                fVarPar.push_back( lCascadeResult->GetCutVarBBCosPAConst() );
+                fVarPar.push_back( lCascadeResult->GetCutVarDCACascDauExp0Const() );
+                fVarPar.push_back( lCascadeResult->GetCutVarDCACascDauExp0Slope() );
+                fVarPar.push_back( lCascadeResult->GetCutVarDCACascDauExp1Const() );
+                fVarPar.push_back( lCascadeResult->GetCutVarDCACascDauExp1Slope() );
+                fVarPar.push_back( lCascadeResult->GetCutVarDCACascDauConst() );
+            }
+
+            fHisto.push_back( lCascadeResult->GetHistogram() );
+            fHypo.push_back( lHypo );
+            fSaveToTree.push_back( lConfigToSave.EqualTo( lCascadeResult->GetName() ) );
+            fCharge.push_back( lCharge );
+            fMinEtaTracks.push_back( lCascadeResult->GetCutMinEtaTracks() );
+            fMaxEtaTracks.push_back( lCascadeResult->GetCutMaxEtaTracks() );
+            fMinRapidity.push_back( lCascadeResult->GetCutMinRapidity() );
+            fMaxRapidity.push_back( lCascadeResult->GetCutMaxRapidity() );
+            fDCANegToPV.push_back( lCascadeResult->GetCutDCANegToPV() );
+            fDCAPosToPV.push_back( lCascadeResult->GetCutDCAPosToPV() );
+            fDCAV0Daughters.push_back( lCascadeResult->GetCutDCAV0Daughters() );
+            fV0CosPA.push_back( lCascadeResult->GetCutV0CosPA() );
+            fV0Radius.push_back( lCascadeResult->GetCutV0Radius() );
+            fDCAV0ToPV.push_back( lCascadeResult->GetCutDCAV0ToPV() );
+            fV0Mass.push_back( lCascadeResult->GetCutV0Mass() );
+            fDCABachToPV.push_back( lCascadeResult->GetCutDCABachToPV() );
+            fDCACascDaughters.push_back( lCascadeResult->GetCutDCACascDaughters() );
+            fCascCosPA.push_back( lCascadeResult->GetCutCascCosPA() );
+            fCascRadius.push_back( lCascadeResult->GetCutCascRadius() );
+            fV0MassSigma.push_back( lCascadeResult->GetCutV0MassSigma() );
+            fProperLifetime.push_back( lCascadeResult->GetCutProperLifetime() );
+            fLeastNumberOfClusters.push_back( lCascadeResult->GetCutLeastNumberOfClusters() );
+            fTPCdEdx.push_back( lCascadeResult->GetCutTPCdEdx() );
+            fUseTOFUnchecked.push_back( lCascadeResult->GetCutUseTOFUnchecked() );
+            fIsOmega.push_back( lIsOmega );
+            fXiRejection.push_back( lCascadeResult->GetCutXiRejection() );
+            fDCABachToBaryon.push_back( lCascadeResult->GetCutDCABachToBaryon() );
+            fUseVarBBCosPA.push_back( lCascadeResult->GetCutUseVarBBCosPA() );
+            fBBCosPA.push_back( lCascadeResult->GetCutBachBaryonCosPA() );
+            fMinV0Lifetime.push_back( lCascadeResult->GetCutMinV0Lifetime() );
+            fMaxV0Lifetime.push_back( lCascadeResult->GetCutMaxV0Lifetime() );
+            fUseITSRefitTracks.push_back( lCascadeResult->GetCutUseITSRefitTracks() );
+            fMaxChi2PerCluster.push_back( lCascadeResult->GetCutMaxChi2PerCluster() );
+            fMinTrackLength.push_back( lCascadeResult->GetCutMinTrackLength() );
+            fUseParametricLength.push_back( lCascadeResult->GetCutUseParametricLength() );
+            fUse276TeVV0CosPA.push_back( lCascadeResult->GetCutUse276TeVV0CosPA() );
+            fDCACascadeToPV.push_back( lCascadeResult->GetCutDCACascadeToPV() );
+            fAtLeastOneTOF.push_back( lCascadeResult->GetCutAtLeastOneTOF() );
+            fUseITSRefitNegative.push_back( lCascadeResult->GetCutUseITSRefitNegative() );
+            fUseITSRefitPositive.push_back( lCascadeResult->GetCutUseITSRefitPositive() );
+            fUseITSRefitBachelor.push_back( lCascadeResult->GetCutUseITSRefitBachelor() );
+            fIsCowboy.push_back( lCascadeResult->GetCutIsCowboy() );
+            fIsCascadeCowboy.push_back( lCascadeResult->GetCutIsCascadeCowboy() );
+            fMinCrossedRowsOverLength.push_back( lCascadeResult->GetCutMinCrossedRowsOverLength() );
+            fLeastNumberOfCrossedRows.push_back( lCascadeResult->GetCutLeastNumberOfCrossedRows() );
+            fITSorTOF.push_back( lCascadeResult->GetCutITSorTOF() );
+        }
+    }
+    fPass.assign( fNConfigs, 0 );
+}
+//________________________________________________________________
+void AliCascadeCutMatrix::Select( const Candidate &lCand )
+{
+    //Candidate-only quantities
+    const Double_t lLengthPt     = TMath::Power(1/(lCand.fPt+1e-6),1.5);
+    const Double_t lLengthRadius = TMath::Max(lCand.fV0Radius-85., 0.);
+    const Double_t lXiRejection  = TMath::Abs( lCand.fMassAsXi - 1.32171 );
+    Double_t lV0MassDiff[4];
+    for(Int_t h=0; h<4; h++) lV0MassDiff[h] = TMath::Abs(lCand.fV0Mass[h]-1.116);
+    const Bool_t lAllITSRefit = lCand.fNegITSRefit && lCand.fPosITSRefit && lCand.fBachITSRefit;
+
+    const Long_t n = fNConfigs;
+    const UChar_t *lHypo = fHypo.data();
+    UChar_t *lPass = fPass.data();
+
+    //Sweep over all configurations: comparisons are combined with & so that
+    //the loop body has no branches. The variable CosPA and DCA cuts only
+    //ever tighten the fixed ones, which are checked here; the variable BB
+    //CosPA loosens it and is left entirely to the second step.
+    for(Long_t i=0; i<n; i++){
+        const Int_t h = lHypo[i];
+        const Double_t lLengthCut = fMinTrackLength[i];
+        const UChar_t lCowboy =
+        (fIsCowboy[i]==0) | ((fIsCowboy[i]==1) & lCand.fIsCowboy) | ((fIsCowboy[i]==-1) & !lCand.fIsCowboy);
+        const UChar_t lCascadeCowboy =
+        (fIsCascadeCowboy[i]==0) | ((fIsCascadeCowboy[i]==1) & lCand.fIsCascadeCowboy) | ((fIsCascadeCowboy[i]==-1) & !lCand.fIsCascadeCowboy);
+        lPass[i] =
+        lCand.fValid[h] &
+        //Check 1: Charge consistent with expectations
+        (lCand.fCharge == fCharge[i]) &
+        //Check 2: Basic Acceptance cuts
+        (fMinEtaTracks[i] < lCand.fPosEta) & (lCand.fPosEta < fMaxEtaTracks[i]) &
+        (fMinEtaTracks[i] < lCand.fNegEta) & (lCand.fNegEta < fMaxEtaTracks[i]) &
+        (fMinEtaTracks[i] < lCand.fBachEta) & (lCand.fBachEta < fMaxEtaTracks[i]) &
+        (lCand.fRap[h] > fMinRapidity[i]) & (lCand.fRap[h] < fMaxRapidity[i]) &
+        //Check 3: Topological Variables
+        (lCand.fDCANegToPV > fDCANegToPV[i]) & (lCand.fDCAPosToPV > fDCAPosToPV[i]) &
+        (lCand.fDCAV0Daughters < fDCAV0Daughters[i]) &
+        (lCand.fV0CosPA > fV0CosPA[i]) &
+        (lCand.fV0Radius > fV0Radius[i]) &
+        (lCand.fDCAV0ToPV > fDCAV0ToPV[i]) &
+        (lV0MassDiff[h] < fV0Mass[i]) &
+        (lCand.fDCABachToPV > fDCABachToPV[i]) &
+        (lCand.fDCACascDaughters < fDCACascDaughters[i]) &
+        (lCand.fCascCosPA > fCascCosPA[i]) &
+        (lCand.fCascRadius > fCascRadius[i]) &
+        ((fV0MassSigma[i] > 50) | (lCand.fV0MassNSigma[h] < fV0MassSigma[i])) &
+        (lCand.fProperLifetime[h] < fProperLifetime[i]) &
+        (lCand.fLeastNbrClusters > fLeastNumberOfClusters[i]) &
+        //Check 4: TPC dEdx selections
+        (TMath::Abs(lCand.fNegdEdx[h]) < fTPCdEdx[i]) &
+        (TMath::Abs(lCand.fPosdEdx[h]) < fTPCdEdx[i]) &
+        (TMath::Abs(lCand.fBachdEdx[h]) < fTPCdEdx[i]) &
+        //Check 4bis: TOF selections (experimental)
+        (!fUseTOFUnchecked[i] | lCand.fTOF[h]) &
+        //Check 5: Xi rejection for Omega analysis
+        (!fIsOmega[i] | (lXiRejection > fXiRejection[i])) &
+        //Check 6: Experimental DCA Bachelor to Baryon cut
+        (lCand.fDCABachToBaryon > fDCABachToBaryon[i]) &
+        //Check 7: Experimental Bach Baryon CosPA
+        (fUseVarBBCosPA[i] | (lCand.fWrongCosPA < fBBCosPA[i])) &
+        //Check 8: Min/Max V0 Lifetime cut
+        (lCand.fV0Lifetime > fMinV0Lifetime[i]) &
+        ((lCand.fV0Lifetime < fMaxV0Lifetime[i]) | (fMaxV0Lifetime[i] > 1e+3)) &
+        //Check 9: kITSrefit track selection if requested
+        (lAllITSRefit | !fUseITSRefitTracks[i]) &
+        //Check 10: Max Chi2/Clusters if not absurd
+        ((fMaxChi2PerCluster[i] > 1e+3) | (lCand.fMaxChi2PerCluster < fMaxChi2PerCluster[i])) &
+        //Check 11: Min Track Length if positive, [min - (1/pt)^1.5] if parametric requested
+        ((lLengthCut < 0) |
+         ((lCand.fMinTrackLength > lLengthCut) & !fUseParametricLength[i]) |
+         ((lCand.fMinTrackLength > lLengthCut - lLengthPt - lLengthRadius) & fUseParametricLength[i])) &
+        //Check 12: Check if special V0 CosPA cut used
+        (!fUse276TeVV0CosPA[i] | lCand.f276TeVV0CosPA) &
+        //Check 13: 3D Cascade DCA to PV
+        ((fDCACascadeToPV[i] > 999) | (lCand.fDCACascadeToPV < fDCACascadeToPV[i])) &
+        //Check 14: has at least one track with some TOF info
+        (!fAtLeastOneTOF[i] | lCand.fAtLeastOneTOF) &
+        //Check 15: check each prong for ITS refit
+        (!fUseITSRefitNegative[i] | lCand.fNegITSRefit) &
+        (!fUseITSRefitPositive[i] | lCand.fPosITSRefit) &
+        (!fUseITSRefitBachelor[i] | lCand.fBachITSRefit) &
+        //Check 16, 17: cowboy/sailor for V0 and cascade
+        lCowboy & lCascadeCowboy &
+        //Check 18, 19: modern track quality selections
+        ((fMinCrossedRowsOverLength[i] < 0) | (lCand.fLeastNcrOverLength > fMinCrossedRowsOverLength[i])) &
+        ((fLeastNumberOfCrossedRows[i] < 0) | (lCand.fLeastNbrCrossedRows > fLeastNumberOfCrossedRows[i])) &
+        //Check 20: ITS or TOF required
+        (!fITSorTOF[i] | lCand.fITSorTOF);
+    }
+
+    //Variable cuts, only for configurations still alive
+    for(size_t iv=0; iv<fVarConfigs.size(); iv++){
+        const Long_t i = fVarConfigs[iv];
+        if( !lPass[i] ) continue;
+        const UChar_t lUse = fVarUse[iv];
+        const Float_t *lPar = &fVarPar[20*iv];
+        Bool_t lPassVar = kTRUE;
+        if( lUse & 1 ){
+            Float_t lVarCascCosPA = TMath::Cos(
+                                               lPar[0]*TMath::Exp(lPar[1]*lCand.fPt) +
+                                               lPar[2]*TMath::Exp(lPar[3]*lCand.fPt) +
+                                               lPar[4]);
+            lPassVar = lPassVar && lCand.fCascCosPA > lVarCascCosPA;
+        }
+        if( lUse & 2 ){
+            Float_t lVarV0CosPA = TMath::Cos(
+                                             lPar[5]*TMath::Exp(lPar[6]*lCand.fPt) +
+                                             lPar[7]*TMath::Exp(lPar[8]*lCand.fPt) +
+                                             lPar[9]);
+            lPassVar = lPassVar && lCand.fV0CosPA > lVarV0CosPA;
+        }
+        if( lUse & 4 ){
+            //Only use if looser than the non-variable cut (WARNING: BEWARE INVERSE LOGIC)
+            Float_t lBBCosPACut = fBBCosPA[i];
+            Float_t lVarBBCosPA = TMath::Cos(
+                                             lPar[10]*TMath::Exp(lPar[11]*lCand.fPt) +
+                                             lPar[12]*TMath::Exp(lPar[13]*lCand.fPt) +
+                                             lPar[14]);
+            if( lVarBBCosPA > lBBCosPACut ) lBBCosPACut = lVarBBCosPA;
+            lPassVar = lPassVar && lCand.fWrongCosPA < lBBCosPACut;
+        }
+        if( lUse & 8 ){
+            Float_t lVarDCACascDau = lPar[15]*TMath::Exp(lPar[16]*lCand.fPt) +
+            lPar[17]*TMath::Exp(lPar[18]*lCand.fPt) +
+            lPar[19];
+            lPassVar = lPassVar && lCand.fDCACascDaughters < lVarDCACascDau;
+        }
+        lPass[i] = lPassVar;
+    }
+}
+//________________________________________________________________
+Int_t AliCascadeCutMatrix::Fill( const Candidate &lCand, Float_t lCentrality )
+{
+    Select( lCand );
+    Int_t lNSaved = 0;
+    for(Long_t i=0; i<fNConfigs; i++){
+        if( !fPass[i] ) continue;
+        lNSaved += fSaveToTree[i];
+        fHisto[i] -> Fill ( lCentrality, lCand.fPt, lCand.fMass[fHypo[i]] );
+    }
+    return lNSaved;
+}
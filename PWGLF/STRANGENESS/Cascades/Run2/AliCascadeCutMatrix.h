@@ -0,0 +1,151 @@
+#ifndef AliCascadeCutMatrix_H
+#define AliCascadeCutMatrix_H
+#include <vector>
+#include <Rtypes.h>
+#include <TString.h>
+
+class TList;
+class TH3F;
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// Column-oriented copy of the selections of a set of AliCascadeResult
+// configurations, for the superlight output mode. Same scheme as
+// AliV0CutMatrix: one branch-free sweep over the fixed cuts, then the
+// variable (pT-dependent) cuts for the configurations that use them.
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+class AliCascadeCutMatrix {
+
+public:
+    //Candidate variables, filled by the task once per cascade
+    //Arrays are indexed by AliCascadeResult::EMassHypo
+    struct Candidate {
+        Int_t    fCharge;
+        Float_t  fPt;
+        Float_t  fPosEta;
+        Float_t  fNegEta;
+        Float_t  fBachEta;
+        Float_t  fDCANegToPV;
+        Float_t  fDCAPosToPV;
+        Float_t  fDCAV0Daughters;
+        Float_t  fV0CosPA;
+        Float_t  fV0Radius;
+        Float_t  fDCAV0ToPV;
+        Float_t  fDCABachToPV;
+        Float_t  fDCACascDaughters;
+        Float_t  fCascCosPA;
+        Float_t  fCascRadius;
+        Int_t    fLeastNbrClusters;
+        Float_t  fMassAsXi;
+        Float_t  fDCABachToBaryon;
+        Float_t  fWrongCosPA;
+        Float_t  fV0Lifetime;
+        Float_t  fMaxChi2PerCluster;
+        Float_t  fMinTrackLength;
+        Double_t fDCACascadeToPV;    //3D
+        Float_t  fLeastNcrOverLength;
+        Int_t    fLeastNbrCrossedRows;
+        Bool_t   fNegITSRefit;
+        Bool_t   fPosITSRefit;
+        Bool_t   fBachITSRefit;
+        Bool_t   f276TeVV0CosPA;     //passes the 2.76 TeV-like V0 CosPA selection
+        Bool_t   fAtLeastOneTOF;     //at least one prong with a TOF signal
+        Bool_t   fIsCowboy;
+        Bool_t   fIsCascadeCowboy;
+        Bool_t   fITSorTOF;
+
+        Bool_t   fValid[4];          //hypothesis not rejected by competing checks
+        Float_t  fMass[4];
+        Float_t  fRap[4];
+        Float_t  fV0Mass[4];
+        Float_t  fV0MassNSigma[4];   //|V0Mass-expected|/sigma of the parametric V0 mass
+        Float_t  fProperLifetime[4]; //DistOverTotMom*PDGMass
+        Float_t  fNegdEdx[4];
+        Float_t  fPosdEdx[4];
+        Float_t  fBachdEdx[4];
+        Bool_t   fTOF[4];            //passes the unchecked TOF selection
+    };
+
+    AliCascadeCutMatrix();
+    ~AliCascadeCutMatrix();
+
+    //Compile the configurations in the lists (no-op if already up to date)
+    //lConfigToSave: name of the configuration whose candidates go to the tree
+    void Compile( TList *lXiMinus, TList *lXiPlus, TList *lOmegaMinus, TList *lOmegaPlus,
+                 const TString &lConfigToSave );
+
+    //Evaluate all configurations for this candidate and fill the passing ones;
+    //returns the number of passing configurations named lConfigToSave
+    Int_t Fill( const Candidate &lCand, Float_t lCentrality );
+
+    Long_t GetNConfigurations() const { return fNConfigs; }
+    Bool_t GetPassed( Long_t lcfg ) const { return fPass[lcfg]; }
+
+private:
+    AliCascadeCutMatrix(const AliCascadeCutMatrix&);            // not implemented
+    AliCascadeCutMatrix& operator=(const AliCascadeCutMatrix&); // not implemented
+
+    void Select( const Candidate &lCand );
+
+    TList  *fLists[4];
+    TString fConfigToSave;
+    Long_t  fNConfigs;
+
+    //One entry per configuration
+    std::vector<TH3F*>    fHisto;
+    std::vector<UChar_t>  fHypo;
+    std::vector<UChar_t>  fSaveToTree;
+    std::vector<Int_t>    fCharge;
+    std::vector<Double_t> fMinEtaTracks;
+    std::vector<Double_t> fMaxEtaTracks;
+    std::vector<Double_t> fMinRapidity;
+    std::vector<Double_t> fMaxRapidity;
+    std::vector<Double_t> fDCANegToPV;
+    std::vector<Double_t> fDCAPosToPV;
+    std::vector<Double_t> fDCAV0Daughters;
+    std::vector<Float_t>  fV0CosPA;
+    std::vector<Double_t> fV0Radius;
+    std::vector<Double_t> fDCAV0ToPV;
+    std::vector<Double_t> fV0Mass;
+    std::vector<Double_t> fDCABachToPV;
+    std::vector<Float_t>  fDCACascDaughters;
+    std::vector<Float_t>  fCascCosPA;
+    std::vector<Double_t> fCascRadius;
+    std::vector<Double_t> fV0MassSigma;
+    std::vector<Double_t> fProperLifetime;
+    std::vector<Double_t> fLeastNumberOfClusters;
+    std::vector<Double_t> fTPCdEdx;
+    std::vector<UChar_t>  fUseTOFUnchecked;
+    std::vector<UChar_t>  fIsOmega;
+    std::vector<Double_t> fXiRejection;
+    std::vector<Double_t> fDCABachToBaryon;
+    std::vector<UChar_t>  fUseVarBBCosPA;
+    std::vector<Float_t>  fBBCosPA;
+    std::vector<Double_t> fMinV0Lifetime;
+    std::vector<Double_t> fMaxV0Lifetime;
+    std::vector<UChar_t>  fUseITSRefitTracks;
+    std::vector<Double_t> fMaxChi2PerCluster;
+    std::vector<Double_t> fMinTrackLength;
+    std::vector<UChar_t>  fUseParametricLength;
+    std::vector<UChar_t>  fUse276TeVV0CosPA;
+    std::vector<Double_t> fDCACascadeToPV;
+    std::vector<UChar_t>  fAtLeastOneTOF;
+    std::vector<UChar_t>  fUseITSRefitNegative;
+    std::vector<UChar_t>  fUseITSRefitPositive;
+    std::vector<UChar_t>  fUseITSRefitBachelor;
+    std::vector<Int_t>    fIsCowboy;
+    std::vector<Int_t>    fIsCascadeCowboy;
+    std::vector<Double_t> fMinCrossedRowsOverLength;
+    std::vector<Double_t> fLeastNumberOfCrossedRows;
+    std::vector<UChar_t>  fITSorTOF;
+
+    //Variable cuts: only configurations that use at least one of them,
+    //checked after the sweep
+    std::vector<Long_t>   fVarConfigs;
+    std::vector<UChar_t>  fVarUse;  //bits: 0 casc CosPA, 1 V0 CosPA, 2 BB CosPA, 3 DCA casc dau
+    std::vector<Float_t>  fVarPar;  //4x5 parameters per entry of fVarConfigs
+
+    std::vector<UChar_t>  fPass;
+};
+
+#endif
@@ -0,0 +1,180 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// Column-oriented copy of the selections of a set of AliV0Result
+// configurations, for the superlight output mode.
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#include "TList.h"
+#include "TH3F.h"
+#include "TMath.h"
+#include "AliV0Result.h"
+#include "AliV0CutMatrix.h"
+
+//________________________________________________________________
+AliV0CutMatrix::AliV0CutMatrix() :
+fNConfigs(0)
+{
+    for(Int_t i=0; i<3; i++) fLists[i] = 0x0;
+}
+//________________________________________________________________
+AliV0CutMatrix::~AliV0CutMatrix()
+{
+    //histograms are owned by the AliV0Result objects
+}
+//________________________________________________________________
+void AliV0CutMatrix::Compile( TList *lK0Short, TList *lLambda, TList *lAntiLambda )
+{
+    TList *lLists[3] = {lK0Short, lLambda, lAntiLambda};
+    Long_t lNConfigs = 0;
+    Bool_t lUpToDate = kTRUE;
+    for(Int_t il=0; il<3; il++){
+        if( lLists[il] ) lNConfigs += lLists[il]->GetEntries();
+        if( lLists[il] != fLists[il] ) lUpToDate = kFALSE;
+    }
+    if( lUpToDate && lNConfigs == fNConfigs ) return;
+
+    for(Int_t il=0; il<3; il++) fLists[il] = lLists[il];
+    fNConfigs = lNConfigs;
+
+    fHisto.clear(); fHypo.clear(); fUseOnTheFly.clear();
+    fMinEtaTracks.clear(); fMaxEtaTracks.clear(); fMinRapidity.clear(); fMaxRapidity.clear();
+    fV0Radius.clear(); fMaxV0Radius.clear(); fDCANegToPV.clear(); fDCAPosToPV.clear();
+    fDCAV0Daughters.clear(); fV0CosPA.clear(); fProperLifetime.clear();
+    fLeastNumberOfCrossedRows.clear(); fLeastNumberOfCrossedRowsOverFindable.clear();
+    fIsK0Short.clear(); fMinBaryonMomentum.clear(); fTPCdEdx.clear();
+    fCheckArmenteros.clear(); fArmenterosParameter.clear(); fUseITSRefitTracks.clear();
+    fMaxChi2PerCluster.clear(); fMinTrackLength.clear(); fUseParametricLength.clear();
+    fUse276TeVLikedEdx.clear(); fAtLeastOneTOF.clear(); fIsCowboy.clear();
+    fMinCrossedRowsOverLength.clear(); fITSorTOF.clear();
+    fVarCosPAConfigs.clear(); fVarCosPAPar.clear();
+
+    for(Int_t il=0; il<3; il++){
+        if( !lLists[il] ) continue;
+        for(Int_t icfg=0; icfg<lLists[il]->GetEntries(); icfg++){
+            AliV0Result *lV0Result = (AliV0Result*) lLists[il]->At(icfg);
+            const Bool_t lIsK0Short = lV0Result->GetMassHypothesis() == AliV0Result::kK0Short;
+
+            if( lV0Result->GetCutUseVarV0CosPA() ){
+                fVarCosPAConfigs.push_back( fHisto.size() );
+                //Parameters are used in single precision, as in the task
+                fVarCosPAPar.push_back( lV0Result->GetCutVarV0CosPAExp0Const() );
+                fVarCosPAPar.push_back( lV0Result->GetCutVarV0CosPAExp0Slope() );
+                fVarCosPAPar.push_back( lV0Result->GetCutVarV0CosPAExp1Const() );
+                fVarCosPAPar.push_back( lV0Result->GetCutVarV0CosPAExp1Slope() );
+                fVarCosPAPar.push_back( lV0Result->GetCutVarV0CosPAConst() );
+            }
+
+            fHisto.push_back( lV0Result->GetHistogram() );
+            fHypo.push_back( lV0Result->GetMassHypothesis() );
+            fUseOnTheFly.push_back( lV0Result->GetUseOnTheFly() );
+            fMinEtaTracks.push_back( lV0Result->GetCutMinEtaTracks() );
+            fMaxEtaTracks.push_back( lV0Result->GetCutMaxEtaTracks() );
+            fMinRapidity.push_back( lV0Result->GetCutMinRapidity() );
+            fMaxRapidity.push_back( lV0Result->GetCutMaxRapidity() );
+            fV0Radius.push_back( lV0Result->GetCutV0Radius() );
+            fMaxV0Radius.push_back( lV0Result->GetCutMaxV0Radius() );
+            fDCANegToPV.push_back( lV0Result->GetCutDCANegToPV() );
+            fDCAPosToPV.push_back( lV0Result->GetCutDCAPosToPV() );
+            fDCAV0Daughters.push_back( lV0Result->GetCutDCAV0Daughters() );
+            fV0CosPA.push_back( lV0Result->GetCutV0CosPA() );
+            fProperLifetime.push_back( lV0Result->GetCutProperLifetime() );
+            fLeastNumberOfCrossedRows.push_back( lV0Result->GetCutLeastNumberOfCrossedRows() );
+            fLeastNumberOfCrossedRowsOverFindable.push_back( lV0Result->GetCutLeastNumberOfCrossedRowsOverFindable() );
+            fIsK0Short.push_back( lIsK0Short );
+            fMinBaryonMomentum.push_back( lV0Result->GetCutMinBaryonMomentum() );
+            fTPCdEdx.push_back( lV0Result->GetCutTPCdEdx() );
+            fCheckArmenteros.push_back( lV0Result->GetCutArmenteros() && lIsK0Short );
+            fArmenterosParameter.push_back( lV0Result->GetCutArmenterosParameter() );
+            fUseITSRefitTracks.push_back( lV0Result->GetCutUseITSRefitTracks() );
+            fMaxChi2PerCluster.push_back( lV0Result->GetCutMaxChi2PerCluster() );
+            fMinTrackLength.push_back( lV0Result->GetCutMinTrackLength() );
+            fUseParametricLength.push_back( lV0Result->GetCutUseParametricLength() );
+            fUse276TeVLikedEdx.push_back( lV0Result->GetCut276TeVLikedEdx() );
+            fAtLeastOneTOF.push_back( lV0Result->GetCutAtLeastOneTOF() );
+            fIsCowboy.push_back( lV0Result->GetCutIsCowboy() );
+            fMinCrossedRowsOverLength.push_back( lV0Result->GetCutMinCrossedRowsOverLength() );
+            fITSorTOF.push_back( lV0Result->GetCutITSorTOF() );
+        }
+    }
+    fPass.assign( fNConfigs, 0 );
+}
+//________________________________________________________________
+void AliV0CutMatrix::Select( const Candidate &lCand )
+{
+    //Candidate-only quantities of the parametric track length selection
+    const Double_t lLengthPt     = TMath::Power(1/(lCand.fPt+1e-6),1.5);
+    const Double_t lLengthRadius = TMath::Max(lCand.fV0Radius-85., 0.);
+    const Float_t  lAbsAlpha     = TMath::Abs(lCand.fAlpha);
+
+    const Long_t n = fNConfigs;
+    const UChar_t *lHypo = fHypo.data();
+    UChar_t *lPass = fPass.data();
+
+    //Sweep over all configurations: comparisons are combined with & so that
+    //the loop body has no branches. The variable V0 CosPA is only ever
+    //tighter than the fixed one, which is checked here.
+    for(Long_t i=0; i<n; i++){
+        const Int_t h = lHypo[i];
+        const Double_t lLengthCut = fMinTrackLength[i];
+        const UChar_t lCowboy =
+        (fIsCowboy[i]==0) | ((fIsCowboy[i]==1) & lCand.fIsCowboy) | ((fIsCowboy[i]==-1) & !lCand.fIsCowboy);
+        lPass[i] =
+        //Check 1: Offline Vertexer
+        (lCand.fOnFlyStatus == fUseOnTheFly[i]) &
+        //Check 2: Basic Acceptance cuts
+        (fMinEtaTracks[i] < lCand.fNegEta) & (lCand.fNegEta < fMaxEtaTracks[i]) &
+        (fMinEtaTracks[i] < lCand.fPosEta) & (lCand.fPosEta < fMaxEtaTracks[i]) &
+        (lCand.fRap[h] > fMinRapidity[i]) & (lCand.fRap[h] < fMaxRapidity[i]) &
+        //Check 3: Topological Variables
+        (lCand.fV0Radius > fV0Radius[i]) & (lCand.fV0Radius < fMaxV0Radius[i]) &
+        (lCand.fDcaNegToPV > fDCANegToPV[i]) & (lCand.fDcaPosToPV > fDCAPosToPV[i]) &
+        (lCand.fDcaV0Daughters < fDCAV0Daughters[i]) &
+        (lCand.fV0CosPA > fV0CosPA[i]) &
+        (lCand.fProperLifetime[h] < fProperLifetime[i]) &
+        (lCand.fLeastNbrCrossedRows > fLeastNumberOfCrossedRows[i]) &
+        (lCand.fLeastRatioCrossedRowsOverFindable > fLeastNumberOfCrossedRowsOverFindable[i]) &
+        //Check 4: Minimum momentum of baryon daughter
+        (fIsK0Short[i] | (lCand.fBaryonMomentum[h] > fMinBaryonMomentum[i])) &
+        //Check 5: TPC dEdx selections
+        (TMath::Abs(lCand.fNegdEdx[h]) < fTPCdEdx[i]) & (TMath::Abs(lCand.fPosdEdx[h]) < fTPCdEdx[i]) &
+        //Check 6: Armenteros-Podolanski space cut (for K0Short analysis)
+        (!fCheckArmenteros[i] | (lCand.fPtArm > fArmenterosParameter[i]*lAbsAlpha)) &
+        //Check 7: kITSrefit track selection if requested
+        (lCand.fITSRefit | !fUseITSRefitTracks[i]) &
+        //Check 8: Max Chi2/Clusters if not absurd
+        ((fMaxChi2PerCluster[i] > 1e+3) | (lCand.fMaxChi2PerCluster < fMaxChi2PerCluster[i])) &
+        //Check 9: Min Track Length if positive
+        ((lLengthCut < 0) |
+         ((lCand.fMinTrackLength > lLengthCut) & !fUseParametricLength[i]) |
+         ((lCand.fMinTrackLength > lLengthCut - lLengthPt - lLengthRadius) & fUseParametricLength[i])) &
+        //Check 10: Special 2.76TeV-like dedx
+        (!fUse276TeVLikedEdx[i] | lCand.f276TeVLikedEdx[h]) &
+        //Check 14: has at least one track with some TOF info
+        (!fAtLeastOneTOF[i] | lCand.fAtLeastOneTOF) &
+        //Check 15: cowboy/sailor for V0
+        lCowboy &
+        //Check 16: modern track quality selections
+        ((fMinCrossedRowsOverLength[i] < 0) | (lCand.fLeastNcrOverLength > fMinCrossedRowsOverLength[i])) &
+        //Check 17: ITS or TOF required
+        (!fITSorTOF[i] | lCand.fITSorTOF);
+    }
+
+    //Variable V0 CosPA, only for configurations still alive
+    for(size_t iv=0; iv<fVarCosPAConfigs.size(); iv++){
+        const Long_t i = fVarCosPAConfigs[iv];
+        if( !lPass[i] ) continue;
+        const Float_t *lPar = &fVarCosPAPar[5*iv];
+        Float_t lVarV0CosPA = TMath::Cos(
+                                         lPar[0]*TMath::Exp(lPar[1]*lCand.fPt) +
+                                         lPar[2]*TMath::Exp(lPar[3]*lCand.fPt) +
+                                         lPar[4]);
+        lPass[i] = lCand.fV0CosPA > lVarV0CosPA;
+    }
+}
+//________________________________________________________________
+void AliV0CutMatrix::Fill( const Candidate &lCand, Float_t lCentrality )
+{
+    Select( lCand );
+    for(Long_t i=0; i<fNConfigs; i++){
+        if( fPass[i] ) fHisto[i] -> Fill ( lCentrality, lCand.fPt, lCand.fMass[fHypo[i]] );
+    }
+}
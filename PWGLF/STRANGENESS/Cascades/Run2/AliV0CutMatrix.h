@@ -0,0 +1,115 @@
+#ifndef AliV0CutMatrix_H
+#define AliV0CutMatrix_H
+#include <vector>
+#include <Rtypes.h>
+
+class TList;
+class TH3F;
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// Column-oriented copy of the selections of a set of AliV0Result
+// configurations, for the superlight output mode.
+//
+// The configurations are compiled once from the output TLists. Each
+// candidate is then checked against all configurations in a single
+// branch-free loop over the cut columns, which writes one pass flag per
+// configuration; only the passing configurations are filled.
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+class AliV0CutMatrix {
+
+public:
+    //Candidate variables, filled by the task once per V0
+    //Arrays are indexed by AliV0Result::EMassHypo
+    struct Candidate {
+        Int_t    fOnFlyStatus;
+        Float_t  fPt;
+        Float_t  fNegEta;
+        Float_t  fPosEta;
+        Float_t  fV0Radius;
+        Float_t  fDcaNegToPV;
+        Float_t  fDcaPosToPV;
+        Float_t  fDcaV0Daughters;
+        Float_t  fV0CosPA;
+        Int_t    fLeastNbrCrossedRows;
+        Float_t  fLeastRatioCrossedRowsOverFindable;
+        Float_t  fPtArm;
+        Float_t  fAlpha;
+        Float_t  fMaxChi2PerCluster;
+        Float_t  fMinTrackLength;
+        Float_t  fLeastNcrOverLength;
+        Bool_t   fITSRefit;      //both daughters have kITSrefit
+        Bool_t   fAtLeastOneTOF; //at least one daughter with a TOF signal
+        Bool_t   fIsCowboy;
+        Bool_t   fITSorTOF;
+
+        Float_t  fMass[3];
+        Float_t  fRap[3];
+        Float_t  fProperLifetime[3]; //DistOverTotMom*PDGMass
+        Float_t  fNegdEdx[3];
+        Float_t  fPosdEdx[3];
+        Float_t  fBaryonMomentum[3];
+        Bool_t   f276TeVLikedEdx[3]; //passes the 2.76 TeV-like dE/dx selection
+    };
+
+    AliV0CutMatrix();
+    ~AliV0CutMatrix();
+
+    //Compile the configurations in the lists (no-op if already up to date)
+    void Compile( TList *lK0Short, TList *lLambda, TList *lAntiLambda );
+
+    //Evaluate all configurations for this candidate and fill the passing ones
+    void Fill( const Candidate &lCand, Float_t lCentrality );
+
+    Long_t GetNConfigurations() const { return fNConfigs; }
+    Bool_t GetPassed( Long_t lcfg ) const { return fPass[lcfg]; }
+
+private:
+    AliV0CutMatrix(const AliV0CutMatrix&);            // not implemented
+    AliV0CutMatrix& operator=(const AliV0CutMatrix&); // not implemented
+
+    void Select( const Candidate &lCand );
+
+    TList *fLists[3];
+    Long_t fNConfigs;
+
+    //One entry per configuration
+    std::vector<TH3F*>    fHisto;
+    std::vector<UChar_t>  fHypo;
+    std::vector<UChar_t>  fUseOnTheFly;
+    std::vector<Double_t> fMinEtaTracks;
+    std::vector<Double_t> fMaxEtaTracks;
+    std::vector<Double_t> fMinRapidity;
+    std::vector<Double_t> fMaxRapidity;
+    std::vector<Double_t> fV0Radius;
+    std::vector<Double_t> fMaxV0Radius;
+    std::vector<Double_t> fDCANegToPV;
+    std::vector<Double_t> fDCAPosToPV;
+    std::vector<Double_t> fDCAV0Daughters;
+    std::vector<Float_t>  fV0CosPA;
+    std::vector<Double_t> fProperLifetime;
+    std::vector<Double_t> fLeastNumberOfCrossedRows;
+    std::vector<Double_t> fLeastNumberOfCrossedRowsOverFindable;
+    std::vector<UChar_t>  fIsK0Short;
+    std::vector<Double_t> fMinBaryonMomentum;
+    std::vector<Double_t> fTPCdEdx;
+    std::vector<UChar_t>  fCheckArmenteros;
+    std::vector<Double_t> fArmenterosParameter;
+    std::vector<UChar_t>  fUseITSRefitTracks;
+    std::vector<Double_t> fMaxChi2PerCluster;
+    std::vector<Double_t> fMinTrackLength;
+    std::vector<UChar_t>  fUseParametricLength;
+    std::vector<UChar_t>  fUse276TeVLikedEdx;
+    std::vector<UChar_t>  fAtLeastOneTOF;
+    std::vector<Int_t>    fIsCowboy;
+    std::vector<Double_t> fMinCrossedRowsOverLength;
+    std::vector<UChar_t>  fITSorTOF;
+
+    //Variable V0 CosPA: only configurations that use it, checked after the sweep
+    std::vector<Long_t>   fVarCosPAConfigs;
+    std::vector<Float_t>  fVarCosPAPar; //5 parameters per entry of fVarCosPAConfigs
+
+    std::vector<UChar_t>  fPass;
+};
+
+#endif
@@ -0,0 +1,250 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// Geometrical pre-selection of the pairs tried by the weak decay
+// vertexers, see AliWeakDecayPairPreselector.h
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "TMath.h"
+#include "AliExternalTrackParam.h"
+#include "AliESDv0.h"
+#include "AliWeakDecayPairPreselector.h"
+
+//________________________________________________________________
+AliWeakDecayPairPreselector::AliWeakDecayPairPreselector() :
+fTolerance(3.0),
+fNThreads(0),
+fZLow(0),
+fBinWidth(1),
+fBins(),
+fWide(),
+fOffset(),
+fCandidates()
+{
+}
+//________________________________________________________________
+AliWeakDecayPairPreselector::~AliWeakDecayPairPreselector()
+{
+}
+//________________________________________________________________
+void AliWeakDecayPairPreselector::Clear()
+{
+    fSet[0].clear();
+    fSet[1].clear();
+    fOffset.clear();
+    fCandidates.clear();
+}
+//________________________________________________________________
+void AliWeakDecayPairPreselector::AddTrack( Int_t lSet, const AliExternalTrackParam *lTrack, Double_t b, Double_t lMaxRadius )
+{
+    //Helix parameters in the global frame: y, z, phi, tgl, curvature, x
+    Double_t hlx[6];
+    lTrack->GetHelixParameters(hlx,b);
+    const Double_t x0 = hlx[5], y0 = hlx[0], z0 = hlx[1];
+    const Double_t lCurv = hlx[4];
+
+    Geometry g;
+    g.fWide = kFALSE;
+    g.fUx = TMath::Cos(hlx[2]);
+    g.fUy = TMath::Sin(hlx[2]);
+
+    //Points of the trajectory inside the fiducial radius are at most this
+    //far (chord) from the reference point of the track
+    const Double_t lChord = lMaxRadius + fTolerance + TMath::Sqrt(x0*x0+y0*y0);
+    Double_t lMaxArc = lChord;
+    if( TMath::Abs(lCurv) < 1e-9 ){
+        //No field: straight line through the reference point
+        g.fX = x0;
+        g.fY = y0;
+        g.fR = -1;
+    }else{
+        //Circle centre on the inner side of the bend
+        g.fR = TMath::Abs(1./lCurv);
+        g.fX = x0 - g.fUy/lCurv;
+        g.fY = y0 + g.fUx/lCurv;
+        //The DCA minimisations stay within half a turn of the reference point
+        if( lChord >= 2*g.fR ) lMaxArc = TMath::Pi()*g.fR;
+        else lMaxArc = 2*g.fR*TMath::ASin(lChord/(2*g.fR));
+    }
+    const Double_t lMaxDeltaZ = TMath::Abs(hlx[3])*lMaxArc;
+    g.fZMin = z0 - lMaxDeltaZ;
+    g.fZMax = z0 + lMaxDeltaZ;
+    fSet[lSet].push_back(g);
+}
+//________________________________________________________________
+void AliWeakDecayPairPreselector::AddV0( Int_t lSet, AliESDv0 *lV0, Double_t lMaxRadius )
+{
+    Double_t x, y, z, px, py, pz;
+    lV0->GetXYZ(x,y,z);
+    lV0->GetPxPyPz(px,py,pz);
+    const Double_t lPt = TMath::Sqrt(px*px+py*py);
+
+    Geometry g;
+    g.fX = x;
+    g.fY = y;
+    g.fR = -1;
+    g.fWide = kFALSE;
+    if( lPt < 1e-9 ){
+        //Undefined direction: never reject
+        g.fUx = 0;
+        g.fUy = 0;
+        g.fZMin = z;
+        g.fZMax = z;
+        g.fWide = kTRUE;
+        fSet[lSet].push_back(g);
+        return;
+    }
+    g.fUx = px/lPt;
+    g.fUy = py/lPt;
+
+    //Section of the line inside the fiducial radius: s^2 + 2 s (P.u) + |P|^2 - R^2 < 0
+    const Double_t lRadius = lMaxRadius + fTolerance;
+    const Double_t lPu = x*g.fUx + y*g.fUy;
+    const Double_t lDisc = lPu*lPu - (x*x+y*y) + lRadius*lRadius;
+    if( lDisc < 0 ){
+        //The line does not cross the fiducial volume
+        g.fZMin = +1;
+        g.fZMax = -1;
+    }else{
+        const Double_t lTgl = pz/lPt;
+        const Double_t z1 = z + lTgl*(-lPu - TMath::Sqrt(lDisc));
+        const Double_t z2 = z + lTgl*(-lPu + TMath::Sqrt(lDisc));
+        g.fZMin = TMath::Min(z1,z2);
+        g.fZMax = TMath::Max(z1,z2);
+    }
+    fSet[lSet].push_back(g);
+}
+//________________________________________________________________
+Double_t AliWeakDecayPairPreselector::Gap( const Geometry &a, const Geometry &b ) const
+{
+    //Lower bound of the transverse distance between the two trajectories
+    if( a.fR > 0 && b.fR > 0 ){
+        const Double_t d = TMath::Sqrt( (a.fX-b.fX)*(a.fX-b.fX) + (a.fY-b.fY)*(a.fY-b.fY) );
+        return TMath::Max( 0., TMath::Max( d - a.fR - b.fR, TMath::Abs(a.fR - b.fR) - d ) );
+    }
+    if( a.fR > 0 || b.fR > 0 ){
+        const Geometry &c = a.fR > 0 ? a : b;
+        const Geometry &l = a.fR > 0 ? b : a;
+        const Double_t h = TMath::Abs( l.fUx*(c.fY-l.fY) - l.fUy*(c.fX-l.fX) );
+        return TMath::Max( 0., h - c.fR );
+    }
+    //Two lines: no constraint in the transverse plane
+    return 0;
+}
+//________________________________________________________________
+void AliWeakDecayPairPreselector::FindCandidates( Long_t lFirst, Long_t lLast, std::vector<Long_t> &lCandidates, std::vector<Long_t> &lCounts ) const
+{
+    const std::vector<Geometry> &lSet0 = fSet[0];
+    const std::vector<Geometry> &lSet1 = fSet[1];
+    const Long_t lNBins = fBins.size();
+
+    //Objects spanning several bins are only tested once per object of the first set
+    std::vector<Long_t> lLastTested( lSet1.size(), -1 );
+    std::vector<Long_t> lFound;
+
+    for(Long_t i=lFirst; i<lLast; i++){
+        const Geometry &g = lSet0[i];
+        lFound.clear();
+        if( g.fZMin <= g.fZMax ){
+            Long_t lBinMin = 0, lBinMax = lNBins-1;
+            if( !g.fWide ){
+                lBinMin = TMath::Max( 0L, (Long_t) TMath::Floor( (g.fZMin - fTolerance - fZLow)/fBinWidth ) );
+                lBinMax = TMath::Min( lNBins-1, (Long_t) TMath::Floor( (g.fZMax + fTolerance - fZLow)/fBinWidth ) );
+            }
+            for(Long_t ib=lBinMin; ib<=lBinMax; ib++){
+                const std::vector<Long_t> &lBin = fBins[ib];
+                for(size_t j=0; j<lBin.size(); j++){
+                    const Long_t k = lBin[j];
+                    if( lLastTested[k] == i ) continue;
+                    lLastTested[k] = i;
+                    const Geometry &h = lSet1[k];
+                    if( !g.fWide && ( h.fZMin > g.fZMax + fTolerance || g.fZMin > h.fZMax + fTolerance ) ) continue;
+                    if( Gap(g,h) > fTolerance ) continue;
+                    lFound.push_back(k);
+                }
+            }
+            for(size_t j=0; j<fWide.size(); j++){
+                const Long_t k = fWide[j];
+                const Geometry &h = lSet1[k];
+                if( !g.fWide && !h.fWide && ( h.fZMin > g.fZMax + fTolerance || g.fZMin > h.fZMax + fTolerance ) ) continue;
+                if( Gap(g,h) > fTolerance ) continue;
+                lFound.push_back(k);
+            }
+            //Same order as the full pair loop
+            std::sort( lFound.begin(), lFound.end() );
+        }
+        lCounts.push_back( lFound.size() );
+        lCandidates.insert( lCandidates.end(), lFound.begin(), lFound.end() );
+    }
+}
+//________________________________________________________________
+void AliWeakDecayPairPreselector::Process()
+{
+    const Long_t n0 = fSet[0].size();
+    const Long_t n1 = fSet[1].size();
+
+    //z binning of the second set
+    fBins.clear();
+    fWide.clear();
+    Double_t lZLow = 1e+30, lZHigh = -1e+30;
+    for(Long_t k=0; k<n1; k++){
+        const Geometry &h = fSet[1][k];
+        if( h.fWide || h.fZMin > h.fZMax ) continue;
+        lZLow  = TMath::Min( lZLow,  h.fZMin );
+        lZHigh = TMath::Max( lZHigh, h.fZMax );
+    }
+    if( lZLow <= lZHigh ){
+        const Long_t lNBins = TMath::Max( 1L, TMath::Min( 1000L, n1/4 ) );
+        fZLow = lZLow;
+        fBinWidth = (lZHigh - lZLow)/lNBins;
+        if( fBinWidth <= 0 ) fBinWidth = 1;
+        fBins.resize( lNBins );
+        for(Long_t k=0; k<n1; k++){
+            const Geometry &h = fSet[1][k];
+            if( h.fZMin > h.fZMax ) continue; //can never be paired
+            //very long objects (loopers, steep tracks) are tested against everything
+            if( h.fWide || ( lNBins > 4 && h.fZMax - h.fZMin > 0.25*(lZHigh - lZLow) ) ){
+                fWide.push_back(k);
+                continue;
+            }
+            const Long_t lBinMin = TMath::Min( lNBins-1, (Long_t) ( (h.fZMin - fZLow)/fBinWidth ) );
+            const Long_t lBinMax = TMath::Min( lNBins-1, (Long_t) ( (h.fZMax - fZLow)/fBinWidth ) );
+            for(Long_t ib=lBinMin; ib<=lBinMax; ib++) fBins[ib].push_back(k);
+        }
+    }else{
+        for(Long_t k=0; k<n1; k++) if( fSet[1][k].fWide ) fWide.push_back(k);
+    }
+
+    //Candidate search in chunks of the first set
+    const Int_t lNChunks = ( fNThreads > 1 && n0 > 1 ) ? (Int_t) TMath::Min( (Long_t) 4*fNThreads, n0 ) : 1;
+    const Long_t lChunkSize = (n0 + lNChunks - 1)/lNChunks;
+    std::vector< std::vector<Long_t> > lChunkCandidates( lNChunks );
+    std::vector< std::vector<Long_t> > lChunkCounts( lNChunks );
+    auto lSearchChunk = [&]( Int_t ic ){
+        const Long_t lFirst = ic*lChunkSize;
+        const Long_t lLast  = TMath::Min( n0, lFirst + lChunkSize );
+        FindCandidates( lFirst, lLast, lChunkCandidates[ic], lChunkCounts[ic] );
+    };
+    if( lNChunks > 1 ){
+        //Workers pick chunks until none is left
+        std::atomic<Int_t> lNextChunk(0);
+        auto lWorker = [&](){
+            for(Int_t ic = lNextChunk++; ic < lNChunks; ic = lNextChunk++) lSearchChunk(ic);
+        };
+        std::vector<std::thread> lThreads;
+        for(Int_t it=0; it<fNThreads; it++) lThreads.push_back( std::thread(lWorker) );
+        for(size_t it=0; it<lThreads.size(); it++) lThreads[it].join();
+    }else{
+        lSearchChunk(0);
+    }
+    
+    //Join in chunk order: independent of the scheduling
+    fOffset.assign( 1, 0 );
+    fOffset.reserve( n0+1 );
+    fCandidates.clear();
+    for(Int_t ic=0; ic<lNChunks; ic++){
+        for(size_t j=0; j<lChunkCounts[ic].size(); j++) fOffset.push_back( fOffset.back() + lChunkCounts[ic][j] );
+        fCandidates.insert( fCandidates.end(), lChunkCandidates[ic].begin(), lChunkCandidates[ic].end() );
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef AliWeakDecayPairPreselector_H
+#define AliWeakDecayPairPreselector_H
+#include <vector>
+#include <Rtypes.h>
+
+class AliExternalTrackParam;
+class AliESDv0;
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// Geometrical pre-selection of the pairs tried by the weak decay
+// vertexers (negative x positive tracks, V0s x bachelors).
+//
+// Every object is reduced to its trajectory in the transverse plane
+// (helix circle, or straight line for V0s) and to the z range it can
+// cover inside the fiducial radius. The second set of objects is binned
+// in z; for each object of the first set, only the objects in the
+// overlapping z bins whose transverse trajectories come closer than the
+// tolerance are kept as candidates. Candidates are returned in
+// increasing index order, such that the vertexers produce their output
+// in the same order as with the full pair loop.
+//
+// The candidate search may run in parallel chunks on a few threads: it
+// only reads the geometry computed beforehand, each chunk writes its own
+// list and the lists are joined in chunk order, so the result does not
+// depend on scheduling.
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+class AliWeakDecayPairPreselector {
+
+public:
+    AliWeakDecayPairPreselector();
+    ~AliWeakDecayPairPreselector();
+
+    void SetTolerance ( Double_t lTolerance ) { fTolerance = lTolerance; }
+    void SetNThreads  ( Int_t lNThreads )     { fNThreads  = lNThreads;  }
+
+    //Start a new set of pairs
+    void Clear();
+    //Add objects to the first (lSet=0) or second (lSet=1) set.
+    //lMaxRadius: fiducial radius within which the decay must take place
+    void AddTrack ( Int_t lSet, const AliExternalTrackParam *lTrack, Double_t b, Double_t lMaxRadius );
+    void AddV0    ( Int_t lSet, AliESDv0 *lV0, Double_t lMaxRadius );
+    //Find the candidate partners of every object of the first set
+    void Process();
+
+    Long_t GetNCandidates ( Long_t i ) const { return fOffset[i+1]-fOffset[i]; }
+    Long_t GetCandidate   ( Long_t i, Long_t ic ) const { return fCandidates[fOffset[i]+ic]; }
+    Long_t GetNPairsTotal () const { return fSet[0].size()*fSet[1].size(); }
+    Long_t GetNPairsKept  () const { return fCandidates.size(); }
+
+private:
+    AliWeakDecayPairPreselector(const AliWeakDecayPairPreselector&);            // not implemented
+    AliWeakDecayPairPreselector& operator=(const AliWeakDecayPairPreselector&); // not implemented
+
+    //Trajectory of one object. Helix: circle (fX, fY, fR); line: point
+    //(fX, fY) and unit direction (fUx, fUy), fR<0. fZMin>fZMax if the
+    //object cannot reach the fiducial volume; unbounded z range if fWide.
+    struct Geometry {
+        Double_t fX, fY, fR, fUx, fUy;
+        Double_t fZMin, fZMax;
+        Bool_t   fWide;
+    };
+
+    Double_t Gap( const Geometry &a, const Geometry &b ) const;
+    void FindCandidates( Long_t lFirst, Long_t lLast, std::vector<Long_t> &lCandidates, std::vector<Long_t> &lCounts ) const;
+
+    Double_t fTolerance; //distance below which pairs are kept (cm)
+    Int_t    fNThreads;  //number of chunks searched in parallel (0, 1: sequential)
+
+    std::vector<Geometry> fSet[2];
+
+    //z binning of the second set
+    Double_t fZLow;
+    Double_t fBinWidth;
+    std::vector< std::vector<Long_t> > fBins;
+    std::vector<Long_t> fWide; //second-set objects not binned in z
+
+    //Output: candidates of object i are fCandidates[fOffset[i]..fOffset[i+1])
+    std::vector<Long_t> fOffset;
+    std::vector<Long_t> fCandidates;
+};
+
+#endif
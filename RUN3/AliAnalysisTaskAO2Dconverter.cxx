@@ -23,6 +23,9 @@
 #include <TChain.h>
 #include <TTree.h>
 #include <TMath.h>
+#include <TROOT.h>
+#include <TH1D.h>
+#include <chrono>
 #include "AliAnalysisTask.h"
 #include "AliAnalysisManager.h"
 #include "AliESDEvent.h"
@@ -249,6 +252,25 @@ void AliAnalysisTaskAO2Dconverter::UserCreateOutputObjects()
   fOutputFile = TFile::Open("AO2D.root","RECREATE", "O2 AOD", fCompress); // File to store the trees of time frames
   fOutputFile->Print();
 
+  // Compression of the baskets in a pool of workers. The trees are flushed each time
+  // fWriterMaxMemory bytes are accumulated and the baskets of all branches are compressed in parallel.
+  // Only the output trees are switched to implicit MT, the pool itself is enabled by the user (process wide)
+  if (fWriterThreads > 0) {
+#ifdef R__USE_IMT
+    if (fWriterEnableIMT && !ROOT::IsImplicitMTEnabled()) {
+      ROOT::EnableImplicitMT(fWriterThreads);
+      fWriterOwnsIMT = kTRUE;
+    }
+    if (ROOT::IsImplicitMTEnabled())
+      AliInfo(Form("Compressing output trees with %u workers", ROOT::GetImplicitMTPoolSize()));
+    else
+      AliWarning("ROOT implicit multi-threading not enabled, compressing in the event loop");
+#else
+    AliWarning("ROOT built without implicit multi-threading, compressing in the event loop");
+    fWriterThreads = 0;
+#endif
+  }
+
   // create the list of output histograms
   fOutputList = new TList();
   fOutputList->SetOwner();
@@ -264,6 +286,19 @@ void AliAnalysisTaskAO2Dconverter::UserCreateOutputObjects()
   fOutputList->Add(fCentralityHist);
   fOutputList->Add(fCentralityINT7);
   fOutputList->Add(fHistPileupEvents);
+
+  // Writer counters per tree
+  fHistTreeBytes = new TH1D("writerBytes", "Uncompressed bytes per tree", kTrees, 0, kTrees);
+  fHistTreeZipBytes = new TH1D("writerZipBytes", "Compressed bytes per tree", kTrees, 0, kTrees);
+  fHistTreeTime = new TH1D("writerTime", "Time spent in Fill and Write per tree (s)", kTrees, 0, kTrees);
+  for (Int_t i = 0; i < kTrees; i++) {
+    fHistTreeBytes->GetXaxis()->SetBinLabel(i + 1, TreeName[i]);
+    fHistTreeZipBytes->GetXaxis()->SetBinLabel(i + 1, TreeName[i]);
+    fHistTreeTime->GetXaxis()->SetBinLabel(i + 1, TreeName[i]);
+  }
+  fOutputList->Add(fHistTreeBytes);
+  fOutputList->Add(fHistTreeZipBytes);
+  fOutputList->Add(fHistTreeTime);
   if (fSkipTPCPileup || fSkipPileup || fUseEventCuts) fEventCuts.AddQAplotsToList(fOutputList);
   if (fSkipTPCPileup) fEventCuts.SetRejectTPCPileupWithITSTPCnCluCorr(true);
 
@@ -358,6 +393,22 @@ void AliAnalysisTaskAO2Dconverter::FinishTaskOutput()
   FinishTF();
   fOutputFile->Write(); // Do not close the file since this is then re-opened and overwritten by the framework
   AliInfo(Form("Total size of output trees: %lu bytes\n", fBytes));
+#ifdef R__USE_IMT
+  if (fWriterOwnsIMT) {
+    ROOT::DisableImplicitMT();
+    fWriterOwnsIMT = kFALSE;
+  }
+#endif
+
+  // Summary of the writer counters
+  for (Int_t i = 0; i < kTrees; i++) {
+    if (!fTreeStatus[i] || !fTreeBytes[i]) continue;
+    AliInfo(Form("%-20s %12llu bytes, %12llu compressed bytes, %8.3f s", TreeName[i].Data(), fTreeBytes[i], fTreeZipBytes[i], fTreeTime[i]));
+    fHistTreeBytes->SetBinContent(i + 1, fTreeBytes[i]);
+    fHistTreeZipBytes->SetBinContent(i + 1, fTreeZipBytes[i]);
+    fHistTreeTime->SetBinContent(i + 1, fTreeTime[i]);
+  }
+  PostData(1, fOutputList);
 }
 
 void AliAnalysisTaskAO2Dconverter::Terminate(Option_t *)
@@ -409,6 +460,11 @@ TTree* AliAnalysisTaskAO2Dconverter::CreateTree(TreeIndex t)
   fOutputDir->cd();
   AliInfo(Form("Creating tree %s\n", TreeName[t].Data()));
   fTree[t] = new TTree(TreeName[t], TreeTitle[t]);
+  if (fWriterThreads > 0) {
+    // Bounded memory: flush (and compress in parallel) each time fWriterMaxMemory bytes are buffered
+    fTree[t]->SetAutoFlush(-fWriterMaxMemory);
+    fTree[t]->SetImplicitMT(true);
+  }
   return fTree[t];
 } // TTree* AliAnalysisTaskAO2Dconverter::CreateTree(TreeIndex t)
 
@@ -438,8 +494,13 @@ void AliAnalysisTaskAO2Dconverter::Prune()
 void AliAnalysisTaskAO2Dconverter::FillTree(TreeIndex t)
 {
   if (!fTreeStatus[t]) return;
+  auto start = std::chrono::steady_clock::now();
   Int_t nbytes = fTree[t]->Fill();
-  if (nbytes > 0) fBytes += nbytes;
+  fTreeTime[t] += std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+  if (nbytes > 0) {
+    fBytes += nbytes;
+    fTreeBytes[t] += nbytes;
+  }
 } // void AliAnalysisTaskAO2Dconverter::FillTree(TreeIndex t)
 
 void AliAnalysisTaskAO2Dconverter::WriteTree(TreeIndex t)
@@ -449,7 +510,10 @@ void AliAnalysisTaskAO2Dconverter::WriteTree(TreeIndex t)
   if (!fOutputDir) AliFatal("No Root subdir|");
   fOutputDir->cd();
   AliInfo(Form("Writing tree %s\n", TreeName[t].Data()));
+  auto start = std::chrono::steady_clock::now();
   fTree[t]->Write();
+  fTreeTime[t] += std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+  fTreeZipBytes[t] += fTree[t]->GetZipBytes();
 } // void AliAnalysisTaskAO2Dconverter::WriteTree(TreeIndex t)
 
 void AliAnalysisTaskAO2Dconverter::InitTF(Int_t tfId)
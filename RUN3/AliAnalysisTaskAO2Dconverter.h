@@ -18,6 +18,7 @@
 class AliESDEvent;
 class TFile;
 class TDirectory;
+class TH1D;
 
 class AliAnalysisTaskAO2Dconverter : public AliAnalysisTaskSE
 {
@@ -43,6 +44,12 @@ public:
   virtual void SetTruncation(Bool_t trunc=kTRUE) {fTruncate = trunc;}
   virtual void SetCompression(UInt_t compress=101) {fCompress = compress; }
   virtual void SetMaxBytes(ULong_t nbytes = 100000000) {fMaxBytes = nbytes;}
+  /// Compress the baskets of the output trees in a pool of nthreads workers (0: compress in the event loop).
+  /// maxmemory limits the memory kept in baskets of each tree before they are handed to the workers.
+  /// The output trees only use the ROOT implicit multi-threading pool if it is enabled, e.g. by the steering macro.
+  /// With enableIMT the task enables it itself with nthreads workers between UserCreateOutputObjects and
+  /// FinishTaskOutput: this is process wide, the other tasks of the train and the input trees use it as well.
+  void SetWriterThreads(Int_t nthreads, Long64_t maxmemory = 32000000, Bool_t enableIMT = kFALSE) { fWriterThreads = nthreads; fWriterMaxMemory = maxmemory; fWriterEnableIMT = enableIMT; }
 
   static AliAnalysisTaskAO2Dconverter* AddTask(TString suffix = "");
   enum TreeIndex { // Index of the output trees
@@ -490,16 +497,28 @@ private:
   TH1F *fCentralityHist = nullptr; ///! Centrality histogram
   TH1F *fCentralityINT7 = nullptr; ///! Centrality histogram for the INT7 triggers
   TH1I *fHistPileupEvents = nullptr; ///! Counter histogram for pileup events
+  TH1D *fHistTreeBytes = nullptr;    ///! Uncompressed bytes filled per tree
+  TH1D *fHistTreeZipBytes = nullptr; ///! Compressed bytes written per tree
+  TH1D *fHistTreeTime = nullptr;     ///! Time spent in filling and writing per tree
 
   /// Byte counter
   ULong_t fBytes = 0; ///! Number of bytes stored in all trees
   ULong_t fMaxBytes = 100000000; ///| Approximative size limit on the total TF output trees
 
+  /// Writer
+  Int_t fWriterThreads = 0;             /// Number of compression workers, 0 means compression in the event loop
+  Long64_t fWriterMaxMemory = 32000000; /// Memory in baskets per tree before they are flushed to the workers
+  Bool_t fWriterEnableIMT = kFALSE;     /// Enable the process wide ROOT implicit multi-threading for the writer (opt-in)
+  Bool_t fWriterOwnsIMT = kFALSE;       ///! Implicit multi-threading enabled by this task, disabled again in FinishTaskOutput
+  ULong64_t fTreeBytes[kTrees] = {0};   ///! Uncompressed bytes filled per tree
+  ULong64_t fTreeZipBytes[kTrees] = {0};///! Compressed bytes written per tree
+  Double_t fTreeTime[kTrees] = {0};     ///! Time (s) spent in filling and writing per tree
+
   /// Pointer to the output file
   TFile * fOutputFile = 0x0; ///! Pointer to the output file
   TDirectory * fOutputDir = 0x0; ///! Pointer to the output Root subdirectory
   
-  ClassDef(AliAnalysisTaskAO2Dconverter, 11);
+  ClassDef(AliAnalysisTaskAO2Dconverter, 13);
 };
 
 #endif